@@ -0,0 +1,56 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+using namespace vectoria;
+
+// Small graphs are dominated by per-node dispatch cost, not by kernel time.
+void bench_mha_dispatch(int64_t T, int64_t d_model, int heads, KernelPolicy policy, trace::TraceLevel level) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{T, d_model}}, ir::DataType::Float32} });
+    for (size_t i = 1; i <= 4; ++i) {
+        g.nodes.push_back({ {i}, ir::ParameterNode{"W" + std::to_string(i), {{d_model, d_model}}, ir::DataType::Float32, 0} });
+    }
+    int out = graph::add_multi_head_attention_composed(g, 0, 1, 2, 3, 4, heads);
+    g.outputs.push_back({static_cast<size_t>(out)});
+
+    EngineConfig cfg;
+    cfg.policy = policy;
+    cfg.trace_level = level;
+    Engine e(g, cfg);
+    e.compile();
+    for (size_t i = 0; i <= 4; ++i) {
+        float* buf = static_cast<float*>(e.get_buffer(i));
+        size_t count = (i == 0 ? T : d_model) * d_model;
+        for (size_t j = 0; j < count; ++j) buf[j] = 0.01f * static_cast<float>(j % 17);
+    }
+
+    const int iters = 1000;
+    e.execute(); // Warm-up
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iters; ++i) {
+        e.execute();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1000.0 / iters;
+
+    std::cout << "MHA DISPATCH [T=" << T << ", d=" << d_model << ", h=" << heads << ", nodes=" << g.nodes.size()
+              << (policy == KernelPolicy::SIMD ? ", SIMD" : ", Ref")
+              << ", trace=" << (level == trace::TraceLevel::Full ? "Full" : level == trace::TraceLevel::Counters ? "Counters" : "Off")
+              << "]: " << us << "us/execute | "
+              << (us * 1000.0 / g.nodes.size()) << "ns/node" << std::endl;
+}
+
+int main() {
+    for (auto level : {trace::TraceLevel::Full, trace::TraceLevel::Counters, trace::TraceLevel::Off}) {
+        bench_mha_dispatch(4, 16, 4, KernelPolicy::Reference, level);
+        bench_mha_dispatch(16, 64, 8, KernelPolicy::Reference, level);
+#ifdef VECTORIA_USE_ASM
+        bench_mha_dispatch(4, 16, 4, KernelPolicy::SIMD, level);
+        bench_mha_dispatch(16, 64, 8, KernelPolicy::SIMD, level);
+#endif
+    }
+    return 0;
+}
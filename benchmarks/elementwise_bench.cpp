@@ -8,6 +8,7 @@
 extern "C" {
     VectoriaStatus add_f32_neon(const float* a, const float* b, float* out, size_t count);
     VectoriaStatus add_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus exp_f32_avx2(const float* in, float* out, size_t count);
 }
 
 void bench_add(size_t count) {
@@ -42,8 +43,65 @@ void bench_add(size_t count) {
     std::cout << "ADD [N=" << count << "]: Ref=" << ref_time << "us | SIMD=" << simd_time << "us | Speedup=" << (ref_time/simd_time) << "x" << std::endl;
 }
 
+// Softmax-style inputs (x - max <= 0). No NEON Exp yet: x86_64 only.
+void bench_exp(size_t count) {
+    std::vector<float> in(count);
+    std::vector<float> out(count);
+    for (size_t i = 0; i < count; ++i) in[i] = -static_cast<float>(i % 3000) * 0.01f;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for(int i=0; i<100; ++i) {
+        vectoria::kernels::reference::exp_f32(in.data(), out.data(), count);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ref_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 100.0;
+
+#if defined(__x86_64__)
+    start = std::chrono::high_resolution_clock::now();
+    for(int i=0; i<100; ++i) {
+        exp_f32_avx2(in.data(), out.data(), count);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double simd_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 100.0;
+    std::cout << "EXP [N=" << count << "]: Ref=" << ref_time << "us | SIMD=" << simd_time << "us | Speedup=" << (ref_time/simd_time) << "x" << std::endl;
+#else
+    std::cout << "EXP [N=" << count << "]: Ref=" << ref_time << "us | SIMD=n/a" << std::endl;
+#endif
+}
+
+void bench_transpose(const std::vector<int64_t>& shape, const std::vector<int64_t>& perm, const char* name) {
+    size_t count = 1;
+    for (auto d : shape) count *= static_cast<size_t>(d);
+    std::vector<float> in(count, 1.0f);
+    std::vector<float> out(count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for(int i=0; i<100; ++i) {
+        vectoria::kernels::reference::transpose_f32(in.data(), out.data(), shape, perm);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ref_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 100.0;
+
+#if defined(__x86_64__)
+    start = std::chrono::high_resolution_clock::now();
+    for(int i=0; i<100; ++i) {
+        vectoria::kernels::reference::transpose_f32_tiled(in.data(), out.data(), shape, perm, transpose_2d_f32_avx2);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double simd_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 100.0;
+    std::cout << "TRANSPOSE " << name << ": Ref=" << ref_time << "us | SIMD=" << simd_time << "us | Speedup=" << (ref_time/simd_time) << "x" << std::endl;
+#else
+    std::cout << "TRANSPOSE " << name << ": Ref=" << ref_time << "us | SIMD=n/a" << std::endl;
+#endif
+}
+
 int main() {
     bench_add(1024);
     bench_add(1024*1024);
+    bench_exp(1024);
+    bench_exp(1024*1024);
+    bench_transpose({1024, 1024}, {1, 0}, "[1024, 1024] {1, 0}");
+    bench_transpose({8, 128, 64}, {0, 2, 1}, "[8, 128, 64] {0, 2, 1}");
+    bench_transpose({128, 8, 64}, {1, 0, 2}, "[128, 8, 64] {1, 0, 2}");
     return 0;
 }
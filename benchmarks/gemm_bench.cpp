@@ -85,7 +85,7 @@ int main() {
     run_bench(64, 1000);
     run_bench(256, 100);
     run_bench(512, 20);
-    // run_bench(1024, 5); // Optional larger size
+    run_bench(1024, 5);
     
     return 0;
 }
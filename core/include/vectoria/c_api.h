@@ -47,10 +47,19 @@ void vectoria_graph_set_output(vectoria_graph_t g, int node_id);
 int vectoria_export_coreml(vectoria_graph_t g, const char* output_path);
 
 // --- Engine Execution ---
+// Engines created here reuse compiled plans of structurally identical graphs
+// (process-wide plan cache, see EngineConfig::cache_plans). The cache keeps
+// the most recently used plans up to its capacity (default 64, 0 disables it).
 vectoria_engine_t vectoria_engine_create(vectoria_graph_t g);
 vectoria_engine_t vectoria_engine_create_with_policy(vectoria_graph_t g, int policy);
 void vectoria_engine_destroy(vectoria_engine_t e);
 
+// Structural hash of a graph (nodes, shapes, dtypes, params, outputs)
+uint64_t vectoria_graph_fingerprint(vectoria_graph_t g);
+size_t vectoria_plan_cache_size();
+void vectoria_plan_cache_clear();
+void vectoria_plan_cache_set_capacity(size_t capacity);
+
 void vectoria_engine_compile(vectoria_engine_t e);
 void vectoria_engine_execute(vectoria_engine_t e);
 
@@ -82,6 +91,32 @@ void vectoria_get_capabilities(
     size_t arch_name_len
 );
 
+// Host CPU feature bits (vectoria_get_host_features).
+#define VECTORIA_CPU_AVX          (1ull << 0)
+#define VECTORIA_CPU_AVX2         (1ull << 1)
+#define VECTORIA_CPU_FMA          (1ull << 2)
+#define VECTORIA_CPU_F16C         (1ull << 3)
+#define VECTORIA_CPU_AVX512F      (1ull << 4)
+#define VECTORIA_CPU_AVX512BW     (1ull << 5)
+#define VECTORIA_CPU_AVX512VL     (1ull << 6)
+#define VECTORIA_CPU_AVX512_VNNI  (1ull << 7)
+#define VECTORIA_CPU_AVX_VNNI     (1ull << 8)
+#define VECTORIA_CPU_NEON         (1ull << 16)
+#define VECTORIA_CPU_NEON_FP16    (1ull << 17)
+#define VECTORIA_CPU_NEON_DOTPROD (1ull << 18)
+
+// Detected CPU features (VECTORIA_CPU_* bits), data cache sizes in bytes
+// (0 if unknown) and the kernel variant SimdTier::Auto selects ("AVX-512F",
+// "AVX2", "NEON" or "Reference"). Any pointer may be NULL.
+void vectoria_get_host_features(
+    uint64_t* features,
+    size_t* l1d_cache_bytes,
+    size_t* l2_cache_bytes,
+    size_t* l3_cache_bytes,
+    char* variant_buffer,
+    size_t variant_len
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "vectoria/kernel_policy.hpp"
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -15,6 +17,51 @@ enum class Architecture {
     ARM64
 };
 
+/**
+ * Instruction set extensions of the host CPU.
+ * x86_64 flags come from CPUID, and only count if the OS saves the register
+ * state they need (XGETBV). ARM64 flags come from HWCAP on Linux and sysctl
+ * on macOS. Flags of the other architecture are always false.
+ */
+struct CpuFeatures {
+    // x86_64
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+    bool avx512_vnni = false;
+    bool avx_vnni = false;
+    // ARM64
+    bool neon = false;
+    bool neon_fp16 = false;
+    bool neon_dotprod = false;
+};
+
+/**
+ * Data cache sizes of the host in bytes (0 if unknown). Per core for L1D and
+ * usually L2; L3 is the size of one shared cache.
+ */
+struct CacheInfo {
+    size_t l1d_bytes = 0;
+    size_t l2_bytes = 0;
+    size_t l3_bytes = 0;
+};
+
+/**
+ * One instruction-set variant of the SIMD kernels linked into this binary.
+ * The x86_64 build carries both the AVX2 and the AVX-512F kernels; each
+ * variant names the SimdTier the plan is built with and the CPU features its
+ * kernels execute.
+ */
+struct KernelVariant {
+    const char* name;
+    SimdTier tier;
+    bool (*supported)(const CpuFeatures& features);
+};
+
 /**
  * Capability information for the current build/host.
  */
@@ -22,8 +69,15 @@ struct SystemCapabilities {
     Architecture arch;
     std::string arch_name;
     bool simd_compiled;
+    /** The host can run at least one compiled SIMD kernel variant. */
     bool simd_supported_on_host;
     std::vector<std::string> available_kernels;
+    CpuFeatures features;
+    /** Names of the set CpuFeatures flags ("AVX2", "FMA", ..., "NEON"). */
+    std::vector<std::string> feature_names;
+    CacheInfo caches;
+    /** Variant SimdTier::Auto selects on this host, or "Reference". */
+    std::string selected_variant;
 };
 
 /**
@@ -31,5 +85,29 @@ struct SystemCapabilities {
  */
 SystemCapabilities get_system_capabilities();
 
+/**
+ * CPU features of this host. Detected once per process.
+ */
+const CpuFeatures& host_cpu_features();
+
+/**
+ * Data cache sizes of this host. Detected once per process.
+ */
+const CacheInfo& host_cache_info();
+
+/**
+ * The validated SIMD kernel variants compiled into this binary, best first.
+ * Empty without VECTORIA_USE_ASM. exec::select_kernels picks the first one
+ * the host supports.
+ */
+const std::vector<KernelVariant>& kernel_variants();
+
+/**
+ * True if this CPU can run the AVX-512F kernels: CPUID reports AVX-512F and
+ * the OS saves the opmask and ZMM registers (XCR0 bits 5-7, via XGETBV).
+ * Evaluated once per process. Always false on other architectures.
+ */
+bool host_has_avx512f();
+
 } // namespace capabilities
 } // namespace vectoria
@@ -5,13 +5,126 @@
 #include "vectoria/kernel_policy.hpp"
 #include "vectoria/execution_mode.hpp"
 #include "vectoria/trace.hpp"
+#include "vectoria/exec_plan.hpp"
+#include "vectoria/thread_pool.hpp"
+#include "vectoria/plan_cache.hpp"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace vectoria {
 
 struct EngineConfig {
     KernelPolicy policy = KernelPolicy::Reference;
+
+    /**
+     * x86_64 SIMD tier (see SimdTier). The chosen tier shows in each step's
+     * KernelDispatch tag: "SIMD [x86_64-AVX512]" or "SIMD [x86_64]".
+     */
+    SimdTier simd_tier = SimdTier::Auto;
+
     ExecutionMode mode = ExecutionMode::Research;
+
+    /**
+     * Liveness-based reuse of intermediate buffers.
+     * When disabled, every node keeps its own buffer for the lifetime of the
+     * Engine (useful for inspecting intermediates after execute()).
+     */
+    bool plan_memory = true;
+
+    /**
+     * Zero-copy structural views.
+     * Reshape and contiguous (outer-axis) Slice nodes alias their producer's
+     * buffer instead of copying it. Bit-identical to the copying path.
+     */
+    bool alias_views = true;
+
+    /**
+     * Dead node elimination.
+     * Ops and constants that no entry of graph.outputs depends on are neither
+     * allocated nor executed (get_buffer() returns nullptr for them). Each
+     * pruned node is reported as a GraphCompilation event. Inputs and
+     * parameters are always kept; graphs without declared outputs are never
+     * pruned.
+     */
+    bool eliminate_dead_nodes = true;
+
+    /**
+     * Compile-time graph simplification (off by default).
+     * Folds ops whose inputs are all constants, dedupes identical constants
+     * and merges identical (op, inputs, params) nodes. Every rewrite is logged
+     * as a GraphCompilation event; outputs stay bitwise identical. Merged
+     * nodes are not executed and get_buffer() returns their canonical
+     * node's buffer. See simplify::simplify_graph.
+     */
+    bool optimize_graph = false;
+
+    /**
+     * Transpose folding (off by default).
+     * A MatMul operand produced by a 2D Transpose {1, 0} is read in place by
+     * the transposed GEMM (NT / TN) instead; the Transpose is then usually
+     * dead and pruned. Each fold is logged as a GraphCompilation event on
+     * the MatMul; outputs stay bitwise identical. Skipped when the policy
+     * has no transposed GEMM. See simplify::fold_transposes.
+     */
+    bool fold_transposes = false;
+
+    /**
+     * Number of executor threads (including the calling thread).
+     * With more than one, nodes whose dependencies are complete run
+     * concurrently. Every kernel runs exactly as in the serial schedule, so
+     * outputs are bitwise identical; only the interleaving of trace events
+     * changes.
+     */
+    size_t num_threads = 1;
+
+    /**
+     * Reuse compiled plans across engines (off by default).
+     * compile() looks the graph's structural fingerprint (plus the fields
+     * above) up in the process-wide cache::PlanCache. On a hit, validation,
+     * simplification, scheduling, memory planning and kernel selection are
+     * skipped: the engine allocates its own slab and rebinds the cached steps
+     * to it. Compile events are replayed, followed by
+     * "Cached | Fingerprint: 0x...". Results are bitwise identical.
+     * The cache is bounded (PlanCache::set_capacity, least recently used
+     * plans are evicted).
+     */
+    bool cache_plans = false;
+
+    /**
+     * What execute() records (see trace::TraceLevel). Off and Counters skip
+     * the event ring entirely; Full keeps the complete event stream.
+     */
+    trace::TraceLevel trace_level = trace::TraceLevel::Full;
+
+    /**
+     * Ring buffer size in events for TraceLevel::Full (rounded up to a power
+     * of two). Allocated once in compile(); the oldest events are overwritten
+     * when it fills up.
+     */
+    size_t trace_capacity = trace::Tracer::kDefaultCapacity;
+
+    /**
+     * Keep only the events of the last N recorded executions in the ring
+     * (0 = as many as fit in trace_capacity). Bounds the trace of a
+     * long-running engine without shrinking the ring.
+     */
+    size_t trace_retain_executions = 0;
+
+    /**
+     * At TraceLevel::Full, record events for every Nth execute() only
+     * (starting with the first); the others run at Counters level.
+     */
+    size_t trace_sample_every = 1;
+
+    /**
+     * Optional destination that receives every recorded event (e.g. a
+     * trace::FileTraceSink). Records are handed over at the end of compile()
+     * and of each execute(), outside the step loop.
+     */
+    std::shared_ptr<trace::TraceSink> trace_sink;
 };
 
 /**
@@ -44,9 +157,17 @@ public:
      */
     const std::vector<size_t>& get_schedule() const { return schedule_; }
 
+    /**
+     * Returns the compiled execution plan (one resolved step per scheduled node).
+     */
+    const std::vector<exec::ExecStep>& get_plan() const { return plan_; }
+
     /**
      * Get the raw buffer pointer for a specific node.
      * Useful for setting inputs and reading outputs.
+     * With memory planning enabled, intermediate buffers are reused once their
+     * last consumer has run; only inputs, parameters, constants and graph
+     * outputs are guaranteed to hold their values after execute().
      */
     void* get_buffer(size_t node_idx) const;
 
@@ -57,16 +178,49 @@ public:
 
 private:
     const ir::Graph& graph_;
+    std::shared_ptr<const ir::Graph> simplified_; // Rewritten copy of graph_ (optimize_graph, transpose folds), or null
     EngineConfig config_;
     std::vector<size_t> schedule_;
+    std::vector<exec::ExecStep> plan_;
     bool compiled_ = false;
 
     // Memory management
     memory::Arena arena_;
+    uint8_t* slab_ = nullptr;
     std::vector<void*> node_buffers_;
+    memory::MemoryPlan memory_plan_;
+    std::vector<int64_t> alias_of_; // Producer a view node reads through, -1 if materialized
     
     // Observability
     trace::Tracer tracer_;
+    std::vector<cache::CompileEvent> compile_events_; // Recorded for the plan cache
+    trace::TraceLevel active_level_ = trace::TraceLevel::Full; // Level of the current execute()
+    uint64_t executions_ = 0;
+
+    // Parallel execution: plan-step dependency graph, built in compile()
+    std::unique_ptr<exec::ThreadPool> pool_;
+    std::vector<std::vector<size_t>> successors_;
+    std::vector<uint32_t> dependency_counts_;
+    std::unique_ptr<std::atomic<uint32_t>[]> pending_dependencies_;
+    std::atomic<size_t> steps_remaining_{0};
+    std::atomic<bool> failed_{false};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    void compile_graph();
+    void note(trace::EventType type, size_t node_id, const std::string& details);
+    void load_constants();
+    std::shared_ptr<const cache::CompiledPlan> snapshot_plan(uint64_t fingerprint, std::string key) const;
+    void restore_plan(const cache::CompiledPlan& plan);
+
+    void build_dependencies(const std::vector<memory::BufferLifetime>& requests,
+                            const std::vector<size_t>& storage_root);
+    void run_step(const exec::ExecStep& step, size_t worker);
+    void execute_parallel();
+    static void run_step_task(void* ctx, size_t step_idx, size_t worker);
+
+    // Graph the schedule and plan refer to (simplified_ or graph_)
+    const ir::Graph& compiled_graph() const { return simplified_ ? *simplified_ : graph_; }
 
     // Helper to calculate byte size of a node's output
     size_t calculate_size_bytes(const ir::TensorShape& shape, ir::DataType dtype) const;
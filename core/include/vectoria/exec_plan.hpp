@@ -0,0 +1,182 @@
+#pragma once
+
+#include "vectoria/capabilities.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/kernel_policy.hpp"
+#include "vectoria/thread_pool.hpp"
+#include <string>
+#include <vector>
+
+namespace vectoria {
+namespace exec {
+
+struct ExecStep;
+
+/**
+ * Where a step is running.
+ * Steps that split their own work (tiled MatMul) use the pool from the
+ * calling worker; pool is nullptr on the single-threaded path.
+ */
+struct ExecContext {
+    ThreadPool* pool = nullptr;
+    size_t worker = 0;
+};
+
+/**
+ * Resolved kernel entry point for one step.
+ * Throws std::runtime_error if the kernel reports a failure.
+ */
+using StepFn = void (*)(const ExecStep& step, const ExecContext& ctx);
+
+/**
+ * MatMul output tile (rows x columns) used when a GEMM is split across threads.
+ * The rows are one MC block of the packed GEMM, a whole number of micro-kernel
+ * panels for both x86 tiers (MR = 6 and 12), so no tile ends in a partial
+ * panel; 256 columns are 16 / 8 NR panels and amortize the per-tile A packing.
+ */
+constexpr size_t kGemmTileM = 96;
+constexpr size_t kGemmTileN = 256;
+
+/**
+ * One scheduled node, fully resolved at compile time.
+ * Executing a step reads only these fields: no graph lookups, no shape
+ * copies and no string formatting happen on the execute() path.
+ */
+struct ExecStep {
+    size_t node_id = 0;
+
+    /** Kernel to run. nullptr for leaves and views (nothing to compute). */
+    StepFn fn = nullptr;
+
+    std::vector<const float*> inputs;
+    float* output = nullptr;
+
+    /**
+     * Precomputed extents. Meaning depends on the kernel:
+     * GEMM and FusedLinear (m, n, k), BiasAdd / broadcast (outer, inner),
+     * element-wise and reductions (count) or (outer, inner).
+     */
+    size_t m = 0;
+    size_t n = 0;
+    size_t k = 0;
+
+    // Structural parameters (Transpose, Concat, Slice)
+    int64_t axis = 0;
+    int64_t start = 0;
+    int64_t end = 0;
+    std::vector<int64_t> dims;
+    std::vector<int64_t> perm;
+    std::vector<std::vector<int64_t>> input_dims;
+
+    /** MatMul operand layout (VectoriaGemmTrans bits); lda / ldb follow from it. */
+    uint32_t trans = VECTORIA_GEMM_TRANS_NONE;
+
+    /** FusedLinear epilogue (VectoriaEpilogue). */
+    uint32_t epilogue = VECTORIA_EPILOGUE_NONE;
+
+    /** Float parameter: LayerNorm epsilon, Attention score scale. */
+    float scalar = 0.0f;
+
+    /** Attention key / value length (m = queries, k = head dim, n = value dim). */
+    size_t kv_len = 0;
+
+    /**
+     * BatchedMatMul: number of [m, k] x [k, n] products and the batch stride
+     * of B in elements (0 when one B is shared by every item). Items are
+     * spread across the pool's workers when one is available.
+     */
+    size_t batch = 0;
+    size_t batch_stride_b = 0;
+
+    /**
+     * Tiled MatMul / FusedLinear: kernel called once per kGemmTileM x
+     * kGemmTileN block of the output (the first of `linear`, `linear_s8`,
+     * `gemm_trans`, `gemm_f16w` that is set, else `gemm`). Zero tiles means
+     * the GEMM runs as a single call.
+     */
+    gemm_f32_t gemm = nullptr;
+    gemm_trans_f32_t gemm_trans = nullptr;
+    gemm_f16w_f32_t gemm_f16w = nullptr;
+    linear_f32_t linear = nullptr;
+    linear_s8_f32_t linear_s8 = nullptr;
+    size_t tiles_m = 0;
+    size_t tiles_n = 0;
+
+    /** KernelDispatch details, formatted once. Empty means no dispatch event. */
+    std::string trace_tag;
+
+    /** trace_tag interned in the engine's Tracer (set by Engine::compile). */
+    uint32_t trace_detail = 0;
+};
+
+/**
+ * True if MatMuls with transposed operands (int_params[0], see
+ * ir::MatMulTranspose) have a kernel under `policy` on this build. The SIMD
+ * policy never falls back to the reference GEMM, so without a SIMD transposed
+ * GEMM such MatMuls fail to compile.
+ */
+bool has_transposed_gemm(KernelPolicy policy);
+
+/**
+ * Kernels a plan is built with: the effective policy, the SIMD tier and the
+ * name of the kernel variant ("AVX-512F", "AVX2", "NEON" or "Reference").
+ */
+struct KernelSelection {
+    KernelPolicy policy = KernelPolicy::Reference;
+    SimdTier tier = SimdTier::AVX2;
+    std::string variant = "Reference";
+};
+
+/**
+ * Picks the best kernel variant (capabilities::kernel_variants) that `host`
+ * can run. Under the SIMD policy, Auto takes the first supported variant and
+ * falls back to the Reference policy if the host supports none, so a binary
+ * built with AVX2 kernels still runs on older CPUs. An explicit AVX2 or
+ * AVX512 tier throws if that variant is compiled in but unsupported by the
+ * host; AVX512 also throws if it is not compiled in. The Reference policy
+ * always selects the Reference kernels.
+ */
+KernelSelection select_kernels(KernelPolicy policy, SimdTier requested,
+                               const capabilities::CpuFeatures& host);
+
+/** select_kernels for this host (capabilities::host_cpu_features). */
+KernelSelection select_kernels(KernelPolicy policy, SimdTier requested);
+
+/**
+ * Resolves the SIMD tier a plan is built with (select_kernels(...).tier):
+ * Auto becomes AVX512 on hosts with AVX-512F and AVX2 otherwise. Throws
+ * if AVX512 is requested but not compiled in or not supported by the host.
+ * The Reference policy and non-x86_64 builds always resolve to AVX2, which
+ * then only means "no AVX-512".
+ */
+SimdTier resolve_simd_tier(KernelPolicy policy, SimdTier requested);
+
+/**
+ * Lowers a scheduled graph into a flat list of steps.
+ * Input arity and shapes are validated here, so malformed graphs fail in
+ * compile() rather than in the middle of execute().
+ *
+ * @param graph The graph being compiled.
+ * @param schedule Execution order (node indices).
+ * @param buffers Planned buffer for every node.
+ * @param alias_of Producer of each view node, -1 for materialized nodes.
+ * @param policy Kernel selection policy.
+ * @param num_threads Worker count of the executor. Above 1, MatMuls and
+ *        FusedLinears with more than one output tile are split across the pool.
+ * @param tier Resolved SIMD tier (resolve_simd_tier). With AVX512, ops that
+ *        have an AVX-512F kernel use it under the SIMD policy.
+ * @return One step per scheduled node, in schedule order.
+ */
+std::vector<ExecStep> build_exec_plan(
+    const ir::Graph& graph,
+    const std::vector<size_t>& schedule,
+    const std::vector<void*>& buffers,
+    const std::vector<int64_t>& alias_of,
+    KernelPolicy policy,
+    size_t num_threads = 1,
+    SimdTier tier = SimdTier::AVX2
+);
+
+} // namespace exec
+} // namespace vectoria
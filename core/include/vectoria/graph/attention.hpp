@@ -20,9 +20,11 @@ namespace graph {
  * @param q_id The Query node ID.
  * @param k_id The Key node ID.
  * @param v_id The Value node ID.
+ * @param fused Emit a single Attention node (tiled, online softmax; the
+ *        [T, T] scores are never materialized) instead of the expansion.
  * @return The node ID of the final Attention output.
  */
-int add_attention_composed(ir::Graph& graph, int q_id, int k_id, int v_id);
+int add_attention_composed(ir::Graph& graph, int q_id, int k_id, int v_id, bool fused = false);
 
 } // namespace graph
 } // namespace vectoria
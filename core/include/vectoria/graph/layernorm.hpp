@@ -18,9 +18,10 @@ namespace graph {
  * @param input_id The input node ID.
  * @param gamma_id The gamma parameter node ID.
  * @param beta_id The beta parameter node ID.
+ * @param fused Emit a single LayerNorm node (epsilon = 1e-5) instead of the expansion.
  * @return The node ID of the final LayerNorm output.
  */
-int add_layernorm_composed(ir::Graph& graph, int input_id, int gamma_id, int beta_id);
+int add_layernorm_composed(ir::Graph& graph, int input_id, int gamma_id, int beta_id, bool fused = false);
 
 } // namespace graph
 } // namespace vectoria
@@ -18,9 +18,10 @@ namespace graph {
  * 
  * @param graph The graph to append nodes to.
  * @param input_id The input node ID.
+ * @param fused Emit a single LogSoftmax node instead of the expansion.
  * @return The node ID of the final LogSoftmax output.
  */
-int add_logsoftmax_composed(ir::Graph& graph, int input_id);
+int add_logsoftmax_composed(ir::Graph& graph, int input_id, bool fused = false);
 
 } // namespace graph
 } // namespace vectoria
@@ -15,13 +15,19 @@ namespace graph {
  * @param w_v_id Value projection weights [d_model, d_model].
  * @param w_o_id Output projection weights [d_model, d_model].
  * @param num_heads Number of heads.
+ * @param fused_attention Emit each head as one fused Attention node.
+ * @param batched_heads Compute all heads with two BatchedMatMul nodes
+ *        ([h, T, d_k] x [h, d_k, T], then [h, T, T] x [h, T, d_k]) instead
+ *        of per-head slices. Ignored when fused_attention is set.
  * @return The node ID of the final MHA output.
  */
 int add_multi_head_attention_composed(
     ir::Graph& graph, 
     int x_id, 
     int w_q_id, int w_k_id, int w_v_id, int w_o_id, 
-    int num_heads
+    int num_heads,
+    bool fused_attention = false,
+    bool batched_heads = false
 );
 
 } // namespace graph
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "vectoria/ir.hpp"
+
+namespace vectoria {
+namespace graph {
+
+/**
+ * Adds a ReduceSum, ReduceMax or ReduceMeanVar operation to the graph.
+ *
+ * The reduced axis is dropped from the output shape; ReduceMeanVar prepends
+ * an axis of 2 (mean, then population variance). Use add_slice on axis 0 to
+ * take either one.
+ *
+ * @param graph The graph to append nodes to.
+ * @param op ReduceSum, ReduceMax or ReduceMeanVar.
+ * @param input_id The input node ID.
+ * @param axis The axis to reduce (negative counts from the end).
+ * @return The node ID of the reduction output.
+ */
+int add_reduce(ir::Graph& graph, ir::OpType op, int input_id, int64_t axis = -1);
+
+} // namespace graph
+} // namespace vectoria
@@ -17,9 +17,10 @@ namespace graph {
  * 
  * @param graph The graph to append nodes to.
  * @param input_id The input node ID.
+ * @param fused Emit a single Softmax node instead of the expansion.
  * @return The node ID of the final Softmax output.
  */
-int add_softmax_stable_composed(ir::Graph& graph, int input_id);
+int add_softmax_stable_composed(ir::Graph& graph, int input_id, bool fused = false);
 
 } // namespace graph
 } // namespace vectoria
@@ -15,6 +15,17 @@ namespace graph {
  * @param gamma1_id, beta1_id LayerNorm 1 parameters.
  * @param w1_id, b1_id, w2_id, b2_id FFN weights and biases.
  * @param gamma2_id, beta2_id LayerNorm 2 parameters.
+ * @param fuse_ffn Emit each FFN projection as one FusedLinear node
+ *        (bias + ReLU epilogue, then bias) instead of MatMul -> BiasAdd
+ *        (-> Relu). Results are bitwise identical under the same policy.
+ * @param fuse_layernorm Emit each LayerNorm as one LayerNorm node instead
+ *        of its 11-node expansion (agrees within float rounding).
+ * @param fuse_attention Emit each head as one fused Attention node.
+ * @param batch_heads Compute all heads with two BatchedMatMul nodes
+ *        (see add_multi_head_attention_composed).
+ * @param w1_scales_id, w2_scales_id Per-output-channel scales [d_ff] /
+ *        [d_model] of Int8 W1 / W2. When given (both or neither), each FFN
+ *        projection is one QuantizedLinear node with the fuse_ffn epilogues.
  * @return The node ID of the final Encoder Block output.
  */
 int add_transformer_encoder_composed(
@@ -23,7 +34,12 @@ int add_transformer_encoder_composed(
     int w_q_id, int w_k_id, int w_v_id, int w_o_id, int num_heads,
     int gamma1_id, int beta1_id,
     int w1_id, int b1_id, int w2_id, int b2_id,
-    int gamma2_id, int beta2_id
+    int gamma2_id, int beta2_id,
+    bool fuse_ffn = false,
+    bool fuse_layernorm = false,
+    bool fuse_attention = false,
+    bool batch_heads = false,
+    int w1_scales_id = -1, int w2_scales_id = -1
 );
 
 } // namespace graph
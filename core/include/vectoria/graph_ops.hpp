@@ -12,6 +12,7 @@
 #include "vectoria/graph/reshape.hpp"
 #include "vectoria/graph/concatenation.hpp"
 #include "vectoria/graph/slice.hpp"
+#include "vectoria/graph/reduce.hpp"
 
 namespace vectoria {
 namespace graph {
@@ -25,9 +26,11 @@ namespace graph {
  * 
  * @param graph The graph to append nodes to.
  * @param input_id The input node ID.
+ * @param fused Emit a single Softmax node instead of the expansion (which
+ *              remains the semantic definition the kernel is certified against).
  * @return The node ID of the final Softmax output.
  */
-int add_softmax_composed(ir::Graph& graph, int input_id);
+int add_softmax_composed(ir::Graph& graph, int input_id, bool fused = false);
 
 } // namespace graph
 } // namespace vectoria
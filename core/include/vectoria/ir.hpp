@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <cstring>
 #include <variant>
 
 namespace vectoria {
@@ -36,9 +37,72 @@ enum class OpType : uint16_t {
     Transpose,
     Reshape,
     Concat,
-    Slice
+    Slice,
+    FusedLinear,
+    LogSoftmax,
+    LayerNorm,
+    Attention,
+    BatchedMatMul,
+    QuantizedLinear,
+    ReduceMeanVar
 };
 
+/**
+ * Epilogue of a FusedLinear node, stored in int_params[0].
+ * Inputs are [X, W] for None and [X, W, Bias] otherwise.
+ */
+enum class LinearEpilogue : int64_t {
+    None = 0,     // X * W
+    Bias = 1,     // X * W + Bias
+    BiasRelu = 2  // max(0, X * W + Bias)
+};
+
+/**
+ * QuantizedLinear inputs are [X, W, Scales] for LinearEpilogue::None and
+ * [X, W, Scales, Bias] otherwise (epilogue in int_params[0]): X [M, K]
+ * Float32, W [K, N] Int8, Scales [N] Float32 (one per output channel).
+ * Rows of X are quantized to int8 at run time (absmax / 127 per row).
+ */
+
+/**
+ * ReduceSum, ReduceMax and ReduceMeanVar reduce the axis in int_params[0]
+ * (negative counts from the end; absent means -1, the last axis). The
+ * output drops that axis. ReduceMeanVar stacks its two results on a new
+ * leading axis: output [2, ...reduced shape] holds the mean in row 0 and the
+ * population variance in row 1, so Slice on axis 0 yields either as a view.
+ */
+
+/**
+ * Operand layout of a MatMul, stored in int_params[0] (absent means None).
+ * With A set, input 0 is stored [K, M]; with B set, input 1 is stored
+ * [N, K]. Same bits as VectoriaGemmTrans.
+ */
+enum class MatMulTranspose : int64_t {
+    None = 0,  // [M, K] x [K, N]
+    A = 1,     // [K, M]^T x [K, N]
+    B = 2,     // [M, K] x [N, K]^T
+    AB = 3     // [K, M]^T x [N, K]^T
+};
+
+/**
+ * Float parameters travel in int_params as their bit pattern:
+ * LayerNorm inputs are [X, Gamma, Beta] (normalized over the last axis),
+ * int_params[0] = epsilon; Attention inputs are [Q, K, V] (2D),
+ * int_params[0] = score scale.
+ */
+inline int64_t encode_f32_param(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return static_cast<int64_t>(bits);
+}
+
+inline float decode_f32_param(int64_t param) {
+    const uint32_t bits = static_cast<uint32_t>(param);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
 struct NodeId {
     size_t index;
 };
@@ -34,6 +34,98 @@ typedef VectoriaStatus (*gemm_f32_t)(
     float alpha, float beta
 );
 
+/**
+ * Operand layouts of the transposed GEMM (bit flags).
+ * With VECTORIA_GEMM_TRANS_A, A is stored [k, m] and read as A^T; with
+ * VECTORIA_GEMM_TRANS_B, B is stored [n, k] and read as B^T. lda / ldb are
+ * the row strides of the stored matrices.
+ */
+enum VectoriaGemmTrans : uint32_t {
+    VECTORIA_GEMM_TRANS_NONE = 0,
+    VECTORIA_GEMM_TRANS_A = 1,
+    VECTORIA_GEMM_TRANS_B = 2
+};
+
+/**
+ * Transposed GEMM Signature: C = alpha * (op(A) * op(B)) + beta * C,
+ * op selected by `trans` (VectoriaGemmTrans bits). For every layout the
+ * result is bitwise equal to the NN kernel of the same family run on
+ * explicitly transposed copies.
+ */
+typedef VectoriaStatus (*gemm_trans_f32_t)(
+    const float* a,
+    const float* b,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta,
+    uint32_t trans
+);
+
+/**
+ * FP16-weight GEMM Signature: C = alpha * (A * B) + beta * C with B stored
+ * as IEEE binary16 (ldb in elements). Each weight is widened exactly to
+ * float, then accumulated in FP32: the result is bitwise equal to the FP32
+ * GEMM of the same family on the decoded weights.
+ */
+typedef VectoriaStatus (*gemm_f16w_f32_t)(
+    const float* a,
+    const uint16_t* b,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta
+);
+
+/**
+ * Epilogues of the fused linear kernels, applied to each output element
+ * after its full K loop.
+ */
+enum VectoriaEpilogue : uint32_t {
+    VECTORIA_EPILOGUE_NONE = 0,      // C = A * B
+    VECTORIA_EPILOGUE_BIAS = 1,      // C = A * B + bias
+    VECTORIA_EPILOGUE_BIAS_RELU = 2  // C = max(0, A * B + bias)
+};
+
+/**
+ * Fused Linear Signature: C = epilogue(A * B, bias)
+ * bias holds n floats (ignored for VECTORIA_EPILOGUE_NONE).
+ */
+typedef VectoriaStatus (*linear_f32_t)(
+    const float* a,
+    const float* b,
+    const float* bias,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+);
+
+/**
+ * Largest K of the int8 linear kernels: every int32 sum of K products
+ * (|activation| <= 127, |weight| <= 128) stays exact.
+ */
+static const size_t VECTORIA_S8_MAX_K = 132104;
+
+/**
+ * Quantized Linear Signature: C = epilogue(dequant(quant(A) * B), bias)
+ * B [k, n] holds int8 weights with one FP32 scale per output column
+ * (b_scales, n floats). Each row of A is quantized to [-127, 127] with its
+ * own scale (absmax / 127), products are summed exactly in int32, and each
+ * sum s is dequantized as (s * a_scale[i]) * b_scales[j] before the
+ * epilogue. k must not exceed VECTORIA_S8_MAX_K.
+ */
+typedef VectoriaStatus (*linear_s8_f32_t)(
+    const float* a,
+    const int8_t* b,
+    const float* b_scales,
+    const float* bias,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+);
+
 /**
  * Unary Operation Signature: Out = op(In)
  */
@@ -53,6 +145,32 @@ typedef VectoriaStatus (*binary_f32_t)(
     size_t count
 );
 
+/**
+ * Broadcast Binary Signature, A viewed as [outer, inner]:
+ * column kernels compute Out[i, j] = op(A[i, j], B[i]) (outer == 1 is the
+ * scalar broadcast), row kernels Out[i, j] = op(A[i, j], B[j]).
+ */
+typedef VectoriaStatus (*binary_broadcast_f32_t)(
+    const float* a,
+    const float* b,
+    float* out,
+    size_t outer,
+    size_t inner
+);
+
+/**
+ * 2D Transpose Signature: Out[j, i] = In[i, j] for i < rows, j < cols.
+ * ld_in / ld_out are the row strides of In [rows, cols] and Out [cols, rows].
+ */
+typedef VectoriaStatus (*transpose_2d_f32_t)(
+    const float* in,
+    float* out,
+    size_t rows,
+    size_t cols,
+    size_t ld_in,
+    size_t ld_out
+);
+
 // --- ASM Symbol Declarations ---
 // These are defined in asm/
 #if defined(__x86_64__)
@@ -62,6 +180,238 @@ typedef VectoriaStatus (*binary_f32_t)(
         size_t lda, size_t ldb, size_t ldc,
         float alpha, float beta
     );
+
+    /**
+     * 6x16 register-blocked micro-kernel over packed panels (see
+     * asm/x86_64/gemm_avx2_6x16.S). flags bit 0 continues from partial sums
+     * stored in C, bit 1 marks the final K block (alpha / beta applied),
+     * bit 2 adds bias[0..15] and bit 3 applies ReLU on the final block.
+     */
+    VectoriaStatus gemm_f32_avx2_kernel_6x16(
+        const float* a_pack, const float* b_pack, float* c,
+        size_t k, size_t ldc, uint64_t flags,
+        float alpha, float beta, const float* bias
+    );
+
+    /**
+     * Cache-blocked GEMM: packs A/B panels and drives the 6x16 micro-kernel.
+     * Bitwise identical to gemm_f32_avx2 (same per-element FMA order).
+     * Defined in core/src/kernels/gemm_avx2_packed.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus gemm_f32_avx2_packed(
+        const float* a, const float* b, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        float alpha, float beta
+    );
+
+    /**
+     * gemm_f32_avx2_packed with transposed operands (gemm_trans_f32_t): the
+     * packing routines read A^T / B^T in place, so the packed panels, and
+     * therefore the results, are those of the NN call on transposed copies.
+     * Defined in core/src/kernels/gemm_avx2_packed.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus gemm_trans_f32_avx2_packed(
+        const float* a, const float* b, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        float alpha, float beta, uint32_t trans
+    );
+
+    /**
+     * Fused linear layer on the packed GEMM: the epilogue is applied by the
+     * micro-kernel while each C tile is still in registers. Bitwise identical
+     * to gemm_f32_avx2 followed by a scalar bias add and ReLU.
+     * Defined in core/src/kernels/gemm_avx2_packed.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus linear_f32_avx2(
+        const float* a, const float* b, const float* bias, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        uint32_t epilogue
+    );
+
+    // Broadcast element-wise kernels (asm/x86_64/broadcast_avx2.S), binary_broadcast_f32_t.
+    VectoriaStatus add_col_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus sub_col_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus mul_col_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus div_col_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus add_row_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus sub_row_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus mul_row_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+    VectoriaStatus div_row_f32_avx2(const float* a, const float* b, float* out, size_t outer, size_t inner);
+
+    // 8x8 in-register tile transpose (asm/x86_64/transpose_avx2.S), transpose_2d_f32_t.
+    VectoriaStatus transpose_2d_f32_avx2(const float* in, float* out, size_t rows, size_t cols, size_t ld_in, size_t ld_out);
+
+    /**
+     * out[i] = exp(in[i] - *shift) (skipped if out is NULL), *sum = their sum.
+     * Defined in asm/x86_64/exp_avx2.S (same exp as exp_f32_avx2).
+     */
+    VectoriaStatus exp_shift_sum_f32_avx2(const float* in, float* out, size_t count, const float* shift, float* sum);
+
+    /**
+     * Fused row-wise Softmax / LogSoftmax over In [outer, inner]: one max pass,
+     * one exp + sum pass, one output pass per row (row stays in L1).
+     * Defined in core/src/kernels/softmax_avx2.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus softmax_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus logsoftmax_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+
+    /**
+     * LayerNorm row kernels (asm/x86_64/layernorm_avx2.S).
+     * moments: d = in[i] - *shift, sums = {sum d, sum d * d}.
+     * apply: out[i] = (in[i] - stats[0]) * stats[1] * gamma[i] + beta[i], stats = {mean, 1 / std}.
+     */
+    VectoriaStatus layernorm_moments_f32_avx2(const float* in, size_t count, const float* shift, float* sums);
+    VectoriaStatus layernorm_apply_f32_avx2(const float* in, const float* gamma, const float* beta,
+                                            float* out, size_t count, const float* stats);
+
+    /**
+     * Fused row-wise LayerNorm over In [outer, inner]: one moments pass and
+     * one output pass per row. Defined in core/src/kernels/layernorm_avx2.cpp.
+     */
+    VectoriaStatus layernorm_f32_avx2(const float* in, const float* gamma, const float* beta,
+                                      float* out, size_t outer, size_t inner, float epsilon);
+
+    /**
+     * Reductions down the rows of In [rows, cols], columns in the vector lanes
+     * (asm/x86_64/reduce_rows_avx2.S). They accumulate into their outputs in row
+     * order: sum / max fold In[:, j] into out[j]; moments add d = In[i][j] - shift[j]
+     * to sum_d[j] and d * d to sum_d2[j].
+     */
+    VectoriaStatus reduce_sum_rows_f32_avx2(const float* in, float* out, size_t rows, size_t cols);
+    VectoriaStatus reduce_max_rows_f32_avx2(const float* in, float* out, size_t rows, size_t cols);
+    VectoriaStatus reduce_moments_rows_f32_avx2(const float* in, const float* shift, float* sum_d,
+                                                float* sum_d2, size_t rows, size_t cols);
+
+    /**
+     * ReduceSum / ReduceMax / ReduceMeanVar over the middle axis of
+     * In [outer, reduced, inner], same contract as the Reference axis kernels.
+     * inner > 1 gives the Reference bits. inner == 1 (last axis) runs the row
+     * kernels instead, reduce_sum / reduce_max_f32_avx2 and the LayerNorm
+     * moments, which accumulate in 8 lanes: sums and moments then differ from
+     * the Reference in rounding only.
+     * Defined in core/src/kernels/reduce_axis_avx2.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus reduce_sum_axis_f32_avx2(const float* in, float* out, size_t outer,
+                                            size_t reduced, size_t inner);
+    VectoriaStatus reduce_max_axis_f32_avx2(const float* in, float* out, size_t outer,
+                                            size_t reduced, size_t inner);
+    VectoriaStatus reduce_mean_var_f32_avx2(const float* in, float* mean, float* var, size_t outer,
+                                            size_t reduced, size_t inner);
+
+    /**
+     * Tiled scaled dot-product attention, Out = softmax(scale * Q K^T) V with
+     * an online softmax over key blocks: the [tq, tk] score matrix is never
+     * materialized. Q [tq, d], K [tk, d], V [tk, dv], Out [tq, dv].
+     * Defined in core/src/kernels/attention_avx2.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus attention_f32_avx2(const float* q, const float* k, const float* v, float* out,
+                                      size_t tq, size_t tk, size_t d, size_t dv, float scale);
+
+    // F16C half -> float (asm/x86_64/f16_avx2.S): a plain conversion, and one
+    // full 16-column B panel of the packed GEMM converted while packing.
+    VectoriaStatus convert_f16_f32_avx2(const uint16_t* in, float* out, size_t count);
+    VectoriaStatus pack_b_f16_avx2(const uint16_t* b, size_t ldb, size_t kc, float* out);
+
+    /**
+     * gemm_f32_avx2_packed with FP16 weights (gemm_f16w_f32_t): B panels are
+     * widened with F16C as they are packed, so only packing reads halves and
+     * the micro-kernel runs unchanged. Bitwise equal to gemm_f32_avx2_packed
+     * on the decoded weights.
+     * Defined in core/src/kernels/gemm_avx2_packed.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus gemm_f16w_f32_avx2_packed(
+        const float* a, const uint16_t* b, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        float alpha, float beta
+    );
+
+    // Int8 linear building blocks (asm/x86_64/gemm_s8_avx2.S): dynamic row
+    // quantization (same rounding as quantize_rows_s8), and one full
+    // 16-column int8 B panel widened to int16 k-pairs while packing.
+    VectoriaStatus quantize_row_s8_avx2(const float* x, size_t k, int8_t* q, float* scale);
+    VectoriaStatus pack_b_s8_avx2(const int8_t* b, size_t ldb, size_t k_pairs, int16_t* out);
+
+    /**
+     * 6x16 int16 micro-kernel of the int8 linear layer (vpmaddwd, int32
+     * sums). Panels hold k in pairs: A as k_pairs x 6 x 2, B as
+     * k_pairs x 16 x 2. flags bit 0 continues from int32 sums stored in C,
+     * bit 1 marks the final K block (dequantize with a_scales[0..5] and
+     * b_scales[0..15]), bits 2-3 add bias[0..15] / apply ReLU after that.
+     */
+    VectoriaStatus gemm_s8_avx2_kernel_6x16(
+        const int16_t* a_pack, const int16_t* b_pack, float* c,
+        size_t k_pairs, size_t ldc, uint64_t flags,
+        const float* a_scales, const float* b_scales, const float* bias
+    );
+
+    /**
+     * Int8 linear layer (linear_s8_f32_t) on packed int16 panels. Integer
+     * sums are exact, and the quantization and dequantization match
+     * linear_s8_f32, so results are bitwise equal to it.
+     * Defined in core/src/kernels/linear_s8_avx2.cpp (VECTORIA_USE_ASM builds).
+     */
+    VectoriaStatus linear_s8_f32_avx2(
+        const float* a, const int8_t* b, const float* b_scales, const float* bias, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        uint32_t epilogue
+    );
+
+    // --- AVX-512F tier ---
+    // Only call these when the host has AVX-512F with ZMM state enabled
+    // (capabilities::host_has_avx512f()); they fault with SIGILL otherwise.
+
+    /**
+     * 12x32 AVX-512F micro-kernel (asm/x86_64/gemm_avx512_12x32.S), same
+     * arguments and flags as gemm_f32_avx2_kernel_6x16; bias holds 32 floats.
+     */
+    VectoriaStatus gemm_f32_avx512_kernel_12x32(
+        const float* a_pack, const float* b_pack, float* c,
+        size_t k, size_t ldc, uint64_t flags,
+        float alpha, float beta, const float* bias
+    );
+
+    /**
+     * AVX-512F twins of gemm_f32_avx2_packed, gemm_trans_f32_avx2_packed and
+     * linear_f32_avx2: the same packed driver and K blocking around the
+     * 12x32 micro-kernel, so the results are bitwise identical to the AVX2
+     * kernels. Defined in core/src/kernels/gemm_avx2_packed.cpp.
+     */
+    VectoriaStatus gemm_f32_avx512_packed(
+        const float* a, const float* b, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        float alpha, float beta
+    );
+    VectoriaStatus gemm_trans_f32_avx512_packed(
+        const float* a, const float* b, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        float alpha, float beta, uint32_t trans
+    );
+    VectoriaStatus linear_f32_avx512(
+        const float* a, const float* b, const float* bias, float* c,
+        size_t m, size_t n, size_t k,
+        size_t lda, size_t ldb, size_t ldc,
+        uint32_t epilogue
+    );
+
+    // Element-wise kernels (asm/x86_64/elementwise_avx512.S), masked tails;
+    // bitwise identical to the AVX2 kernels.
+    VectoriaStatus add_f32_avx512(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus sub_f32_avx512(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus mul_f32_avx512(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus div_f32_avx512(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus relu_f32_avx512(const float* in, float* out, size_t count);
+
+    // Last-axis reductions (asm/x86_64/reduce_avx512.S). Max matches the AVX2
+    // kernel; Sum adds in 16 lanes and may differ from it in the last bits.
+    VectoriaStatus reduce_sum_f32_avx512(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus reduce_max_f32_avx512(const float* in, float* out, size_t outer, size_t inner);
 #endif
 
 #if defined(__aarch64__)
@@ -24,4 +24,18 @@ enum class KernelPolicy : uint8_t {
     SIMD = 1
 };
 
+/**
+ * x86_64 instruction set tier of the SIMD policy.
+ * Auto picks AVX-512F when the host supports it (detected at compile()),
+ * AVX2 otherwise. AVX2 pins the AVX2 kernels, e.g. to reproduce the results
+ * of an AVX2-only fleet bit for bit; AVX512 fails to compile on hosts
+ * without AVX-512F. Ops without an AVX-512 kernel run their AVX2 kernel in
+ * either tier. Ignored by the Reference policy and on ARM64.
+ */
+enum class SimdTier : uint8_t {
+    Auto = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
 } // namespace vectoria
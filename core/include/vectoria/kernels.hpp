@@ -35,6 +35,126 @@ VectoriaStatus gemm_f32(
     float alpha, float beta
 );
 
+/**
+ * Transposed GEMM (Reference): C = alpha * (op(A) * op(B)) + beta * C
+ * op(A) = A^T when trans has VECTORIA_GEMM_TRANS_A (A stored [K, M]),
+ * op(B) = B^T when trans has VECTORIA_GEMM_TRANS_B (B stored [N, K]).
+ * Same loop order as gemm_f32, so the result is bitwise equal to gemm_f32
+ * on explicitly transposed copies.
+ *
+ * @return VECTORIA_ERROR_INVALID_SHAPE for unknown trans bits.
+ */
+VectoriaStatus gemm_trans_f32(
+    const float* a,
+    const float* b,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta,
+    uint32_t trans
+);
+
+/**
+ * FP32 -> FP16 (IEEE binary16): round to nearest, ties to even. Values
+ * beyond the half range become +-Inf, NaNs stay NaN (quiet, top payload bits
+ * kept). This is the one place FP16 weights are rounded.
+ */
+uint16_t f32_to_f16(float value);
+
+/** FP16 -> FP32. Exact: every half is a float (signaling NaNs come back quiet, as with F16C). */
+float f16_to_f32(uint16_t value);
+
+/** Element-wise f32_to_f16 / f16_to_f32, e.g. to fill or read FP16 parameters. */
+VectoriaStatus convert_f32_to_f16(const float* input, uint16_t* output, size_t count);
+VectoriaStatus convert_f16_to_f32(const uint16_t* input, float* output, size_t count);
+
+/**
+ * GEMM with FP16 weights (Reference): C = alpha * (A * B) + beta * C,
+ * B [K, N] stored as binary16. gemm_f32's loop with f16_to_f32 applied to
+ * each weight, so the result is bitwise equal to gemm_f32 on the decoded
+ * weights (FP32 accumulation).
+ */
+VectoriaStatus gemm_f16w_f32(
+    const float* a,
+    const uint16_t* b,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta
+);
+
+/**
+ * Fused Linear (Reference): C = epilogue(A * B, bias)
+ * Reference twin of the SIMD fused linear kernels. Each element runs the
+ * gemm_f32 K loop, then adds bias[j] and applies max(0, x) as selected by
+ * `epilogue` (VectoriaEpilogue), so the result matches MatMul -> BiasAdd ->
+ * Relu on the reference backend bit for bit.
+ *
+ * @param bias Bias row (n floats); may be nullptr for VECTORIA_EPILOGUE_NONE.
+ * @return VECTORIA_ERROR_INVALID_SHAPE for an unknown epilogue or missing bias.
+ */
+VectoriaStatus linear_f32(
+    const float* a,
+    const float* b,
+    const float* bias,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+);
+
+/**
+ * Dynamic per-row INT8 quantization: scales[i] = absmax(row i) / 127 and
+ * q[i, p] = round_half_even(clamp(x * (127 / absmax), -127, 127)). A zero
+ * row gets scale 0 and all-zero codes; NaNs are skipped by absmax and
+ * quantize to -127 (inputs are expected to be finite).
+ */
+VectoriaStatus quantize_rows_s8(const float* a, size_t m, size_t k, size_t lda, int8_t* q, size_t ldq, float* scales);
+
+/**
+ * Per-output-channel INT8 weight quantization of W [k, n]: column j is
+ * quantized like one quantize_rows_s8 row, with its scale in scales[j].
+ */
+VectoriaStatus quantize_weights_s8(const float* w, size_t k, size_t n, int8_t* q, float* scales);
+
+/**
+ * Quantized Linear (Reference): linear_s8_f32_t. Rows of A are quantized
+ * with quantize_rows_s8, products are summed in int32 (exact, so the order
+ * is irrelevant), and each sum is dequantized as
+ * (sum * a_scale[i]) * b_scales[j] before the epilogue of linear_f32.
+ *
+ * @return VECTORIA_ERROR_INVALID_SHAPE for an unknown epilogue, a missing
+ *         bias or k > VECTORIA_S8_MAX_K.
+ */
+VectoriaStatus linear_s8_f32(
+    const float* a,
+    const int8_t* b,
+    const float* b_scales,
+    const float* bias,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+);
+
+/**
+ * Strided Batched GEMM: C_b = A_b * B_b for b < batch, where
+ * A_b = a + b * stride_a, B_b = b + b * stride_b, C_b = c + b * stride_c
+ * (strides in elements; stride_b = 0 shares one B across the batch).
+ * Each batch item is one call to `gemm` (gemm_f32, or a SIMD GEMM with the
+ * same signature), so an item's bits do not depend on the batch it is in.
+ */
+VectoriaStatus gemm_batched_f32(
+    const float* a,
+    const float* b,
+    float* c,
+    size_t batch,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    size_t stride_a, size_t stride_b, size_t stride_c,
+    gemm_f32_t gemm
+);
+
 /**
  * Bias Add: Out = In + Bias (Broadcast)
  * In: [M, N]
@@ -126,6 +246,50 @@ VectoriaStatus reduce_max_f32(
     size_t inner_dim
 );
 
+/**
+ * Reduce Sum over the middle axis: Out[o, j] = sum(In[o, :, j])
+ * In: [Outer, Reduced, Inner]
+ * Out: [Outer, Inner]
+ * Rows are accumulated in order, one row of Inner at a time.
+ */
+VectoriaStatus reduce_sum_axis_f32(
+    const float* input,
+    float* output,
+    size_t outer_dim,
+    size_t reduced_dim,
+    size_t inner_dim
+);
+
+/**
+ * Reduce Max over the middle axis: Out[o, j] = max(In[o, :, j])
+ * In: [Outer, Reduced, Inner]
+ * Out: [Outer, Inner]
+ */
+VectoriaStatus reduce_max_axis_f32(
+    const float* input,
+    float* output,
+    size_t outer_dim,
+    size_t reduced_dim,
+    size_t inner_dim
+);
+
+/**
+ * Mean and (population) variance over the middle axis from one read:
+ * d = In[o, i, j] - In[o, 0, j], Mean = shift + sum d / n,
+ * Var = max(0, (sum d^2 - (sum d)^2 / n) / n) with n = Reduced.
+ * In: [Outer, Reduced, Inner]
+ * Mean, Var: [Outer, Inner]
+ * Reduced must be non-zero.
+ */
+VectoriaStatus reduce_mean_var_f32(
+    const float* input,
+    float* mean,
+    float* var,
+    size_t outer_dim,
+    size_t reduced_dim,
+    size_t inner_dim
+);
+
 /**
  * Element-wise Exp: Out = exp(A)
  */
@@ -197,8 +361,66 @@ VectoriaStatus log_f32(
     size_t count
 );
 
+/**
+ * Fused Softmax (Last Axis): Out[i, j] = exp(In[i, j] - m_i) / s_i
+ * m_i = max(In[i, :]), s_i = sum_j exp(In[i, j] - m_i)
+ * In / Out: [Outer, Inner]
+ */
+VectoriaStatus softmax_f32(
+    const float* input,
+    float* output,
+    size_t outer,
+    size_t inner
+);
+
+/**
+ * Fused LogSoftmax (Last Axis): Out[i, j] = (In[i, j] - m_i) - log(s_i)
+ * In / Out: [Outer, Inner]
+ */
+VectoriaStatus logsoftmax_f32(
+    const float* input,
+    float* output,
+    size_t outer,
+    size_t inner
+);
+
+/**
+ * Fused LayerNorm (Last Axis):
+ * Out[i, j] = (In[i, j] - mean_i) / sqrt(var_i + epsilon) * Gamma[j] + Beta[j]
+ * Both moments come from one read of the row (sums of In[i, j] - In[i, 0]).
+ * In / Out: [Outer, Inner], Gamma / Beta: [Inner]
+ */
+VectoriaStatus layernorm_f32(
+    const float* input,
+    const float* gamma,
+    const float* beta,
+    float* output,
+    size_t outer,
+    size_t inner,
+    float epsilon
+);
+
+/**
+ * Fused Scaled Dot-Product Attention: Out = softmax(scale * Q K^T) V
+ * Each query row runs an online softmax over blocks of keys (running max and
+ * sum, accumulator rescaled when the max grows), so no [Tq, Tk] scores exist.
+ * Q: [Tq, D], K: [Tk, D], V: [Tk, Dv], Out: [Tq, Dv]
+ */
+VectoriaStatus attention_f32(
+    const float* q,
+    const float* k,
+    const float* v,
+    float* output,
+    size_t tq,
+    size_t tk,
+    size_t d,
+    size_t dv,
+    float scale
+);
+
 /**
  * Transpose (Reference): Out[new_indices] = In[old_indices]
+ * Same as transpose_f32_tiled with transpose_2d_f32 as the tile kernel.
  */
 VectoriaStatus transpose_f32(
     const float* input,
@@ -207,6 +429,34 @@ VectoriaStatus transpose_f32(
     const std::vector<int64_t>& perm
 );
 
+/**
+ * 2D Transpose (Reference, cache-blocked): Out[j, i] = In[i, j]
+ * Matches transpose_2d_f32_t.
+ */
+VectoriaStatus transpose_2d_f32(
+    const float* in,
+    float* out,
+    size_t rows,
+    size_t cols,
+    size_t ld_in,
+    size_t ld_out
+);
+
+/**
+ * Transpose with a pluggable 2D kernel.
+ * Size-1 axes are dropped and axes that stay adjacent are merged first; then
+ * - {1, 0} runs `tile` once, {0, 2, 1} once per batch,
+ * - a permutation that keeps the last axis copies contiguous rows,
+ * - anything else walks the output with precomputed input strides.
+ */
+VectoriaStatus transpose_f32_tiled(
+    const float* input,
+    float* output,
+    const std::vector<int64_t>& input_shape,
+    const std::vector<int64_t>& perm,
+    transpose_2d_f32_t tile
+);
+
 /**
  * Concatenate (Reference): Out = Concat(Inputs, axis)
  */
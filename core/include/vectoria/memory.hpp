@@ -46,5 +46,36 @@ private:
     void add_block(size_t min_size);
 };
 
+/**
+ * Lifetime of a single buffer along a static execution schedule.
+ * Positions are indices into the schedule, both ends inclusive.
+ */
+struct BufferLifetime {
+    size_t size;        // Bytes requested
+    size_t first_use;   // Schedule position that writes the buffer
+    size_t last_use;    // Last schedule position that reads the buffer
+    bool pinned;        // Must never share memory (inputs, parameters, outputs)
+};
+
+/**
+ * Result of static memory planning: one offset per request inside a single slab.
+ */
+struct MemoryPlan {
+    std::vector<size_t> offsets;
+    size_t peak_bytes = 0;   // Slab size required by the plan
+    size_t naive_bytes = 0;  // Slab size if every buffer had its own region
+};
+
+/**
+ * Assigns slab offsets so that two buffers share memory only if their lifetimes
+ * are disjoint. Pinned buffers are treated as live for the whole schedule.
+ *
+ * Placement is greedy: requests are visited largest-first (ties broken by
+ * first_use, then request index) and each takes the lowest aligned offset that
+ * does not collide with an already placed, lifetime-overlapping buffer.
+ * The result depends only on the request list, so layouts are reproducible.
+ */
+MemoryPlan plan_memory(const std::vector<BufferLifetime>& requests, size_t alignment);
+
 } // namespace memory
 } // namespace vectoria
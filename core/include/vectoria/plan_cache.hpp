@@ -0,0 +1,121 @@
+#pragma once
+
+#include "vectoria/ir.hpp"
+#include "vectoria/memory.hpp"
+#include "vectoria/exec_plan.hpp"
+#include "vectoria/trace.hpp"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vectoria {
+namespace cache {
+
+/**
+ * Canonical byte encoding of everything in a graph that compile() depends on:
+ * node kinds and ids, shapes, dtypes, op types, inputs, int_params, constant
+ * values and outputs. Input and parameter names and parameter buffer ids are
+ * not part of it. Two graphs with equal keys compile to the same plan.
+ */
+std::string structural_key(const ir::Graph& graph);
+
+/** 64-bit hash of a key (word-wise FNV-1a). Stable across runs and little-endian platforms. */
+uint64_t fingerprint(const std::string& key);
+
+/** fingerprint(structural_key(graph)). */
+uint64_t graph_fingerprint(const ir::Graph& graph);
+
+/** Compile-time trace event, replayed when a cached plan is reused. */
+struct CompileEvent {
+    trace::EventType type;
+    size_t node_id;
+    std::string details;
+};
+
+/**
+ * Everything compile() derives from a graph and its config, independent of
+ * where the engine's slab ends up in memory.
+ */
+struct CompiledPlan {
+    uint64_t fingerprint = 0;
+    std::string key; // Full structural key plus config; compared on lookup
+
+    /** Rewritten graph (optimize_graph, transpose folds), nullptr when the input graph is used as-is. */
+    std::shared_ptr<const ir::Graph> graph;
+
+    std::vector<size_t> schedule;
+    std::vector<int64_t> alias_of;
+    memory::MemoryPlan memory;
+
+    /** Byte offset of each node's buffer in the slab, kNoBuffer for pruned nodes. */
+    std::vector<size_t> buffer_offsets;
+    static constexpr size_t kNoBuffer = static_cast<size_t>(-1);
+
+    /**
+     * Resolved steps. Buffer pointers refer to the slab the plan was compiled
+     * against (slab_base); see rebase_steps().
+     */
+    std::vector<exec::ExecStep> steps;
+    uintptr_t slab_base = 0;
+
+    // Parallel executor dependency graph (num_threads > 1)
+    std::vector<std::vector<size_t>> successors;
+    std::vector<uint32_t> dependency_counts;
+
+    /** GraphCompilation / MemoryAllocation events between "Start" and "End". */
+    std::vector<CompileEvent> events;
+
+    /** Copy of steps with every buffer pointer moved from slab_base to `slab`. */
+    std::vector<exec::ExecStep> rebase_steps(uint8_t* slab) const;
+};
+
+/**
+ * Process-wide store of compiled plans, keyed by fingerprint.
+ * Thread-safe. A lookup only succeeds if the full key matches, so a
+ * fingerprint collision costs a recompile, never a wrong plan.
+ * Holds at most capacity() plans; inserting beyond that evicts the least
+ * recently used one. Engines keep their own reference, so eviction never
+ * affects an engine that is already compiled.
+ */
+class PlanCache {
+public:
+    static constexpr size_t kDefaultCapacity = 64;
+
+    static PlanCache& global();
+
+    std::shared_ptr<const CompiledPlan> find(uint64_t fingerprint, const std::string& key);
+    void insert(std::shared_ptr<const CompiledPlan> plan);
+
+    /** Evicts down to `capacity` plans at once; 0 disables caching. */
+    void set_capacity(size_t capacity);
+    size_t capacity() const;
+
+    void clear();
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+    uint64_t evictions() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<const CompiledPlan> plan;
+        std::list<uint64_t>::iterator lru; // position in lru_
+    };
+
+    void evict_to(size_t capacity); // caller holds mutex_
+
+    mutable std::mutex mutex_;
+    std::map<uint64_t, Entry> plans_;
+    std::list<uint64_t> lru_; // most recently used first
+    size_t capacity_ = kDefaultCapacity;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace cache
+} // namespace vectoria
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "vectoria/ir.hpp"
+#include "vectoria/kernel_policy.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace vectoria {
+namespace simplify {
+
+/**
+ * Outcome of graph simplification. Node ids are never renumbered.
+ */
+struct SimplifyResult {
+    /** Node whose value each node shares; the node itself unless it was merged. */
+    std::vector<size_t> canonical;
+
+    /** Ops replaced by a ConstantNode holding their compile-time value, in node order. */
+    std::vector<size_t> folded;
+};
+
+/**
+ * Rewrites a graph in place, visiting nodes in index order:
+ * - Constant folding: a Float32 op whose inputs are all fully populated
+ *   Float32 constants is evaluated once with the kernel `policy` (and
+ *   `tier`) would dispatch at execute() and becomes a ConstantNode.
+ * - Constant dedupe: constants with identical shape and bit pattern are
+ *   merged into the first one.
+ * - Common subexpressions: ops with identical (op, inputs, int_params,
+ *   output shape, dtype) are merged into the first one.
+ *
+ * Consumers of a merged node are rewired to its canonical node. The merged
+ * node stays in the graph (its id may still be read by the caller) but
+ * nothing depends on it. Results are bitwise identical to the original graph.
+ *
+ * @param graph Graph to rewrite. Must pass Engine::validate().
+ * @param policy Kernel selection policy used for folding.
+ * @param tier Resolved SIMD tier (exec::resolve_simd_tier) used for folding.
+ */
+SimplifyResult simplify_graph(ir::Graph& graph, KernelPolicy policy, SimdTier tier = SimdTier::AVX2);
+
+/**
+ * A MatMul operand produced by a 2D Transpose {1, 0} that the MatMul can
+ * read in place through its transpose flags (ir::MatMulTranspose).
+ */
+struct TransposeFold {
+    size_t matmul;    // MatMul node
+    size_t operand;   // 0 (A) or 1 (B)
+    size_t transpose; // Transpose node feeding the operand
+    size_t source;    // Input of the Transpose
+};
+
+/**
+ * Finds the Transpose -> MatMul pairs fold_transposes() would rewrite.
+ * Empty when `policy` has no transposed GEMM (exec::has_transposed_gemm).
+ */
+std::vector<TransposeFold> find_transpose_folds(const ir::Graph& graph, KernelPolicy policy);
+
+/**
+ * Rewires each folded MatMul operand to the Transpose's input and sets the
+ * matching bit of the MatMul's transpose flags (int_params[0]). The
+ * Transpose stays in the graph; once nothing reads it, dead node
+ * elimination drops it, and with it one full copy of the operand per
+ * execute(). Results are bitwise identical: the transposed GEMMs read
+ * exactly the values the copy would hold, in the same order.
+ *
+ * @param folds Result of find_transpose_folds() on this graph.
+ */
+void fold_transposes(ir::Graph& graph, const std::vector<TransposeFold>& folds);
+
+} // namespace simplify
+} // namespace vectoria
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vectoria {
+namespace exec {
+
+/**
+ * Unit of work for the thread pool.
+ * A plain function pointer plus context, so queuing a task never allocates
+ * a closure. Tasks must not throw.
+ */
+struct Task {
+    void (*fn)(void* ctx, size_t arg, size_t worker) = nullptr;
+    void* ctx = nullptr;
+    size_t arg = 0;
+};
+
+/**
+ * Fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a task deque. A worker pops its own deque LIFO (hot
+ * data stays in cache) and, when empty, steals FIFO from the other workers
+ * in a fixed victim order. Worker 0 is the thread that calls help_until();
+ * the pool spawns num_workers - 1 background threads.
+ *
+ * Which worker runs a task is not deterministic. Callers are responsible
+ * for making results independent of that choice (e.g. by only running tasks
+ * whose inputs are complete and whose outputs do not overlap).
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Number of workers, including the calling thread. */
+    size_t size() const { return workers_.size(); }
+
+    /** Queues a task on a worker's deque and wakes an idle worker. */
+    void push(size_t worker, Task task);
+
+    /**
+     * Runs queued tasks as `worker` until `remaining` reaches zero.
+     * Each task of the job must call finish() exactly once.
+     */
+    void help_until(size_t worker, const std::atomic<size_t>& remaining);
+
+    /** Marks one task of a job as done; wakes waiters when the job completes. */
+    void finish(std::atomic<size_t>& remaining);
+
+    /**
+     * Runs body(ctx, i, worker) for every i in [0, count) and returns when all
+     * calls are done. The calling `worker` takes part; up to size() - 1 helper
+     * tasks are queued on its deque and claim indices from a shared counter.
+     * Safe to call from inside a task. Unlike Task, body may throw: the first
+     * exception is rethrown here after every claimed index has finished.
+     */
+    void parallel_for(size_t worker, size_t count,
+                      void (*body)(void* ctx, size_t index, size_t worker), void* ctx);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool try_pop(size_t worker, Task& task);
+    void worker_loop(size_t worker);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};
+    bool stop_ = false;
+};
+
+} // namespace exec
+} // namespace vectoria
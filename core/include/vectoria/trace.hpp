@@ -2,8 +2,12 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <memory>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <mutex>
 
 namespace vectoria {
 namespace trace {
@@ -16,22 +20,173 @@ enum class EventType {
     KernelDispatch
 };
 
+/**
+ * How much execute() records.
+ * - Off: nothing; the step loop only runs kernels.
+ * - Counters: per-node execution count and accumulated duration.
+ * - Full: Counters plus every event in the ring buffer (the default).
+ * Compile-time events (GraphCompilation, MemoryAllocation) are recorded at Full only.
+ */
+enum class TraceLevel {
+    Off,
+    Counters,
+    Full
+};
+
+/** Decoded event, as returned by get_events() / event_at(). */
 struct TraceEvent {
     EventType type;
     uint64_t timestamp_ns;
     size_t node_id;         // Optional, or -1
     std::string details;    // E.g., "Reference", "SIMD", "1024 bytes"
+    size_t worker_id = 0;   // Executor worker that logged the event (0 = calling thread)
+};
+
+/**
+ * Fixed-size record stored in the ring buffer.
+ * Details are interned once (at compile time) and referenced by id, so
+ * recording an event copies 24 bytes and never allocates.
+ */
+struct TraceRecord {
+    uint64_t timestamp_ns;
+    uint64_t node_id;
+    uint32_t detail_id;
+    uint16_t worker_id;
+    uint8_t type;
+    uint8_t reserved;
 };
 
+/** Per-node execution statistics (TraceLevel::Counters and Full). */
+struct NodeCounter {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+};
+
+/** Name used for an event type in JSON traces ("KernelDispatch", ...). */
+const char* event_type_name(EventType type);
+
+/**
+ * Destination for streamed trace records.
+ * The Tracer publishes new records at the end of compile() and of every
+ * recorded execute(), on the thread that called it (never from executor
+ * workers). `details` is the tracer's intern table; it only ever grows, so a
+ * sink may cache the entries it has already seen. One sink per Engine.
+ */
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+
+    /** Receives `count` records in order. Should hand off and return quickly. */
+    virtual void consume(const TraceRecord* records, size_t count, const std::vector<std::string>& details) = 0;
+
+    /** Blocks until every consumed record is persisted. */
+    virtual void flush() {}
+};
+
+/** Monotonic clock used for every trace timestamp. */
+inline uint64_t now_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Event log backed by a preallocated ring buffer of TraceRecords.
+ *
+ * record() is lock-free and safe to call from several executor workers at
+ * once; events from concurrent workers interleave in arrival order. When the
+ * ring is full the oldest records are overwritten (see dropped()).
+ * Reading (size(), event_at(), get_events()) must not overlap with execute().
+ */
 class Tracer {
 public:
-    void log(EventType type, size_t node_id = -1, const std::string& details = "");
-    
-    const std::vector<TraceEvent>& get_events() const { return events_; }
-    void clear() { events_.clear(); }
+    static constexpr size_t kDefaultCapacity = size_t(1) << 16;
+
+    /**
+     * Sets the level and preallocates the ring (rounded up to a power of two)
+     * and one counter per node. Clears all recorded data.
+     *
+     * @param retain_executions Keep only the events of the last N executions
+     *        (0 = as many as fit in the ring). Compile-time events count as
+     *        part of the first execution.
+     * @param sink Optional destination that receives every record (see publish()).
+     */
+    void configure(TraceLevel level, size_t capacity, size_t num_nodes,
+                   size_t retain_executions = 0, std::shared_ptr<TraceSink> sink = nullptr);
+
+    TraceLevel level() const { return level_; }
+
+    /** Returns the id for a detail string, adding it on first use. Id 0 is "". */
+    uint32_t intern(const std::string& details);
+
+    /** Hot-path event: no clock read, no string, no allocation. */
+    void record(EventType type, uint64_t timestamp_ns, size_t node_id, uint32_t detail_id, size_t worker_id) {
+        if (records_.empty()) return;
+        uint64_t slot = head_.fetch_add(1, std::memory_order_relaxed) & mask_;
+        records_[slot] = {timestamp_ns, static_cast<uint64_t>(node_id), detail_id,
+                          static_cast<uint16_t>(worker_id), static_cast<uint8_t>(type), 0};
+    }
+
+    /** Adds one execution of a node to its counter. */
+    void count(size_t node_id, uint64_t duration_ns) {
+        if (node_id >= counters_.size()) return;
+        counters_[node_id].count++;
+        counters_[node_id].total_ns += duration_ns;
+    }
+
+    /** Marks the start of a recorded execution (for retain_executions). */
+    void begin_execution();
+
+    /**
+     * Hands records logged since the last call to the sink, if any.
+     * Must not overlap with record(). Records that were overwritten before
+     * being published are counted in sink_dropped().
+     */
+    void publish();
+
+    /** Records lost to the sink because the ring wrapped between two publish() calls. */
+    uint64_t sink_dropped() const { return sink_dropped_; }
+
+    /** Convenience for compile-time events: interns the details and records now. Full level only. */
+    void log(EventType type, size_t node_id = -1, const std::string& details = "", size_t worker_id = 0);
+
+    /** Number of events currently held (bounded by the ring and the retention policy). */
+    size_t size() const;
+
+    /** Event i, oldest first. */
+    TraceEvent event_at(size_t i) const;
+
+    /** All held events, oldest first. Decodes a copy; prefer size()/event_at() for large traces. */
+    std::vector<TraceEvent> get_events() const;
+
+    /** Events no longer held, because the ring was full or by retention. */
+    uint64_t dropped() const;
+
+    const std::vector<NodeCounter>& get_counters() const { return counters_; }
+
+    /** Forgets recorded events and counters; keeps capacity and interned details. */
+    void clear();
 
 private:
-    std::vector<TraceEvent> events_;
+    uint64_t tail() const;
+
+    TraceLevel level_ = TraceLevel::Full;
+    std::vector<TraceRecord> records_;
+    uint64_t mask_ = 0;
+    std::atomic<uint64_t> head_{0};
+
+    // Ring positions where each of the last retain_executions executions began.
+    std::vector<uint64_t> execution_starts_;
+    uint64_t executions_ = 0;
+
+    std::shared_ptr<TraceSink> sink_;
+    uint64_t published_ = 0;
+    uint64_t sink_dropped_ = 0;
+
+    std::vector<NodeCounter> counters_;
+
+    std::mutex intern_mutex_;
+    std::vector<std::string> details_{""};
+    std::map<std::string, uint32_t> detail_ids_{{"", 0}};
 };
 
 } // namespace trace
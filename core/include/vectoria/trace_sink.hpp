@@ -0,0 +1,61 @@
+#pragma once
+
+#include "vectoria/trace.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vectoria {
+namespace trace {
+
+enum class SinkFormat {
+    JSONL,  // One trace_schema.md event object per line
+    Binary  // "VTRC" header, then interned details and raw TraceRecords (see observability.md)
+};
+
+/**
+ * Streams records to a file on a background thread.
+ * consume() only copies records into a pending batch; formatting and I/O
+ * happen on the writer thread. The destructor writes everything queued.
+ */
+class FileTraceSink : public TraceSink {
+public:
+    FileTraceSink(const std::string& path, SinkFormat format);
+    ~FileTraceSink() override;
+
+    FileTraceSink(const FileTraceSink&) = delete;
+    FileTraceSink& operator=(const FileTraceSink&) = delete;
+
+    void consume(const TraceRecord* records, size_t count, const std::vector<std::string>& details) override;
+    void flush() override;
+
+    /** Records written to the file so far. */
+    uint64_t written() const;
+
+private:
+    void writer_loop();
+    void write_batch(const std::vector<TraceRecord>& batch, const std::vector<std::string>& new_details);
+
+    std::ofstream out_;
+    SinkFormat format_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::vector<TraceRecord> pending_;
+    std::vector<std::string> pending_details_;
+    size_t details_seen_ = 0;
+    bool busy_ = false;
+    bool stop_ = false;
+    uint64_t written_ = 0;
+
+    std::vector<std::string> details_; // Writer-thread copy of the intern table
+    std::thread thread_;
+};
+
+} // namespace trace
+} // namespace vectoria
@@ -50,6 +50,42 @@ void vectoria_get_capabilities(
     }
 }
 
+void vectoria_get_host_features(
+    uint64_t* features,
+    size_t* l1d_cache_bytes,
+    size_t* l2_cache_bytes,
+    size_t* l3_cache_bytes,
+    char* variant_buffer,
+    size_t variant_len
+) {
+    auto caps = capabilities::get_system_capabilities();
+    const auto& f = caps.features;
+    if (features) {
+        uint64_t bits = 0;
+        if (f.avx) bits |= VECTORIA_CPU_AVX;
+        if (f.avx2) bits |= VECTORIA_CPU_AVX2;
+        if (f.fma) bits |= VECTORIA_CPU_FMA;
+        if (f.f16c) bits |= VECTORIA_CPU_F16C;
+        if (f.avx512f) bits |= VECTORIA_CPU_AVX512F;
+        if (f.avx512bw) bits |= VECTORIA_CPU_AVX512BW;
+        if (f.avx512vl) bits |= VECTORIA_CPU_AVX512VL;
+        if (f.avx512_vnni) bits |= VECTORIA_CPU_AVX512_VNNI;
+        if (f.avx_vnni) bits |= VECTORIA_CPU_AVX_VNNI;
+        if (f.neon) bits |= VECTORIA_CPU_NEON;
+        if (f.neon_fp16) bits |= VECTORIA_CPU_NEON_FP16;
+        if (f.neon_dotprod) bits |= VECTORIA_CPU_NEON_DOTPROD;
+        *features = bits;
+    }
+    if (l1d_cache_bytes) *l1d_cache_bytes = caps.caches.l1d_bytes;
+    if (l2_cache_bytes) *l2_cache_bytes = caps.caches.l2_bytes;
+    if (l3_cache_bytes) *l3_cache_bytes = caps.caches.l3_bytes;
+
+    if (variant_buffer && variant_len > 0) {
+        strncpy(variant_buffer, caps.selected_variant.c_str(), variant_len - 1);
+        variant_buffer[variant_len - 1] = '\0';
+    }
+}
+
 vectoria_graph_t vectoria_graph_create() {
     return new ir::Graph();
 }
@@ -311,16 +347,35 @@ void vectoria_graph_set_output(vectoria_graph_t g, int node_id) {
 
 vectoria_engine_t vectoria_engine_create(vectoria_graph_t g) {
     auto* graph = static_cast<ir::Graph*>(g);
-    return new Engine(*graph);
+    EngineConfig cfg;
+    cfg.cache_plans = true;
+    return new Engine(*graph, cfg);
 }
 
 vectoria_engine_t vectoria_engine_create_with_policy(vectoria_graph_t g, int policy) {
     auto* graph = static_cast<ir::Graph*>(g);
     EngineConfig cfg;
     cfg.policy = static_cast<KernelPolicy>(policy);
+    cfg.cache_plans = true;
     return new Engine(*graph, cfg);
 }
 
+uint64_t vectoria_graph_fingerprint(vectoria_graph_t g) {
+    return cache::graph_fingerprint(*static_cast<ir::Graph*>(g));
+}
+
+size_t vectoria_plan_cache_size() {
+    return cache::PlanCache::global().size();
+}
+
+void vectoria_plan_cache_clear() {
+    cache::PlanCache::global().clear();
+}
+
+void vectoria_plan_cache_set_capacity(size_t capacity) {
+    cache::PlanCache::global().set_capacity(capacity);
+}
+
 void vectoria_engine_destroy(vectoria_engine_t e) {
     delete static_cast<Engine*>(e);
 }
@@ -338,7 +393,7 @@ void* vectoria_engine_get_buffer(vectoria_engine_t e, int node_id) {
 }
 
 size_t vectoria_engine_get_trace_size(vectoria_engine_t e) {
-    return static_cast<Engine*>(e)->get_tracer().get_events().size();
+    return static_cast<Engine*>(e)->get_tracer().size();
 }
 
 void vectoria_engine_get_trace_event(
@@ -350,10 +405,10 @@ void vectoria_engine_get_trace_event(
     char* details_buffer, 
     size_t buffer_len
 ) {
-    const auto& events = static_cast<Engine*>(e)->get_tracer().get_events();
-    if (index >= events.size()) return;
+    const auto& tracer = static_cast<Engine*>(e)->get_tracer();
+    if (index >= tracer.size()) return;
 
-    const auto& evt = events[index];
+    const trace::TraceEvent evt = tracer.event_at(index);
     if (type) *type = static_cast<int>(evt.type);
     if (timestamp_ns) *timestamp_ns = evt.timestamp_ns;
     if (node_id) *node_id = (evt.node_id == static_cast<size_t>(-1)) ? -1 : static_cast<int64_t>(evt.node_id);
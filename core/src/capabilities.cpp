@@ -1,8 +1,216 @@
 #include "vectoria/capabilities.hpp"
 
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#endif
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
 namespace vectoria {
 namespace capabilities {
 
+namespace {
+
+#if defined(__x86_64__)
+CpuFeatures detect_features() {
+    CpuFeatures f;
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return f;
+    const bool osxsave = (ecx >> 27) & 1;
+    if (!osxsave) return f;
+    const bool cpu_avx = (ecx >> 28) & 1;
+    const bool cpu_fma = (ecx >> 12) & 1;
+    const bool cpu_f16c = (ecx >> 29) & 1;
+    // XCR0: SSE (1), AVX (2), opmask (5), ZMM_Hi256 (6), Hi16_ZMM (7).
+    uint32_t xcr0_lo, xcr0_hi;
+    __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    const bool ymm_state = (xcr0_lo & 0x06) == 0x06;
+    const bool zmm_state = (xcr0_lo & 0xE6) == 0xE6;
+    if (!ymm_state) return f;
+    f.avx = cpu_avx;
+    f.fma = cpu_avx && cpu_fma;
+    f.f16c = cpu_avx && cpu_f16c;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return f;
+    const unsigned int max_subleaf = eax;
+    f.avx2 = cpu_avx && ((ebx >> 5) & 1);
+    if (zmm_state) {
+        f.avx512f = (ebx >> 16) & 1;
+        f.avx512bw = f.avx512f && ((ebx >> 30) & 1);
+        f.avx512vl = f.avx512f && ((ebx >> 31) & 1);
+        f.avx512_vnni = f.avx512f && ((ecx >> 11) & 1);
+    }
+    if (max_subleaf >= 1 && __get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx)) {
+        f.avx_vnni = f.avx2 && ((eax >> 4) & 1);
+    }
+    return f;
+}
+
+// Deterministic cache parameters: leaf 4 on Intel, 0x8000001D on AMD (same
+// layout). Size = ways * partitions * line size * sets.
+bool read_cache_leaf(unsigned int leaf, CacheInfo& info) {
+    unsigned int eax, ebx, ecx, edx;
+    bool found = false;
+    for (unsigned int i = 0; i < 16; ++i) {
+        if (!__get_cpuid_count(leaf, i, &eax, &ebx, &ecx, &edx)) return found;
+        const unsigned int type = eax & 0x1F; // 0 = no more caches, 1 = data, 2 = instruction, 3 = unified
+        if (type == 0) break;
+        if (type == 2) continue;
+        const unsigned int level = (eax >> 5) & 0x7;
+        const size_t ways = ((ebx >> 22) & 0x3FF) + 1;
+        const size_t partitions = ((ebx >> 12) & 0x3FF) + 1;
+        const size_t line = (ebx & 0xFFF) + 1;
+        const size_t sets = static_cast<size_t>(ecx) + 1;
+        const size_t bytes = ways * partitions * line * sets;
+        if (level == 1) info.l1d_bytes = bytes;
+        else if (level == 2) info.l2_bytes = bytes;
+        else if (level == 3) info.l3_bytes = bytes;
+        found = true;
+    }
+    return found;
+}
+
+CacheInfo detect_caches() {
+    CacheInfo info;
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) && eax >= 4 && read_cache_leaf(4, info)) return info;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && eax >= 0x8000001D) read_cache_leaf(0x8000001D, info);
+    return info;
+}
+#else
+#if defined(__APPLE__)
+uint64_t sysctl_u64(const char* name) {
+    uint64_t value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, nullptr, 0) != 0) return 0;
+    return size == sizeof(uint32_t) ? static_cast<uint32_t>(value) : value;
+}
+#endif
+
+CpuFeatures detect_features() {
+    CpuFeatures f;
+#if defined(__aarch64__) && defined(__linux__)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    f.neon = hwcap & (1UL << 1);          // HWCAP_ASIMD
+    f.neon_fp16 = hwcap & (1UL << 10);    // HWCAP_ASIMDHP
+    f.neon_dotprod = hwcap & (1UL << 20); // HWCAP_ASIMDDP
+#elif defined(__aarch64__) && defined(__APPLE__)
+    f.neon = true; // Architectural on Apple Silicon
+    f.neon_fp16 = sysctl_u64("hw.optional.arm.FEAT_FP16") != 0;
+    f.neon_dotprod = sysctl_u64("hw.optional.arm.FEAT_DotProd") != 0;
+#elif defined(__aarch64__)
+    f.neon = true;
+#endif
+    return f;
+}
+
+#if defined(__linux__)
+// sysfs reports sizes as e.g. "48K".
+size_t read_sysfs_cache(int index) {
+    char path[96];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+    FILE* file = std::fopen(path, "r");
+    if (!file) return 0;
+    unsigned long value = 0;
+    char unit = 0;
+    const int read = std::fscanf(file, "%lu%c", &value, &unit);
+    std::fclose(file);
+    if (read < 1) return 0;
+    if (unit == 'K') value <<= 10;
+    else if (unit == 'M') value <<= 20;
+    return value;
+}
+
+size_t read_sysfs_int(int index, const char* field) {
+    char path[96];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/%s", index, field);
+    FILE* file = std::fopen(path, "r");
+    if (!file) return 0;
+    unsigned long value = 0;
+    const int read = std::fscanf(file, "%lu", &value);
+    std::fclose(file);
+    return read == 1 ? value : 0;
+}
+#endif
+
+CacheInfo detect_caches() {
+    CacheInfo info;
+#if defined(__APPLE__)
+    info.l1d_bytes = sysctl_u64("hw.l1dcachesize");
+    info.l2_bytes = sysctl_u64("hw.l2cachesize");
+    info.l3_bytes = sysctl_u64("hw.l3cachesize");
+#elif defined(__linux__)
+    for (int i = 0; i < 8; ++i) {
+        char path[96];
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", i);
+        FILE* file = std::fopen(path, "r");
+        if (!file) break;
+        char type[32] = {0};
+        const int read = std::fscanf(file, "%31s", type);
+        std::fclose(file);
+        if (read != 1 || type[0] == 'I') continue; // Instruction cache
+        const size_t bytes = read_sysfs_cache(i);
+        switch (read_sysfs_int(i, "level")) {
+            case 1: info.l1d_bytes = bytes; break;
+            case 2: info.l2_bytes = bytes; break;
+            case 3: info.l3_bytes = bytes; break;
+            default: break;
+        }
+    }
+#endif
+    return info;
+}
+#endif
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+// The AVX2 kernels use FMA3 and (FP16 weights) F16C besides AVX2 itself.
+bool runs_avx2(const CpuFeatures& f) { return f.avx2 && f.fma && f.f16c; }
+// Ops without an AVX-512 kernel run their AVX2 kernel in this tier.
+bool runs_avx512(const CpuFeatures& f) { return runs_avx2(f) && f.avx512f; }
+#elif defined(VECTORIA_USE_ASM) && defined(__aarch64__)
+bool runs_neon(const CpuFeatures& f) { return f.neon; }
+#endif
+
+std::vector<KernelVariant> make_variants() {
+    std::vector<KernelVariant> variants;
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    variants.push_back({"AVX-512F", SimdTier::AVX512, runs_avx512});
+    variants.push_back({"AVX2", SimdTier::AVX2, runs_avx2});
+#elif defined(VECTORIA_USE_ASM) && defined(__aarch64__)
+    // SimdTier is x86_64-only; AVX2 means "no AVX-512" here.
+    variants.push_back({"NEON", SimdTier::AVX2, runs_neon});
+#endif
+    return variants;
+}
+
+} // namespace
+
+const CpuFeatures& host_cpu_features() {
+    static const CpuFeatures features = detect_features();
+    return features;
+}
+
+const CacheInfo& host_cache_info() {
+    static const CacheInfo info = detect_caches();
+    return info;
+}
+
+const std::vector<KernelVariant>& kernel_variants() {
+    static const std::vector<KernelVariant> variants = make_variants();
+    return variants;
+}
+
+bool host_has_avx512f() {
+    return host_cpu_features().avx512f;
+}
+
 SystemCapabilities get_system_capabilities() {
     SystemCapabilities caps;
     
@@ -23,16 +231,55 @@ SystemCapabilities get_system_capabilities() {
     caps.simd_compiled = false;
 #endif
 
-    // For now, we assume host support if compiled, 
-    // but a real implementation would check CPUID/hwcaps.
-    caps.simd_supported_on_host = caps.simd_compiled;
+    caps.features = host_cpu_features();
+    caps.caches = host_cache_info();
+    const CpuFeatures& f = caps.features;
+    const std::pair<bool, const char*> flags[] = {
+        {f.avx, "AVX"}, {f.avx2, "AVX2"}, {f.fma, "FMA"}, {f.f16c, "F16C"},
+        {f.avx512f, "AVX-512F"}, {f.avx512bw, "AVX-512BW"}, {f.avx512vl, "AVX-512VL"},
+        {f.avx512_vnni, "AVX-512 VNNI"}, {f.avx_vnni, "AVX-VNNI"},
+        {f.neon, "NEON"}, {f.neon_fp16, "NEON FP16"}, {f.neon_dotprod, "NEON DotProd"},
+    };
+    for (const auto& flag : flags) {
+        if (flag.first) caps.feature_names.push_back(flag.second);
+    }
+
+    caps.simd_supported_on_host = false;
+    caps.selected_variant = "Reference";
+    for (const KernelVariant& variant : kernel_variants()) {
+        if (variant.supported(f)) {
+            caps.simd_supported_on_host = true;
+            caps.selected_variant = variant.name;
+            break;
+        }
+    }
 
     caps.available_kernels.push_back("Reference");
-    if (caps.simd_compiled) {
+    if (caps.simd_supported_on_host) {
         if (caps.arch == Architecture::ARM64) {
             caps.available_kernels.push_back("NEON");
         } else if (caps.arch == Architecture::X86_64) {
             caps.available_kernels.push_back("AVX2");
+            // Polynomial Exp / Log (<= 1 ulp) and IEEE-exact Sqrt
+            caps.available_kernels.push_back("AVX2 Exp");
+            caps.available_kernels.push_back("AVX2 Log");
+            caps.available_kernels.push_back("AVX2 Sqrt");
+            // Column / row / scalar broadcast Add, Sub, Mul, Div and BiasAdd
+            caps.available_kernels.push_back("AVX2 Broadcast");
+            // 8x8 register-tile Transpose
+            caps.available_kernels.push_back("AVX2 Transpose");
+            // Row-wise LayerNorm (moments + apply)
+            caps.available_kernels.push_back("AVX2 LayerNorm");
+            // Tiled online-softmax Attention (no [T, T] scores)
+            caps.available_kernels.push_back("AVX2 Attention");
+            // Packed GEMM reading FP16 MatMul weights (F16C widening while packing)
+            caps.available_kernels.push_back("AVX2 GEMM FP16 Weights");
+            // INT8 QuantizedLinear (exact int32 sums, vpmaddwd)
+            caps.available_kernels.push_back("AVX2 Quantized Linear (INT8)");
+            if (caps.selected_variant == std::string("AVX-512F")) {
+                // 12x32 packed GEMM / FusedLinear, element-wise and reductions
+                caps.available_kernels.push_back("AVX-512F");
+            }
         }
     }
 
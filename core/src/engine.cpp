@@ -1,33 +1,32 @@
 #include "vectoria/engine.hpp"
-#include "vectoria/kernels.hpp"
-#include "vectoria/kernel_abi.hpp"
+#include "vectoria/exec_plan.hpp"
+#include "vectoria/simplify.hpp"
+#include "vectoria/plan_cache.hpp"
 #include <algorithm>
 #include <set>
 #include <stdexcept>
 #include <numeric>
 #include <cstring>
+#include <cstdio>
 
-extern "C" {
-#if defined(__aarch64__)
-    VectoriaStatus add_f32_neon(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus mul_f32_neon(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus sub_f32_neon(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus div_f32_neon(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus relu_f32_neon(const float* in, float* out, size_t count);
-    VectoriaStatus reduce_sum_f32_neon(const float* in, float* out, size_t outer, size_t inner);
-    VectoriaStatus reduce_max_f32_neon(const float* in, float* out, size_t outer, size_t inner);
-#elif defined(__x86_64__)
-    VectoriaStatus add_f32_avx2(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus mul_f32_avx2(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus sub_f32_avx2(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus div_f32_avx2(const float* a, const float* b, float* out, size_t count);
-    VectoriaStatus relu_f32_avx2(const float* in, float* out, size_t count);
-    VectoriaStatus reduce_sum_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
-    VectoriaStatus reduce_max_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
-#endif
+namespace vectoria {
+
+namespace {
+
+// EngineConfig fields that change the compiled plan (tracing does not).
+std::string config_key(const EngineConfig& config) {
+    std::string key = "|cfg:";
+    key += std::to_string(static_cast<int>(config.policy)) + "," +
+           std::to_string(static_cast<int>(config.simd_tier)) + "," +
+           std::to_string(static_cast<int>(config.mode)) + "," +
+           std::to_string(config.plan_memory) + std::to_string(config.alias_views) +
+           std::to_string(config.eliminate_dead_nodes) + std::to_string(config.optimize_graph) +
+           std::to_string(config.fold_transposes) + "," +
+           std::to_string(config.num_threads);
+    return key;
 }
 
-namespace vectoria {
+} // namespace
 
 Engine::Engine(const ir::Graph& graph, EngineConfig config) 
     : graph_(graph), config_(config) {}
@@ -71,10 +70,54 @@ void* Engine::get_buffer(size_t node_idx) const {
 }
 
 void Engine::compile() {
-    tracer_.clear();
+    compiled_ = false;
+    tracer_.configure(config_.trace_level, config_.trace_capacity, graph_.nodes.size(),
+                      config_.trace_retain_executions, config_.trace_sink);
+    active_level_ = config_.trace_level;
+    executions_ = 0;
     std::string mode_str = (config_.mode == ExecutionMode::Deployment) ? "Deployment" : "Research";
     tracer_.log(trace::EventType::GraphCompilation, -1, "Start | Mode: " + mode_str);
 
+    // A structurally identical graph compiled with the same config reuses
+    // the cached schedule, buffer layout and kernel selection.
+    std::string key;
+    uint64_t fingerprint = 0;
+    std::shared_ptr<const cache::CompiledPlan> cached;
+    compile_events_.clear();
+    if (config_.cache_plans) {
+        key = cache::structural_key(graph_) + config_key(config_);
+        fingerprint = cache::fingerprint(key);
+        cached = cache::PlanCache::global().find(fingerprint, key);
+    }
+
+    if (cached) {
+        restore_plan(*cached);
+    } else {
+        compile_graph();
+        if (config_.cache_plans) {
+            cache::PlanCache::global().insert(snapshot_plan(fingerprint, std::move(key)));
+            compile_events_.clear();
+        }
+    }
+
+    for (auto& step : plan_) {
+        if (!step.trace_tag.empty()) step.trace_detail = tracer_.intern(step.trace_tag);
+    }
+    if (config_.num_threads > 1 && (!pool_ || pool_->size() != config_.num_threads)) {
+        pool_ = std::make_unique<exec::ThreadPool>(config_.num_threads);
+    }
+
+    compiled_ = true;
+    tracer_.log(trace::EventType::GraphCompilation, -1, "End");
+    tracer_.publish();
+}
+
+void Engine::note(trace::EventType type, size_t node_id, const std::string& details) {
+    tracer_.log(type, node_id, details);
+    if (config_.cache_plans) compile_events_.push_back({type, node_id, details});
+}
+
+void Engine::compile_graph() {
     if (!validate()) {
         throw std::runtime_error("Graph validation failed");
     }
@@ -95,12 +138,19 @@ void Engine::compile() {
                     case ir::OpType::Div:
                     case ir::OpType::ReduceSum:
                     case ir::OpType::ReduceMax:
+                    case ir::OpType::ReduceMeanVar:
                     case ir::OpType::Sqrt:
                     case ir::OpType::Log:
                     case ir::OpType::Transpose:
                     case ir::OpType::Reshape:
                     case ir::OpType::Concat:
                     case ir::OpType::Slice:
+                    case ir::OpType::FusedLinear:
+                    case ir::OpType::BatchedMatMul:
+                    case ir::OpType::Softmax:
+                    case ir::OpType::LogSoftmax:
+                    case ir::OpType::LayerNorm:
+                    case ir::OpType::Attention:
                         supported = true;
                         break;
                     case ir::OpType::Exp:
@@ -120,26 +170,115 @@ void Engine::compile() {
                 }
                 
                 if (!supported) {
-                    tracer_.log(trace::EventType::GraphCompilation, node.id.index, "Unsupported Op for Deployment");
+                    note(trace::EventType::GraphCompilation, node.id.index, "Unsupported Op for Deployment");
                     throw std::runtime_error("Op not supported in Deployment Mode: " + std::to_string(static_cast<int>(op->op)));
                 }
             }
         }
     }
 
+    // The kernel variant is selected once from the host's CPU features;
+    // constant folding and the plan both use it.
+    const exec::KernelSelection kernels = exec::select_kernels(config_.policy, config_.simd_tier);
+    const KernelPolicy policy = kernels.policy;
+    const SimdTier tier = kernels.tier;
+    if (policy != config_.policy) {
+        note(trace::EventType::GraphCompilation, -1,
+             "Kernels | Fallback: Reference (host supports no compiled SIMD variant)");
+    }
+
+    // Optional simplification (constant folding, constant dedupe, CSE) and
+    // transpose folding work on a private copy of the graph; node ids do not
+    // change.
+    std::vector<size_t> canonical(graph_.nodes.size());
+    std::iota(canonical.begin(), canonical.end(), 0);
+    simplified_ = nullptr;
+    if (config_.optimize_graph) {
+        auto simplified = std::make_shared<ir::Graph>(graph_);
+        simplify::SimplifyResult result = simplify::simplify_graph(*simplified, policy, tier);
+        simplified_ = simplified;
+        for (size_t i : result.folded) {
+            note(trace::EventType::GraphCompilation, i, "Folded | Constant");
+        }
+        for (size_t i = 0; i < result.canonical.size(); ++i) {
+            if (result.canonical[i] != i) {
+                note(trace::EventType::GraphCompilation, i,
+                     "Merged | Into: " + std::to_string(result.canonical[i]));
+            }
+        }
+        canonical = std::move(result.canonical);
+    }
+    if (config_.fold_transposes) {
+        const ir::Graph& current = simplified_ ? *simplified_ : graph_;
+        std::vector<simplify::TransposeFold> folds = simplify::find_transpose_folds(current, policy);
+        if (!folds.empty()) {
+            auto folded = std::make_shared<ir::Graph>(current);
+            simplify::fold_transposes(*folded, folds);
+            simplified_ = folded;
+            for (const auto& fold : folds) {
+                note(trace::EventType::GraphCompilation, fold.matmul,
+                     std::string("Folded | Transpose: ") + std::to_string(fold.transpose) +
+                     (fold.operand == 0 ? " into A" : " into B"));
+            }
+        }
+    }
+    const ir::Graph& graph = compiled_graph();
+
+    // Dead node elimination: only ops that some declared output depends on
+    // are scheduled. Inputs are indexed below their consumers (validate()),
+    // so one reverse sweep marks everything reachable. Inputs and parameters
+    // always stay allocated because callers fill them by node id.
+    std::vector<bool> live(graph.nodes.size(), true);
+    if (config_.eliminate_dead_nodes && !graph.outputs.empty()) {
+        std::fill(live.begin(), live.end(), false);
+        for (const auto& out : graph.outputs) {
+            if (out.index < live.size()) live[canonical[out.index]] = true;
+        }
+        for (size_t i = graph.nodes.size(); i-- > 0;) {
+            const auto& data = graph.nodes[i].data;
+            if (std::holds_alternative<ir::InputNode>(data) || std::holds_alternative<ir::ParameterNode>(data)) {
+                live[i] = true;
+                continue;
+            }
+            auto* op = std::get_if<ir::OpNode>(&data);
+            if (!op || !live[i]) continue;
+            for (const auto& in : op->inputs) live[in.index] = true;
+        }
+    }
+    // Merged nodes never run; they share their canonical node's buffer.
+    for (size_t i = 0; i < live.size(); ++i) {
+        if (canonical[i] != i) live[i] = false;
+    }
+
     schedule_.clear();
-    for (size_t i = 0; i < graph_.nodes.size(); ++i) {
-        schedule_.push_back(i);
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        if (live[i]) {
+            schedule_.push_back(i);
+        } else if (canonical[i] == i) {
+            note(trace::EventType::GraphCompilation, i, "Pruned | Unreachable from outputs");
+        }
     }
     
     arena_.reset();
-    node_buffers_.resize(graph_.nodes.size());
+    node_buffers_.assign(graph.nodes.size(), nullptr);
+
+    // Static memory planning: every buffer lives from the step that writes it
+    // to the last step that reads it. Buffers with disjoint lifetimes share
+    // memory inside one slab.
+    std::vector<size_t> position(graph.nodes.size());
+    for (size_t s = 0; s < schedule_.size(); ++s) {
+        position[schedule_[s]] = s;
+    }
 
-    for (size_t i = 0; i < graph_.nodes.size(); ++i) {
-        const auto& node = graph_.nodes[i];
+    std::vector<memory::BufferLifetime> lifetimes(graph.nodes.size());
+    std::vector<ir::TensorShape> shapes(graph.nodes.size());
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        if (!live[i]) continue; // Pruned: no buffer, no step.
+        const auto& node = graph.nodes[i];
         
         ir::TensorShape shape;
         ir::DataType dtype;
+        bool is_op = false;
 
         if (auto* input = std::get_if<ir::InputNode>(&node.data)) {
             shape = input->shape;
@@ -153,502 +292,324 @@ void Engine::compile() {
         } else if (auto* op = std::get_if<ir::OpNode>(&node.data)) {
             shape = op->output_shape;
             dtype = op->output_dtype;
+            is_op = true;
+            for (const auto& in : op->inputs) {
+                auto& lt = lifetimes[in.index];
+                lt.last_use = std::max(lt.last_use, position[i]);
+            }
         } else {
              continue; 
         }
 
-        size_t size = calculate_size_bytes(shape, dtype);
-        node_buffers_[i] = arena_.allocate(size, 64);
-        tracer_.log(trace::EventType::MemoryAllocation, i, std::to_string(size) + " bytes");
+        shapes[i] = shape;
+        auto& lt = lifetimes[i];
+        lt.size = calculate_size_bytes(shape, dtype);
+        lt.first_use = position[i];
+        lt.last_use = std::max(lt.last_use, position[i]);
+        // Inputs, parameters and constants are written outside execute() and must persist.
+        lt.pinned = !is_op;
+    }
 
-        if (auto* c = std::get_if<ir::ConstantNode>(&node.data)) {
-            // Initialize constant memory immediately
-            if (dtype == ir::DataType::Float32 && !c->data_f32.empty()) {
-                // Verify size match (basic check)
-                if (c->data_f32.size() * sizeof(float) <= size) {
-                     std::memcpy(node_buffers_[i], c->data_f32.data(), c->data_f32.size() * sizeof(float));
-                }
+    // Without declared outputs every node is potentially observed by the caller.
+    bool pin_all = !config_.plan_memory || graph.outputs.empty();
+    for (size_t i = 0; i < lifetimes.size(); ++i) {
+        if (pin_all) lifetimes[i].pinned = true;
+    }
+    for (const auto& out : graph.outputs) {
+        if (out.index < lifetimes.size()) lifetimes[canonical[out.index]].pinned = true;
+    }
+
+    // Zero-copy views: Reshape keeps the linear element order and a Slice with
+    // no non-unit dims before its axis is one contiguous range, so both can
+    // point into their producer's storage. The storage root must then stay
+    // live (and pinned) for as long as any view on it.
+    alias_of_.assign(graph.nodes.size(), -1);
+    std::vector<size_t> storage_root(graph.nodes.size());
+    std::vector<size_t> view_offset(graph.nodes.size(), 0);
+    std::iota(storage_root.begin(), storage_root.end(), 0);
+
+    if (config_.alias_views) {
+        for (size_t node_idx : schedule_) {
+            auto* op = std::get_if<ir::OpNode>(&graph.nodes[node_idx].data);
+            if (!op || op->inputs.size() != 1 || op->output_dtype != ir::DataType::Float32) continue;
+
+            size_t src = op->inputs[0].index;
+            size_t byte_offset = 0;
+            if (op->op == ir::OpType::Reshape) {
+                if (lifetimes[src].size != lifetimes[node_idx].size) continue;
+            } else if (op->op == ir::OpType::Slice) {
+                if (op->int_params.size() != 3) continue;
+                const auto& dims = shapes[src].dims;
+                int64_t axis = op->int_params[0];
+                if (axis < 0 || axis >= static_cast<int64_t>(dims.size())) continue;
+
+                size_t outer = 1;
+                for (int64_t d = 0; d < axis; ++d) outer *= dims[d];
+                if (outer != 1) continue;
+
+                size_t inner = 1;
+                for (size_t d = axis + 1; d < dims.size(); ++d) inner *= dims[d];
+                byte_offset = static_cast<size_t>(op->int_params[1]) * inner * sizeof(float);
+            } else {
+                continue;
             }
+
+            alias_of_[node_idx] = static_cast<int64_t>(src);
+            storage_root[node_idx] = storage_root[src];
+            view_offset[node_idx] = view_offset[src] + byte_offset;
+
+            auto& root = lifetimes[storage_root[node_idx]];
+            root.last_use = std::max(root.last_use, lifetimes[node_idx].last_use);
+            root.pinned = root.pinned || lifetimes[node_idx].pinned;
         }
     }
 
-    compiled_ = true;
-    tracer_.log(trace::EventType::GraphCompilation, -1, "End");
+    // Views own no storage of their own.
+    std::vector<memory::BufferLifetime> requests = lifetimes;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (alias_of_[i] >= 0) requests[i].size = 0;
+    }
+
+    memory_plan_ = memory::plan_memory(requests, 64);
+    slab_ = static_cast<uint8_t*>(arena_.allocate(memory_plan_.peak_bytes, 64));
+
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        size_t size = lifetimes[i].size;
+        if (size == 0) continue;
+
+        if (alias_of_[i] >= 0) {
+            node_buffers_[i] = slab_ + memory_plan_.offsets[storage_root[i]] + view_offset[i];
+            note(trace::EventType::MemoryAllocation, i,
+                 "Alias of node " + std::to_string(alias_of_[i]) +
+                 " | Root: " + std::to_string(storage_root[i]) +
+                 " + " + std::to_string(view_offset[i]) + " bytes");
+            continue;
+        }
+
+        node_buffers_[i] = slab_ + memory_plan_.offsets[i];
+        note(trace::EventType::MemoryAllocation, i,
+             std::to_string(size) + " bytes @ offset " + std::to_string(memory_plan_.offsets[i]));
+    }
+
+    for (size_t i = 0; i < canonical.size(); ++i) {
+        if (canonical[i] != i) node_buffers_[i] = node_buffers_[canonical[i]];
+    }
+    load_constants();
+
+    note(trace::EventType::MemoryAllocation, -1,
+         "Plan | Peak: " + std::to_string(memory_plan_.peak_bytes) +
+         " bytes | Naive: " + std::to_string(memory_plan_.naive_bytes) + " bytes");
+
+    // Resolve kernels, extents and trace tags once; execute() only walks the plan.
+    plan_ = exec::build_exec_plan(graph, schedule_, node_buffers_, alias_of_, policy,
+                                    config_.num_threads, tier);
+
+    if (config_.num_threads > 1) {
+        build_dependencies(requests, storage_root);
+        note(trace::EventType::GraphCompilation, -1,
+             "Parallel | Threads: " + std::to_string(config_.num_threads));
+    }
+
 }
 
-void Engine::execute() {
-    if (!compiled_) {
-        throw std::runtime_error("Engine must be compiled before execution");
+void Engine::load_constants() {
+    const ir::Graph& graph = compiled_graph();
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        auto* c = std::get_if<ir::ConstantNode>(&graph.nodes[i].data);
+        if (!c || !node_buffers_[i]) continue;
+        // Initialize constant memory immediately
+        if (c->dtype == ir::DataType::Float32 && !c->data_f32.empty()) {
+            // Verify size match (basic check)
+            if (c->data_f32.size() * sizeof(float) <= calculate_size_bytes(c->shape, c->dtype)) {
+                 std::memcpy(node_buffers_[i], c->data_f32.data(), c->data_f32.size() * sizeof(float));
+            }
+        }
     }
+}
 
-    auto get_shape = [&](size_t idx) -> ir::TensorShape {
-        const auto& n = graph_.nodes[idx];
-        if (auto* i = std::get_if<ir::InputNode>(&n.data)) return i->shape;
-        if (auto* p = std::get_if<ir::ParameterNode>(&n.data)) return p->shape;
-        if (auto* c = std::get_if<ir::ConstantNode>(&n.data)) return c->shape;
-        if (auto* o = std::get_if<ir::OpNode>(&n.data)) return o->output_shape;
-        return {};
-    };
+std::shared_ptr<const cache::CompiledPlan> Engine::snapshot_plan(uint64_t fingerprint, std::string key) const {
+    auto plan = std::make_shared<cache::CompiledPlan>();
+    plan->fingerprint = fingerprint;
+    plan->key = std::move(key);
+    plan->graph = simplified_;
+    plan->schedule = schedule_;
+    plan->alias_of = alias_of_;
+    plan->memory = memory_plan_;
+    plan->buffer_offsets.assign(node_buffers_.size(), cache::CompiledPlan::kNoBuffer);
+    for (size_t i = 0; i < node_buffers_.size(); ++i) {
+        if (node_buffers_[i]) plan->buffer_offsets[i] = static_cast<uint8_t*>(node_buffers_[i]) - slab_;
+    }
+    plan->steps = plan_;
+    plan->slab_base = reinterpret_cast<uintptr_t>(slab_);
+    plan->successors = successors_;
+    plan->dependency_counts = dependency_counts_;
+    plan->events = compile_events_;
+    return plan;
+}
 
-    for (size_t node_idx : schedule_) {
-        const auto& node = graph_.nodes[node_idx];
-        tracer_.log(trace::EventType::NodeExecutionStart, node_idx);
-        
-        if (auto* op = std::get_if<ir::OpNode>(&node.data)) {
-            if (op->op == ir::OpType::MatMul) {
-                if (op->inputs.size() != 2) throw std::runtime_error("MatMul requires 2 inputs");
-                
-                size_t input_a_idx = op->inputs[0].index;
-                size_t input_b_idx = op->inputs[1].index;
-                
-                const float* a_ptr = static_cast<const float*>(node_buffers_[input_a_idx]);
-                const float* b_ptr = static_cast<const float*>(node_buffers_[input_b_idx]);
-                float* c_ptr = static_cast<float*>(node_buffers_[node_idx]);
+void Engine::restore_plan(const cache::CompiledPlan& plan) {
+    simplified_ = plan.graph;
+    for (const auto& ev : plan.events) tracer_.log(ev.type, ev.node_id, ev.details);
 
-                ir::TensorShape shape_a = get_shape(input_a_idx);
-                ir::TensorShape shape_b = get_shape(input_b_idx);
+    schedule_ = plan.schedule;
+    alias_of_ = plan.alias_of;
+    memory_plan_ = plan.memory;
 
-                if (shape_a.dims.size() != 2 || shape_b.dims.size() != 2) {
-                     throw std::runtime_error("MatMul supports only 2D tensors for now");
-                }
+    arena_.reset();
+    slab_ = static_cast<uint8_t*>(arena_.allocate(memory_plan_.peak_bytes, 64));
+    node_buffers_.assign(plan.buffer_offsets.size(), nullptr);
+    for (size_t i = 0; i < node_buffers_.size(); ++i) {
+        if (plan.buffer_offsets[i] != cache::CompiledPlan::kNoBuffer) node_buffers_[i] = slab_ + plan.buffer_offsets[i];
+    }
+    load_constants();
 
-                size_t m = shape_a.dims[0];
-                size_t k = shape_a.dims[1];
-                size_t n = shape_b.dims[1];
-                
-                if (shape_b.dims[0] != static_cast<int64_t>(k)) {
-                     throw std::runtime_error("MatMul dimension mismatch");
-                }
+    plan_ = plan.rebase_steps(slab_);
+    if (config_.num_threads > 1) {
+        successors_ = plan.successors;
+        dependency_counts_ = plan.dependency_counts;
+        pending_dependencies_ = std::make_unique<std::atomic<uint32_t>[]>(plan_.size());
+    }
 
-                bool executed = false;
-
-                if (config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    VectoriaStatus status = gemm_f32_neon(
-                        a_ptr, b_ptr, c_ptr, m, n, k, k, n, n, 1.0f, 0.0f
-                    );
-                    if (status != VECTORIA_SUCCESS) throw std::runtime_error("ASM kernel failed");
-                    executed = true;
-    #elif defined(__x86_64__)
-                    VectoriaStatus status = gemm_f32_avx2(
-                        a_ptr, b_ptr, c_ptr, m, n, k, k, n, n, 1.0f, 0.0f
-                    );
-                    if (status != VECTORIA_SUCCESS) throw std::runtime_error("ASM kernel failed");
-                    executed = true;
-    #else
-                    throw std::runtime_error("SIMD policy requested but architecture not supported");
-    #endif
-#else
-                    throw std::runtime_error("SIMD policy requested but VECTORIA_USE_ASM not defined");
-#endif
-                }
+    char hex[19];
+    std::snprintf(hex, sizeof(hex), "0x%016llx", static_cast<unsigned long long>(plan.fingerprint));
+    tracer_.log(trace::EventType::GraphCompilation, -1, std::string("Cached | Fingerprint: ") + hex);
+}
 
-                if (!executed) {
-                    kernels::reference::gemm_f32(
-                        a_ptr, b_ptr, c_ptr,
-                        m, n, k,
-                        k, n, n,
-                        1.0f, 0.0f
-                    );
-                }
-                
-                std::string mode = executed ? "SIMD" : "Reference";
-                #if defined(__aarch64__)
-                    if (executed) mode += " [ARM64]";
-                #elif defined(__x86_64__)
-                    if (executed) mode += " [x86_64]";
-                #endif
-                mode += " | Inputs: [" + std::to_string(input_a_idx) + ", " + std::to_string(input_b_idx) + "]";
-                
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, mode);
+void Engine::build_dependencies(const std::vector<memory::BufferLifetime>& requests,
+                                const std::vector<size_t>& storage_root) {
+    const ir::Graph& graph = compiled_graph();
+    size_t n = schedule_.size();
+    std::vector<size_t> position(graph.nodes.size());
+    for (size_t s = 0; s < n; ++s) position[schedule_[s]] = s;
+
+    successors_.assign(n, {});
+
+    // Every step that reads a storage root, directly or through a view.
+    std::vector<std::vector<size_t>> readers(graph.nodes.size());
+    for (size_t s = 0; s < n; ++s) {
+        if (auto* op = std::get_if<ir::OpNode>(&graph.nodes[schedule_[s]].data)) {
+            for (const auto& in : op->inputs) {
+                successors_[position[in.index]].push_back(s);
+                readers[storage_root[in.index]].push_back(s);
             }
-            else if (op->op == ir::OpType::BiasAdd) {
-                if (op->inputs.size() != 2) throw std::runtime_error("BiasAdd requires 2 inputs");
-                size_t input_idx = op->inputs[0].index;
-                size_t bias_idx = op->inputs[1].index;
-                
-                const float* in_ptr = static_cast<const float*>(node_buffers_[input_idx]);
-                const float* bias_ptr = static_cast<const float*>(node_buffers_[bias_idx]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape shape_in = get_shape(input_idx);
-                // Assume 2D [M, N]
-                size_t m = shape_in.dims[0];
-                size_t n = shape_in.dims[1];
-                
-                // Dispatch (Reference only for now)
-                kernels::reference::bias_add_f32(in_ptr, bias_ptr, out_ptr, m, n);
-                
-                std::string mode = "Reference | Inputs: [" + std::to_string(input_idx) + ", " + std::to_string(bias_idx) + "]";
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, mode);
-            }
-            else if (op->op == ir::OpType::Relu) {
-                if (op->inputs.size() != 1) throw std::runtime_error("Relu requires 1 input");
-                size_t input_idx = op->inputs[0].index;
-                
-                const float* in_ptr = static_cast<const float*>(node_buffers_[input_idx]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape shape_in = get_shape(input_idx);
-                size_t count = 1;
-                for(auto d : shape_in.dims) count *= d;
-                
-                bool executed = false;
-                if (config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (relu_f32_neon(in_ptr, out_ptr, count) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (relu_f32_avx2(in_ptr, out_ptr, count) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+        }
+    }
 
-                if (!executed) {
-                    kernels::reference::relu_f32(in_ptr, out_ptr, count);
-                }
-                
-                std::string mode = executed ? "SIMD" : "Reference";
-                #if defined(__aarch64__)
-                    if (executed) mode += " [ARM64]";
-                #elif defined(__x86_64__)
-                    if (executed) mode += " [x86_64]";
-                #endif
-                mode += " | Inputs: [" + std::to_string(input_idx) + "]";
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, mode);
+    // Planned buffer reuse: a step that writes memory previously owned by
+    // another buffer must wait for that buffer's producer and all its readers.
+    // The serial schedule orders these implicitly; the parallel one must not
+    // lose that ordering (write-after-read / write-after-write).
+    for (size_t sb = 0; sb < n; ++sb) {
+        size_t b = schedule_[sb];
+        if (requests[b].size == 0 || requests[b].pinned) continue;
+        size_t b_begin = memory_plan_.offsets[b];
+        size_t b_end = b_begin + requests[b].size;
+
+        for (size_t sa = 0; sa < sb; ++sa) {
+            size_t a = schedule_[sa];
+            if (requests[a].size == 0 || requests[a].pinned) continue;
+            size_t a_begin = memory_plan_.offsets[a];
+            size_t a_end = a_begin + requests[a].size;
+            if (a_begin >= b_end || b_begin >= a_end) continue;
+
+            successors_[sa].push_back(sb);
+            for (size_t reader : readers[a]) {
+                if (reader < sb) successors_[reader].push_back(sb);
             }
-            else if (op->op == ir::OpType::Add) {
-                if (op->inputs.size() != 2) throw std::runtime_error("Add requires 2 inputs");
-                size_t idx_a = op->inputs[0].index;
-                size_t idx_b = op->inputs[1].index;
-                
-                const float* a_ptr = static_cast<const float*>(node_buffers_[idx_a]);
-                const float* b_ptr = static_cast<const float*>(node_buffers_[idx_b]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape s = get_shape(idx_a);
-                size_t count_a = 1; for(auto d : get_shape(idx_a).dims) count_a *= d;
-                size_t count_b = 1; for(auto d : get_shape(idx_b).dims) count_b *= d;
-                
-                bool executed = false;
-                if (count_a == count_b && config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (add_f32_neon(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (add_f32_avx2(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+        }
+    }
 
-                if (!executed) {
-                    if (count_a == count_b) {
-                        kernels::reference::add_f32(a_ptr, b_ptr, out_ptr, count_a);
-                    } else {
-                        // Broadcast logic matching Sub/Div
-                        // Supports Col-vector broadcast (A[i,j] + B[i])
-                        // Or Scalar broadcast (B[0]) if outer=1
-                        
-                        // Check divisibility
-                        if (count_b == 0) throw std::runtime_error("Add broadcast div by zero");
-                        if (count_a % count_b != 0) throw std::runtime_error("Add broadcast shape mismatch");
-
-                        size_t outer = count_b;
-                        size_t inner = count_a / count_b;
-                        kernels::reference::add_broadcast_f32(a_ptr, b_ptr, out_ptr, outer, inner);
-                    }
-                }
-                
-                std::string mode = executed ? "SIMD" : "Reference";
-                #if defined(__aarch64__)
-                    if (executed) mode += " [ARM64]";
-                #elif defined(__x86_64__)
-                    if (executed) mode += " [x86_64]";
-                #endif
-                mode += " | Inputs: [" + std::to_string(idx_a) + ", " + std::to_string(idx_b) + "]";
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, mode);
-            }
-            else if (op->op == ir::OpType::Mul) {
-                if (op->inputs.size() != 2) throw std::runtime_error("Mul requires 2 inputs");
-                size_t idx_a = op->inputs[0].index;
-                size_t idx_b = op->inputs[1].index;
-                
-                const float* a_ptr = static_cast<const float*>(node_buffers_[idx_a]);
-                const float* b_ptr = static_cast<const float*>(node_buffers_[idx_b]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape shape_a = get_shape(idx_a);
-                ir::TensorShape shape_b = get_shape(idx_b);
-                
-                size_t count_a = 1; for(auto d : shape_a.dims) count_a *= d;
-                size_t count_b = 1; for(auto d : shape_b.dims) count_b *= d;
-                
-                bool executed = false;
-                if (count_a == count_b && config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (mul_f32_neon(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (mul_f32_avx2(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+    dependency_counts_.assign(n, 0);
+    for (auto& succ : successors_) {
+        std::sort(succ.begin(), succ.end());
+        succ.erase(std::unique(succ.begin(), succ.end()), succ.end());
+        for (size_t s : succ) dependency_counts_[s]++;
+    }
+    pending_dependencies_ = std::make_unique<std::atomic<uint32_t>[]>(n);
+}
 
-                if (!executed) {
-                    if (count_a == count_b) {
-                        kernels::reference::mul_f32(a_ptr, b_ptr, out_ptr, count_a);
-                    } else {
-                         // Attempt Broadcast: A [Outer, Inner] * B [Inner]
-                         // Also support scalar broadcast if count_b == 1
-                         
-                         bool is_scalar_b = (count_b == 1);
-                         if (!is_scalar_b && (shape_a.dims.empty() || shape_b.dims.empty())) {
-                             throw std::runtime_error("Mul broadcast requires rank >= 1 (unless scalar)");
-                         }
-                         
-                         size_t inner_a = shape_a.dims.empty() ? 1 : shape_a.dims.back();
-                         size_t outer_a = count_a / inner_a;
-                         
-                         // We support B being [Inner] (rank 1) or [1, Inner] (rank 2) but effectively matching last dim
-                         // Check total elements of B equals inner dimension of A
-                         if (count_b == inner_a) {
-                             kernels::reference::mul_broadcast_f32(a_ptr, b_ptr, out_ptr, outer_a, inner_a);
-                         } else if (is_scalar_b) {
-                             // Scalar broadcast: treat as [count_a, 1] * [1]
-                             // mul_broadcast_f32 logic: out[i*1 + 0] = a[i] * b[0]
-                             // This iterates i from 0 to count_a
-                             kernels::reference::mul_broadcast_f32(a_ptr, b_ptr, out_ptr, count_a, 1);
-                         } else {
-                             throw std::runtime_error("Mul broadcast shape mismatch: Expected B size " + std::to_string(inner_a) + " or 1, but got " + std::to_string(count_b));
-                         }
-                    }
-                }
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, (executed ? "SIMD" : "Reference") + std::string(" | Inputs: [...]"));
-            }
-            else if (op->op == ir::OpType::ReduceSum) {
-                if (op->inputs.size() != 1) throw std::runtime_error("ReduceSum requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape s = get_shape(idx_in);
-                if (s.dims.empty()) throw std::runtime_error("ReduceSum input must have at least 1 dim");
-                
-                size_t inner = s.dims.back();
-                size_t outer = 1;
-                for(size_t i=0; i<s.dims.size()-1; ++i) outer *= s.dims[i];
-                
-                bool executed = false;
-                if (config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (reduce_sum_f32_neon(in_ptr, out_ptr, outer, inner) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (reduce_sum_f32_avx2(in_ptr, out_ptr, outer, inner) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+void Engine::run_step(const exec::ExecStep& step, size_t worker) {
+    const trace::TraceLevel level = active_level_;
+    if (level == trace::TraceLevel::Off) {
+        if (step.fn) step.fn(step, {pool_.get(), worker});
+        return;
+    }
 
-                if (!executed) {
-                    kernels::reference::reduce_sum_f32(in_ptr, out_ptr, outer, inner);
-                }
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, (executed ? "SIMD" : "Reference") + std::string(" | Inputs: [...]"));
-            }
-            else if (op->op == ir::OpType::ReduceMax) {
-                if (op->inputs.size() != 1) throw std::runtime_error("ReduceMax requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape s = get_shape(idx_in);
-                if (s.dims.empty()) throw std::runtime_error("ReduceMax input must have at least 1 dim");
-                
-                size_t inner = s.dims.back();
-                size_t outer = 1;
-                for(size_t i=0; i<s.dims.size()-1; ++i) outer *= s.dims[i];
-                
-                bool executed = false;
-                if (config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (reduce_max_f32_neon(in_ptr, out_ptr, outer, inner) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (reduce_max_f32_avx2(in_ptr, out_ptr, outer, inner) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+    const bool full = (level == trace::TraceLevel::Full);
+    uint64_t start = trace::now_ns();
+    if (full) tracer_.record(trace::EventType::NodeExecutionStart, start, step.node_id, 0, worker);
+    if (step.fn) step.fn(step, {pool_.get(), worker});
+    uint64_t end = trace::now_ns();
+    if (full) {
+        if (!step.trace_tag.empty()) {
+            tracer_.record(trace::EventType::KernelDispatch, end, step.node_id, step.trace_detail, worker);
+        }
+        tracer_.record(trace::EventType::NodeExecutionEnd, end, step.node_id, 0, worker);
+    }
+    tracer_.count(step.node_id, end - start);
+}
 
-                if (!executed) {
-                    kernels::reference::reduce_max_f32(in_ptr, out_ptr, outer, inner);
-                }
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, (executed ? "SIMD" : "Reference") + std::string(" | Inputs: [...]"));
-            }
-            else if (op->op == ir::OpType::Exp) {
-                // Exp remains reference only
-                size_t idx_in = op->inputs[0].index;
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                ir::TensorShape s = get_shape(idx_in);
-                size_t count = 1; for(auto d : s.dims) count *= d;
-                kernels::reference::exp_f32(in_ptr, out_ptr, count);
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, "Reference | Inputs: [...]");
-            }
-            else if (op->op == ir::OpType::Sqrt) {
-                if (op->inputs.size() != 1) throw std::runtime_error("Sqrt requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                ir::TensorShape s = get_shape(idx_in);
-                size_t count = 1; for(auto d : s.dims) count *= d;
-                kernels::reference::sqrt_f32(in_ptr, out_ptr, count);
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, "Reference | Inputs: [...]");
-            }
-            else if (op->op == ir::OpType::Log) {
-                if (op->inputs.size() != 1) throw std::runtime_error("Log requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                ir::TensorShape s = get_shape(idx_in);
-                size_t count = 1; for(auto d : s.dims) count *= d;
-                kernels::reference::log_f32(in_ptr, out_ptr, count);
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, "Reference | Inputs: [...]");
-            }
-            else if (op->op == ir::OpType::Sub) {
-                if (op->inputs.size() != 2) throw std::runtime_error("Sub requires 2 inputs");
-                size_t idx_a = op->inputs[0].index;
-                size_t idx_b = op->inputs[1].index;
-                
-                const float* a_ptr = static_cast<const float*>(node_buffers_[idx_a]);
-                const float* b_ptr = static_cast<const float*>(node_buffers_[idx_b]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape shape_a = get_shape(idx_a);
-                ir::TensorShape shape_b = get_shape(idx_b);
-                
-                size_t count_a = 1; for(auto d : shape_a.dims) count_a *= d;
-                size_t count_b = 1; for(auto d : shape_b.dims) count_b *= d;
-                
-                bool executed = false;
-                if (count_a == count_b && config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (sub_f32_neon(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (sub_f32_avx2(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+void Engine::run_step_task(void* ctx, size_t step_idx, size_t worker) {
+    Engine* self = static_cast<Engine*>(ctx);
+
+    // After a failure the remaining steps are drained without running kernels.
+    if (!self->failed_.load(std::memory_order_acquire)) {
+        try {
+            self->run_step(self->plan_[step_idx], worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(self->error_mutex_);
+            if (!self->error_) self->error_ = std::current_exception();
+            self->failed_.store(true, std::memory_order_release);
+        }
+    }
 
-                if (!executed) {
-                    if (count_a == count_b) {
-                        kernels::reference::sub_f32(a_ptr, b_ptr, out_ptr, count_a, count_b);
-                    } else {
-                        size_t outer = count_b;
-                        size_t inner = count_a / count_b;
-                        kernels::reference::sub_broadcast_f32(a_ptr, b_ptr, out_ptr, outer, inner);
-                    }
-                }
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, (executed ? "SIMD" : "Reference") + std::string(" | Inputs: [...]"));
-            }
-            else if (op->op == ir::OpType::Div) {
-                if (op->inputs.size() != 2) throw std::runtime_error("Div requires 2 inputs");
-                size_t idx_a = op->inputs[0].index;
-                size_t idx_b = op->inputs[1].index;
-                
-                const float* a_ptr = static_cast<const float*>(node_buffers_[idx_a]);
-                const float* b_ptr = static_cast<const float*>(node_buffers_[idx_b]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape shape_a = get_shape(idx_a);
-                ir::TensorShape shape_b = get_shape(idx_b);
-                
-                size_t count_a = 1; for(auto d : shape_a.dims) count_a *= d;
-                size_t count_b = 1; for(auto d : shape_b.dims) count_b *= d;
-                
-                bool executed = false;
-                if (count_a == count_b && config_.policy == KernelPolicy::SIMD) {
-#ifdef VECTORIA_USE_ASM
-    #if defined(__aarch64__)
-                    if (div_f32_neon(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #elif defined(__x86_64__)
-                    if (div_f32_avx2(a_ptr, b_ptr, out_ptr, count_a) == VECTORIA_SUCCESS) executed = true;
-    #endif
-#endif
-                }
+    // Release successors in reverse so the lowest step index is popped first (LIFO deque).
+    const auto& succ = self->successors_[step_idx];
+    for (auto it = succ.rbegin(); it != succ.rend(); ++it) {
+        if (self->pending_dependencies_[*it].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            self->pool_->push(worker, {&Engine::run_step_task, self, *it});
+        }
+    }
+    self->pool_->finish(self->steps_remaining_);
+}
 
-                if (!executed) {
-                    if (count_a == count_b) {
-                        kernels::reference::div_f32(a_ptr, b_ptr, out_ptr, count_a, count_b);
-                    } else {
-                        size_t outer = count_b;
-                        size_t inner = count_a / count_b;
-                        kernels::reference::div_broadcast_f32(a_ptr, b_ptr, out_ptr, outer, inner);
-                    }
-                }
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, (executed ? "SIMD" : "Reference") + std::string(" | Inputs: [...]"));
-            }
-            else if (op->op == ir::OpType::Reshape) {
-                if (op->inputs.size() != 1) throw std::runtime_error("Reshape requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape s = get_shape(idx_in);
-                size_t count = 1; for(auto d : s.dims) count *= d;
-                
-                // Pure copy for reference determinism (no aliasing)
-                std::memcpy(out_ptr, in_ptr, count * sizeof(float));
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, "Reference (Copy) | Inputs: [...]");
-            }
-            else if (op->op == ir::OpType::Transpose) {
-                if (op->inputs.size() != 1) throw std::runtime_error("Transpose requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape s = get_shape(idx_in);
-                const auto& perm = op->int_params;
-                
-                kernels::reference::transpose_f32(in_ptr, out_ptr, s.dims, perm);
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, "Reference | Inputs: [...]");
-            }
-            else if (op->op == ir::OpType::Concat) {
-                std::vector<const float*> input_ptrs;
-                std::vector<std::vector<int64_t>> input_shapes;
-                
-                for(auto inp : op->inputs) {
-                    input_ptrs.push_back(static_cast<const float*>(node_buffers_[inp.index]));
-                    input_shapes.push_back(get_shape(inp.index).dims);
-                }
-                
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                int64_t axis = op->int_params[0];
-                
-                kernels::reference::concat_f32(input_ptrs, out_ptr, input_shapes, axis);
-                
-                std::string mode = "Reference | Axis: " + std::to_string(axis);
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, mode);
-            }
-            else if (op->op == ir::OpType::Slice) {
-                if (op->inputs.size() != 1) throw std::runtime_error("Slice requires 1 input");
-                size_t idx_in = op->inputs[0].index;
-                const float* in_ptr = static_cast<const float*>(node_buffers_[idx_in]);
-                float* out_ptr = static_cast<float*>(node_buffers_[node_idx]);
-                
-                ir::TensorShape s = get_shape(idx_in);
-                int64_t axis = op->int_params[0];
-                int64_t start = op->int_params[1];
-                int64_t end = op->int_params[2];
-                
-                kernels::reference::slice_f32(in_ptr, out_ptr, s.dims, axis, start, end);
-                tracer_.log(trace::EventType::KernelDispatch, node_idx, "Reference | Axis: " + std::to_string(axis));
-            }
+void Engine::execute_parallel() {
+    size_t n = plan_.size();
+    for (size_t s = 0; s < n; ++s) {
+        pending_dependencies_[s].store(dependency_counts_[s], std::memory_order_relaxed);
+    }
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+    steps_remaining_.store(n, std::memory_order_release);
+
+    for (size_t s = n; s-- > 0;) {
+        if (dependency_counts_[s] == 0) pool_->push(0, {&Engine::run_step_task, this, s});
+    }
+    pool_->help_until(0, steps_remaining_);
+
+    if (error_) std::rethrow_exception(error_);
+}
+
+void Engine::execute() {
+    if (!compiled_) {
+        throw std::runtime_error("Engine must be compiled before execution");
+    }
+
+    // Unsampled executions keep the counters but skip the event ring.
+    active_level_ = config_.trace_level;
+    bool sampled = (executions_++ % std::max<size_t>(config_.trace_sample_every, 1)) == 0;
+    if (active_level_ == trace::TraceLevel::Full && !sampled) active_level_ = trace::TraceLevel::Counters;
+    if (active_level_ == trace::TraceLevel::Full) tracer_.begin_execution();
+
+    if (pool_ && config_.num_threads > 1 && !plan_.empty()) {
+        execute_parallel();
+    } else {
+        for (const auto& step : plan_) {
+            run_step(step, 0);
         }
-        tracer_.log(trace::EventType::NodeExecutionEnd, node_idx);
     }
+
+    if (active_level_ == trace::TraceLevel::Full) tracer_.publish();
 }
 
-} // namespace vectoria
\ No newline at end of file
+} // namespace vectoria
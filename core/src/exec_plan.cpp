@@ -0,0 +1,1048 @@
+#include "vectoria/exec_plan.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/capabilities.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+extern "C" {
+#if defined(__aarch64__)
+    VectoriaStatus add_f32_neon(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus mul_f32_neon(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus sub_f32_neon(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus div_f32_neon(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus relu_f32_neon(const float* in, float* out, size_t count);
+    VectoriaStatus reduce_sum_f32_neon(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus reduce_max_f32_neon(const float* in, float* out, size_t outer, size_t inner);
+#elif defined(__x86_64__)
+    VectoriaStatus add_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus mul_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus sub_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus div_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus relu_f32_avx2(const float* in, float* out, size_t count);
+    VectoriaStatus reduce_sum_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus reduce_max_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus exp_f32_avx2(const float* in, float* out, size_t count);
+    VectoriaStatus log_f32_avx2(const float* in, float* out, size_t count);
+    VectoriaStatus sqrt_f32_avx2(const float* in, float* out, size_t count);
+#endif
+}
+
+#if defined(VECTORIA_USE_ASM) && defined(__aarch64__)
+    #define VECTORIA_HAS_ASM_KERNELS 1
+    #define VECTORIA_SIMD_KERNEL(name) name##_neon
+    #define VECTORIA_SIMD_GEMM gemm_f32_neon
+    #define VECTORIA_SIMD_LINEAR linear_f32_neon
+    #define VECTORIA_SIMD_TAG "SIMD [ARM64]"
+    #define VECTORIA_HAS_SIMD_GEMM_TRANS 0
+    #define VECTORIA_HAS_SIMD_GEMM_F16W 0
+    #define VECTORIA_HAS_SIMD_LINEAR_S8 0
+    #define VECTORIA_HAS_SIMD_TRANSCENDENTALS 0
+    #define VECTORIA_HAS_SIMD_BROADCAST 0
+    #define VECTORIA_HAS_SIMD_TRANSPOSE 0
+    #define VECTORIA_HAS_SIMD_LAYERNORM 0
+    #define VECTORIA_HAS_SIMD_ATTENTION 0
+    #define VECTORIA_HAS_SIMD_REDUCE_AXIS 0
+    #define VECTORIA_HAS_SIMD_AVX512 0
+#elif defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    #define VECTORIA_HAS_ASM_KERNELS 1
+    #define VECTORIA_SIMD_KERNEL(name) name##_avx2
+    #define VECTORIA_SIMD_GEMM gemm_f32_avx2_packed
+    #define VECTORIA_SIMD_LINEAR linear_f32_avx2
+    #define VECTORIA_SIMD_GEMM_TRANS gemm_trans_f32_avx2_packed
+    #define VECTORIA_SIMD_GEMM_F16W gemm_f16w_f32_avx2_packed
+    #define VECTORIA_SIMD_LINEAR_S8 linear_s8_f32_avx2
+    #define VECTORIA_SIMD_TAG "SIMD [x86_64]"
+    #define VECTORIA_HAS_SIMD_GEMM_TRANS 1
+    #define VECTORIA_HAS_SIMD_GEMM_F16W 1
+    #define VECTORIA_HAS_SIMD_LINEAR_S8 1
+    #define VECTORIA_HAS_SIMD_TRANSCENDENTALS 1
+    #define VECTORIA_HAS_SIMD_BROADCAST 1
+    #define VECTORIA_HAS_SIMD_TRANSPOSE 1
+    #define VECTORIA_HAS_SIMD_LAYERNORM 1
+    #define VECTORIA_HAS_SIMD_ATTENTION 1
+    #define VECTORIA_HAS_SIMD_REDUCE_AXIS 1
+    #define VECTORIA_HAS_SIMD_AVX512 1
+    #define VECTORIA_SIMD_TAG_AVX512 "SIMD [x86_64-AVX512]"
+#else
+    #define VECTORIA_HAS_ASM_KERNELS 0
+    #define VECTORIA_HAS_SIMD_GEMM_TRANS 0
+    #define VECTORIA_HAS_SIMD_GEMM_F16W 0
+    #define VECTORIA_HAS_SIMD_LINEAR_S8 0
+    #define VECTORIA_HAS_SIMD_TRANSCENDENTALS 0
+    #define VECTORIA_HAS_SIMD_BROADCAST 0
+    #define VECTORIA_HAS_SIMD_TRANSPOSE 0
+    #define VECTORIA_HAS_SIMD_LAYERNORM 0
+    #define VECTORIA_HAS_SIMD_ATTENTION 0
+    #define VECTORIA_HAS_SIMD_REDUCE_AXIS 0
+    #define VECTORIA_HAS_SIMD_AVX512 0
+    #define VECTORIA_SIMD_TAG "SIMD"
+#endif
+
+namespace vectoria {
+namespace exec {
+
+namespace {
+
+using namespace kernels::reference;
+
+// --- Reference steps ---
+
+void run_gemm_ref(const ExecStep& s, const ExecContext&) {
+    gemm_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n, s.k, s.k, s.n, s.n, 1.0f, 0.0f);
+}
+
+// Row strides of the stored MatMul operands: A is [m, k] or [k, m], B is
+// [k, n] or [n, k].
+size_t lda_of(const ExecStep& s) { return (s.trans & VECTORIA_GEMM_TRANS_A) ? s.m : s.k; }
+size_t ldb_of(const ExecStep& s) { return (s.trans & VECTORIA_GEMM_TRANS_B) ? s.k : s.n; }
+
+void run_gemm_trans_ref(const ExecStep& s, const ExecContext&) {
+    if (gemm_trans_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n, s.k, lda_of(s), ldb_of(s), s.n, 1.0f, 0.0f, s.trans) != VECTORIA_SUCCESS) {
+        throw std::runtime_error("MatMul kernel failed");
+    }
+}
+
+// FP16 weights travel in the float pointer list; B is read as halves.
+const uint16_t* half_weights(const ExecStep& s) { return reinterpret_cast<const uint16_t*>(s.inputs[1]); }
+
+void run_gemm_f16w_ref(const ExecStep& s, const ExecContext&) {
+    if (gemm_f16w_f32(s.inputs[0], half_weights(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, 1.0f, 0.0f) != VECTORIA_SUCCESS) {
+        throw std::runtime_error("MatMul kernel failed");
+    }
+}
+
+const float* bias_of(const ExecStep& s) { return s.inputs.size() > 2 ? s.inputs[2] : nullptr; }
+
+void run_linear_ref(const ExecStep& s, const ExecContext&) {
+    if (linear_f32(s.inputs[0], s.inputs[1], bias_of(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, s.epilogue) != VECTORIA_SUCCESS) {
+        throw std::runtime_error("FusedLinear kernel failed");
+    }
+}
+
+// Int8 weights travel in the float pointer list; inputs are [X, W, Scales(, Bias)].
+const int8_t* s8_weights(const ExecStep& s) { return reinterpret_cast<const int8_t*>(s.inputs[1]); }
+const float* s8_bias(const ExecStep& s) { return s.inputs.size() > 3 ? s.inputs[3] : nullptr; }
+
+void run_linear_s8_ref(const ExecStep& s, const ExecContext&) {
+    if (linear_s8_f32(s.inputs[0], s8_weights(s), s.inputs[2], s8_bias(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, s.epilogue) != VECTORIA_SUCCESS) {
+        throw std::runtime_error("QuantizedLinear kernel failed");
+    }
+}
+
+void run_bias_add_ref(const ExecStep& s, const ExecContext&) { bias_add_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n); }
+void run_relu_ref(const ExecStep& s, const ExecContext&) { relu_f32(s.inputs[0], s.output, s.m); }
+void run_add_ref(const ExecStep& s, const ExecContext&) { add_f32(s.inputs[0], s.inputs[1], s.output, s.m); }
+void run_add_broadcast_ref(const ExecStep& s, const ExecContext&) { add_broadcast_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n); }
+void run_mul_ref(const ExecStep& s, const ExecContext&) { mul_f32(s.inputs[0], s.inputs[1], s.output, s.m); }
+void run_mul_broadcast_ref(const ExecStep& s, const ExecContext&) { mul_broadcast_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n); }
+void run_sub_ref(const ExecStep& s, const ExecContext&) { sub_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.m); }
+void run_sub_broadcast_ref(const ExecStep& s, const ExecContext&) { sub_broadcast_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n); }
+void run_div_ref(const ExecStep& s, const ExecContext&) { div_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.m); }
+void run_div_broadcast_ref(const ExecStep& s, const ExecContext&) { div_broadcast_f32(s.inputs[0], s.inputs[1], s.output, s.m, s.n); }
+void run_reduce_sum_ref(const ExecStep& s, const ExecContext&) { reduce_sum_f32(s.inputs[0], s.output, s.m, s.n); }
+void run_reduce_max_ref(const ExecStep& s, const ExecContext&) { reduce_max_f32(s.inputs[0], s.output, s.m, s.n); }
+// Axis reductions: In [m, k, n] reduced over k (m = outer, n = inner > 1).
+void run_reduce_sum_axis_ref(const ExecStep& s, const ExecContext&) { reduce_sum_axis_f32(s.inputs[0], s.output, s.m, s.k, s.n); }
+void run_reduce_max_axis_ref(const ExecStep& s, const ExecContext&) { reduce_max_axis_f32(s.inputs[0], s.output, s.m, s.k, s.n); }
+// Mean in the first m * n outputs, variance in the next.
+void run_reduce_mean_var_ref(const ExecStep& s, const ExecContext&) {
+    reduce_mean_var_f32(s.inputs[0], s.output, s.output + s.m * s.n, s.m, s.k, s.n);
+}
+void run_exp_ref(const ExecStep& s, const ExecContext&) { exp_f32(s.inputs[0], s.output, s.m); }
+void run_softmax_ref(const ExecStep& s, const ExecContext&) { softmax_f32(s.inputs[0], s.output, s.m, s.n); }
+void run_logsoftmax_ref(const ExecStep& s, const ExecContext&) { logsoftmax_f32(s.inputs[0], s.output, s.m, s.n); }
+void run_layernorm_ref(const ExecStep& s, const ExecContext&) {
+    layernorm_f32(s.inputs[0], s.inputs[1], s.inputs[2], s.output, s.m, s.n, s.scalar);
+}
+void run_attention_ref(const ExecStep& s, const ExecContext&) {
+    if (attention_f32(s.inputs[0], s.inputs[1], s.inputs[2], s.output, s.m, s.kv_len, s.k, s.n, s.scalar) != VECTORIA_SUCCESS) {
+        throw std::runtime_error("Attention kernel failed");
+    }
+}
+void run_sqrt_ref(const ExecStep& s, const ExecContext&) { sqrt_f32(s.inputs[0], s.output, s.m); }
+void run_log_ref(const ExecStep& s, const ExecContext&) { log_f32(s.inputs[0], s.output, s.m); }
+void run_copy(const ExecStep& s, const ExecContext&) { std::memcpy(s.output, s.inputs[0], s.m * sizeof(float)); }
+void run_transpose_ref(const ExecStep& s, const ExecContext&) {
+    if (transpose_f32(s.inputs[0], s.output, s.dims, s.perm) != VECTORIA_SUCCESS) {
+        throw std::runtime_error("Transpose kernel failed");
+    }
+}
+void run_concat_ref(const ExecStep& s, const ExecContext&) { concat_f32(s.inputs, s.output, s.input_dims, s.axis); }
+void run_slice_ref(const ExecStep& s, const ExecContext&) { slice_f32(s.inputs[0], s.output, s.dims, s.axis, s.start, s.end); }
+
+// --- SIMD steps ---
+
+#if VECTORIA_HAS_ASM_KERNELS
+void check_asm(VectoriaStatus status) {
+    if (status != VECTORIA_SUCCESS) throw std::runtime_error("ASM kernel failed");
+}
+
+#if defined(__aarch64__)
+// No NEON epilogue yet: the GEMM writes its output, then one scalar pass
+// applies the epilogue (same arithmetic as linear_f32).
+VectoriaStatus linear_f32_neon(
+    const float* a, const float* b, const float* bias, float* c,
+    size_t m, size_t n, size_t k, size_t lda, size_t ldb, size_t ldc, uint32_t epilogue
+) {
+    if (epilogue > VECTORIA_EPILOGUE_BIAS_RELU) return VECTORIA_ERROR_INVALID_SHAPE;
+    VectoriaStatus status = gemm_f32_neon(a, b, c, m, n, k, lda, ldb, ldc, 1.0f, 0.0f);
+    if (status != VECTORIA_SUCCESS || epilogue == VECTORIA_EPILOGUE_NONE) return status;
+    for (size_t i = 0; i < m; ++i) {
+        float* row = c + i * ldc;
+        for (size_t j = 0; j < n; ++j) {
+            float value = row[j] + bias[j];
+            if (epilogue == VECTORIA_EPILOGUE_BIAS_RELU) value = std::max(0.0f, value);
+            row[j] = value;
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+#endif
+
+void run_gemm_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_GEMM(s.inputs[0], s.inputs[1], s.output, s.m, s.n, s.k, s.k, s.n, s.n, 1.0f, 0.0f));
+}
+#if VECTORIA_HAS_SIMD_GEMM_TRANS
+void run_gemm_trans_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_GEMM_TRANS(s.inputs[0], s.inputs[1], s.output, s.m, s.n, s.k, lda_of(s), ldb_of(s), s.n, 1.0f, 0.0f, s.trans));
+}
+#endif
+#if VECTORIA_HAS_SIMD_GEMM_F16W
+void run_gemm_f16w_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_GEMM_F16W(s.inputs[0], half_weights(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, 1.0f, 0.0f));
+}
+#endif
+#if VECTORIA_HAS_SIMD_LINEAR_S8
+void run_linear_s8_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_LINEAR_S8(s.inputs[0], s8_weights(s), s.inputs[2], s8_bias(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, s.epilogue));
+}
+#endif
+void run_linear_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_LINEAR(s.inputs[0], s.inputs[1], bias_of(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, s.epilogue));
+}
+void run_relu_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(relu_f32)(s.inputs[0], s.output, s.m)); }
+void run_add_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(add_f32)(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_mul_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(mul_f32)(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_sub_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(sub_f32)(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_div_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(div_f32)(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_reduce_sum_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(reduce_sum_f32)(s.inputs[0], s.output, s.m, s.n)); }
+void run_reduce_max_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(reduce_max_f32)(s.inputs[0], s.output, s.m, s.n)); }
+#if VECTORIA_HAS_SIMD_TRANSCENDENTALS
+void run_exp_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(exp_f32)(s.inputs[0], s.output, s.m)); }
+void run_log_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(log_f32)(s.inputs[0], s.output, s.m)); }
+void run_sqrt_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(sqrt_f32)(s.inputs[0], s.output, s.m)); }
+void run_softmax_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(softmax_f32)(s.inputs[0], s.output, s.m, s.n)); }
+void run_logsoftmax_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(logsoftmax_f32)(s.inputs[0], s.output, s.m, s.n)); }
+#endif
+#if VECTORIA_HAS_SIMD_REDUCE_AXIS
+void run_reduce_sum_axis_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(reduce_sum_axis_f32)(s.inputs[0], s.output, s.m, s.k, s.n)); }
+void run_reduce_max_axis_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(reduce_max_axis_f32)(s.inputs[0], s.output, s.m, s.k, s.n)); }
+void run_reduce_mean_var_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_KERNEL(reduce_mean_var_f32)(s.inputs[0], s.output, s.output + s.m * s.n, s.m, s.k, s.n));
+}
+#endif
+#if VECTORIA_HAS_SIMD_LAYERNORM
+void run_layernorm_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_KERNEL(layernorm_f32)(s.inputs[0], s.inputs[1], s.inputs[2], s.output, s.m, s.n, s.scalar));
+}
+#endif
+#if VECTORIA_HAS_SIMD_ATTENTION
+void run_attention_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(VECTORIA_SIMD_KERNEL(attention_f32)(s.inputs[0], s.inputs[1], s.inputs[2], s.output, s.m, s.kv_len, s.k, s.n, s.scalar));
+}
+#endif
+#if VECTORIA_HAS_SIMD_BROADCAST
+// Column broadcasts: B[i] per row of A [m, n] (m == 1 is the scalar broadcast).
+void run_add_col_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(add_col_f32)(s.inputs[0], s.inputs[1], s.output, s.m, s.n)); }
+void run_sub_col_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(sub_col_f32)(s.inputs[0], s.inputs[1], s.output, s.m, s.n)); }
+void run_div_col_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(div_col_f32)(s.inputs[0], s.inputs[1], s.output, s.m, s.n)); }
+// Mul's scalar broadcast is planned as [count, 1]; run it as one splatted row.
+void run_mul_scalar_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(mul_col_f32)(s.inputs[0], s.inputs[1], s.output, 1, s.m * s.n)); }
+// Row broadcasts: B[j] across every row of A [m, n].
+void run_mul_row_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(mul_row_f32)(s.inputs[0], s.inputs[1], s.output, s.m, s.n)); }
+void run_bias_add_simd(const ExecStep& s, const ExecContext&) { check_asm(VECTORIA_SIMD_KERNEL(add_row_f32)(s.inputs[0], s.inputs[1], s.output, s.m, s.n)); }
+// Same plan as the Reference transpose, with 8x8 register tiles for the 2D blocks.
+void run_transpose_simd(const ExecStep& s, const ExecContext&) {
+    check_asm(transpose_f32_tiled(s.inputs[0], s.output, s.dims, s.perm, VECTORIA_SIMD_KERNEL(transpose_2d_f32)));
+}
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+// AVX-512F tier: only planned when the host supports it (resolve_simd_tier).
+void run_gemm_avx512(const ExecStep& s, const ExecContext&) {
+    check_asm(gemm_f32_avx512_packed(s.inputs[0], s.inputs[1], s.output, s.m, s.n, s.k, s.k, s.n, s.n, 1.0f, 0.0f));
+}
+void run_gemm_trans_avx512(const ExecStep& s, const ExecContext&) {
+    check_asm(gemm_trans_f32_avx512_packed(s.inputs[0], s.inputs[1], s.output, s.m, s.n, s.k, lda_of(s), ldb_of(s), s.n, 1.0f, 0.0f, s.trans));
+}
+void run_linear_avx512(const ExecStep& s, const ExecContext&) {
+    check_asm(linear_f32_avx512(s.inputs[0], s.inputs[1], bias_of(s), s.output, s.m, s.n, s.k, s.k, s.n, s.n, s.epilogue));
+}
+void run_relu_avx512(const ExecStep& s, const ExecContext&) { check_asm(relu_f32_avx512(s.inputs[0], s.output, s.m)); }
+void run_add_avx512(const ExecStep& s, const ExecContext&) { check_asm(add_f32_avx512(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_mul_avx512(const ExecStep& s, const ExecContext&) { check_asm(mul_f32_avx512(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_sub_avx512(const ExecStep& s, const ExecContext&) { check_asm(sub_f32_avx512(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_div_avx512(const ExecStep& s, const ExecContext&) { check_asm(div_f32_avx512(s.inputs[0], s.inputs[1], s.output, s.m)); }
+void run_reduce_sum_avx512(const ExecStep& s, const ExecContext&) { check_asm(reduce_sum_f32_avx512(s.inputs[0], s.output, s.m, s.n)); }
+void run_reduce_max_avx512(const ExecStep& s, const ExecContext&) { check_asm(reduce_max_f32_avx512(s.inputs[0], s.output, s.m, s.n)); }
+#endif
+#else
+// The GEMM ops (MatMul, BatchedMatMul, FusedLinear, QuantizedLinear) are the
+// only ops that refuse to fall back silently under the SIMD policy.
+void run_gemm_unavailable(const ExecStep&, const ExecContext&) {
+#ifdef VECTORIA_USE_ASM
+    throw std::runtime_error("SIMD policy requested but architecture not supported");
+#else
+    throw std::runtime_error("SIMD policy requested but VECTORIA_USE_ASM not defined");
+#endif
+}
+#endif
+
+// --- Tiled GEMM ---
+
+// One output tile of C = A * B. Every element still runs the kernel's full,
+// in-order K loop, so a tile produces exactly the bits the untiled call would.
+void run_gemm_tile(const ExecStep& s, size_t tile) {
+    const size_t i0 = (tile / s.tiles_n) * kGemmTileM;
+    const size_t j0 = (tile % s.tiles_n) * kGemmTileN;
+    const size_t rows = std::min(kGemmTileM, s.m - i0);
+    const size_t cols = std::min(kGemmTileN, s.n - j0);
+    // Rows of op(A) are columns of a transposed A, and likewise for B.
+    const float* a = s.inputs[0] + ((s.trans & VECTORIA_GEMM_TRANS_A) ? i0 : i0 * s.k);
+    const float* b = s.inputs[1] + ((s.trans & VECTORIA_GEMM_TRANS_B) ? j0 * s.k : j0);
+    float* c = s.output + i0 * s.n + j0;
+    VectoriaStatus status = s.linear
+        ? s.linear(a, b, s.inputs.size() > 2 ? s.inputs[2] + j0 : nullptr, c, rows, cols, s.k, s.k, s.n, s.n, s.epilogue)
+        : s.linear_s8
+        ? s.linear_s8(a, s8_weights(s) + j0, s.inputs[2] + j0, s8_bias(s) ? s8_bias(s) + j0 : nullptr, c, rows, cols, s.k, s.k, s.n, s.n, s.epilogue)
+        : s.gemm_trans
+        ? s.gemm_trans(a, b, c, rows, cols, s.k, lda_of(s), ldb_of(s), s.n, 1.0f, 0.0f, s.trans)
+        : s.gemm_f16w
+        ? s.gemm_f16w(a, half_weights(s) + j0, c, rows, cols, s.k, s.k, s.n, s.n, 1.0f, 0.0f)
+        : s.gemm(a, b, c, rows, cols, s.k, s.k, s.n, s.n, 1.0f, 0.0f);
+    if (status != VECTORIA_SUCCESS) throw std::runtime_error("GEMM kernel failed");
+}
+
+// --- Batched GEMM ---
+
+// Batch items are independent GEMM calls, so running them on different
+// workers does not change any output bit.
+void run_batched_gemm_items(const ExecStep& s, size_t first, size_t count) {
+    VectoriaStatus status = gemm_batched_f32(
+        s.inputs[0] + first * s.m * s.k, s.inputs[1] + first * s.batch_stride_b, s.output + first * s.m * s.n,
+        count, s.m, s.n, s.k, s.k, s.n, s.n, s.m * s.k, s.batch_stride_b, s.m * s.n, s.gemm);
+    if (status != VECTORIA_SUCCESS) throw std::runtime_error("BatchedMatMul kernel failed");
+}
+
+void run_batched_gemm_task(void* ctx, size_t item, size_t) {
+    run_batched_gemm_items(*static_cast<const ExecStep*>(ctx), item, 1);
+}
+
+void run_batched_gemm(const ExecStep& s, const ExecContext& ctx) {
+    if (!ctx.pool || s.batch <= 1) {
+        run_batched_gemm_items(s, 0, s.batch);
+        return;
+    }
+    ctx.pool->parallel_for(ctx.worker, s.batch, run_batched_gemm_task, const_cast<ExecStep*>(&s));
+}
+
+void run_gemm_tile_task(void* ctx, size_t tile, size_t) {
+    run_gemm_tile(*static_cast<const ExecStep*>(ctx), tile);
+}
+
+void run_gemm_tiled(const ExecStep& s, const ExecContext& ctx) {
+    const size_t tiles = s.tiles_m * s.tiles_n;
+    if (!ctx.pool) {
+        for (size_t t = 0; t < tiles; ++t) run_gemm_tile(s, t);
+        return;
+    }
+    ctx.pool->parallel_for(ctx.worker, tiles, run_gemm_tile_task, const_cast<ExecStep*>(&s));
+}
+
+const ir::TensorShape& shape_of(const ir::Graph& graph, size_t idx) {
+    static const ir::TensorShape empty;
+    const auto& n = graph.nodes[idx];
+    if (auto* i = std::get_if<ir::InputNode>(&n.data)) return i->shape;
+    if (auto* p = std::get_if<ir::ParameterNode>(&n.data)) return p->shape;
+    if (auto* c = std::get_if<ir::ConstantNode>(&n.data)) return c->shape;
+    if (auto* o = std::get_if<ir::OpNode>(&n.data)) return o->output_shape;
+    return empty;
+}
+
+ir::DataType dtype_of(const ir::Graph& graph, size_t idx) {
+    const auto& n = graph.nodes[idx];
+    if (auto* i = std::get_if<ir::InputNode>(&n.data)) return i->dtype;
+    if (auto* p = std::get_if<ir::ParameterNode>(&n.data)) return p->dtype;
+    if (auto* c = std::get_if<ir::ConstantNode>(&n.data)) return c->dtype;
+    if (auto* o = std::get_if<ir::OpNode>(&n.data)) return o->output_dtype;
+    return ir::DataType::Float32;
+}
+
+size_t element_count(const ir::TensorShape& shape) {
+    size_t count = 1;
+    for (auto d : shape.dims) count *= d;
+    return count;
+}
+
+void require_inputs(const ir::OpNode& op, size_t count, const char* name) {
+    if (op.inputs.size() != count) {
+        throw std::runtime_error(std::string(name) + " requires " + std::to_string(count) +
+                                 (count == 1 ? " input" : " inputs"));
+    }
+}
+
+std::string inputs_tag(const ir::OpNode& op) {
+    std::string tag = " | Inputs: [";
+    for (size_t i = 0; i < op.inputs.size(); ++i) {
+        if (i) tag += ", ";
+        tag += std::to_string(op.inputs[i].index);
+    }
+    return tag + "]";
+}
+
+// Splits [..., inner] into (outer, inner) for last-axis reductions.
+void outer_inner(const ir::TensorShape& s, size_t& outer, size_t& inner, const char* name) {
+    if (s.dims.empty()) throw std::runtime_error(std::string(name) + " input must have at least 1 dim");
+    inner = s.dims.back();
+    outer = 1;
+    for (size_t i = 0; i + 1 < s.dims.size(); ++i) outer *= s.dims[i];
+}
+
+// [outer, reduced, inner] around the axis in int_params[0] (default -1) of a
+// reduction, and the element count of the reduced shape (outer * inner).
+size_t reduce_extents(const ir::TensorShape& s, const ir::OpNode& op, size_t& outer, size_t& reduced,
+                      size_t& inner, const char* name) {
+    if (s.dims.empty()) throw std::runtime_error(std::string(name) + " input must have at least 1 dim");
+    const int64_t rank = static_cast<int64_t>(s.dims.size());
+    int64_t axis = op.int_params.empty() ? -1 : op.int_params[0];
+    if (axis < 0) axis += rank;
+    if (axis < 0 || axis >= rank) throw std::runtime_error(std::string(name) + " axis out of range");
+    outer = 1;
+    inner = 1;
+    for (int64_t i = 0; i < axis; ++i) outer *= s.dims[i];
+    for (int64_t i = axis + 1; i < rank; ++i) inner *= s.dims[i];
+    reduced = s.dims[axis];
+    return outer * inner;
+}
+
+// (m, k) x (k, n) extents of a MatMul-shaped op, with A stored [k, m] and
+// B stored [n, k] as selected by step.trans.
+void gemm_extents(const ir::Graph& graph, const ir::OpNode& op, ExecStep& step, const char* name) {
+    const auto& shape_a = shape_of(graph, op.inputs[0].index);
+    const auto& shape_b = shape_of(graph, op.inputs[1].index);
+    if (shape_a.dims.size() != 2 || shape_b.dims.size() != 2) {
+        throw std::runtime_error(std::string(name) + " supports only 2D tensors for now");
+    }
+    const bool trans_a = (step.trans & VECTORIA_GEMM_TRANS_A) != 0;
+    const bool trans_b = (step.trans & VECTORIA_GEMM_TRANS_B) != 0;
+    step.m = shape_a.dims[trans_a ? 1 : 0];
+    step.k = shape_a.dims[trans_a ? 0 : 1];
+    step.n = shape_b.dims[trans_b ? 0 : 1];
+    if (shape_b.dims[trans_b ? 1 : 0] != static_cast<int64_t>(step.k)) {
+        throw std::runtime_error(std::string(name) + " dimension mismatch");
+    }
+}
+
+// Fixed tile grid: the split depends only on the shapes, never on how many
+// workers end up running the tiles. Returns false if the op stays one call.
+bool tile_gemm(ExecStep& step, size_t num_threads, std::string& tag) {
+    const size_t tiles_m = (step.m + kGemmTileM - 1) / kGemmTileM;
+    const size_t tiles_n = (step.n + kGemmTileN - 1) / kGemmTileN;
+    if (num_threads <= 1 || tiles_m * tiles_n <= 1 || step.k == 0) return false;
+    step.tiles_m = tiles_m;
+    step.tiles_n = tiles_n;
+    step.fn = run_gemm_tiled;
+    tag += " | Tiles: " + std::to_string(tiles_m) + "x" + std::to_string(tiles_n) +
+           " of " + std::to_string(kGemmTileM) + "x" + std::to_string(kGemmTileN) +
+           " | Threads: " + std::to_string(num_threads);
+    return true;
+}
+
+const char* epilogue_name(uint32_t epilogue) {
+    switch (epilogue) {
+        case VECTORIA_EPILOGUE_BIAS: return "Bias";
+        case VECTORIA_EPILOGUE_BIAS_RELU: return "BiasRelu";
+        default: return "None";
+    }
+}
+
+} // namespace
+
+bool has_transposed_gemm(KernelPolicy policy) {
+    return policy != KernelPolicy::SIMD || VECTORIA_HAS_SIMD_GEMM_TRANS;
+}
+
+KernelSelection select_kernels(KernelPolicy policy, SimdTier requested,
+                               const capabilities::CpuFeatures& host) {
+    KernelSelection selection;
+    if (policy != KernelPolicy::SIMD) return selection;
+    selection.policy = KernelPolicy::SIMD;
+    bool compiled = false;
+    for (const capabilities::KernelVariant& variant : capabilities::kernel_variants()) {
+        if (requested != SimdTier::Auto && variant.tier != requested) continue;
+        compiled = true;
+        if (variant.supported(host)) {
+            selection.tier = variant.tier;
+            selection.variant = variant.name;
+            return selection;
+        }
+        if (requested != SimdTier::Auto) {
+            throw std::runtime_error(std::string("SIMD tier ") + variant.name +
+                                     " requested but the host does not support it");
+        }
+    }
+    if (requested == SimdTier::AVX512) {
+        throw std::runtime_error("SIMD tier AVX512 requested but not compiled in");
+    }
+    // No kernel variant compiled in: the SIMD policy keeps its Reference
+    // kernels. Compiled in but none supported: run the Reference policy
+    // rather than fault on the first SIMD instruction.
+    if (compiled) selection.policy = KernelPolicy::Reference;
+    return selection;
+}
+
+KernelSelection select_kernels(KernelPolicy policy, SimdTier requested) {
+    return select_kernels(policy, requested, capabilities::host_cpu_features());
+}
+
+SimdTier resolve_simd_tier(KernelPolicy policy, SimdTier requested) {
+    return select_kernels(policy, requested).tier;
+}
+
+std::vector<ExecStep> build_exec_plan(
+    const ir::Graph& graph,
+    const std::vector<size_t>& schedule,
+    const std::vector<void*>& buffers,
+    const std::vector<int64_t>& alias_of,
+    KernelPolicy policy,
+    size_t num_threads,
+    SimdTier tier
+) {
+    const bool simd_policy = (policy == KernelPolicy::SIMD);
+    const bool simd = simd_policy && VECTORIA_HAS_ASM_KERNELS;
+    [[maybe_unused]] const bool avx512 = simd && VECTORIA_HAS_SIMD_AVX512 && tier == SimdTier::AVX512;
+
+    std::vector<ExecStep> plan;
+    plan.reserve(schedule.size());
+
+    for (size_t node_idx : schedule) {
+        plan.emplace_back();
+        ExecStep& step = plan.back();
+        step.node_id = node_idx;
+        step.output = static_cast<float*>(buffers[node_idx]);
+
+        auto* op = std::get_if<ir::OpNode>(&graph.nodes[node_idx].data);
+        if (!op) continue;
+
+        for (const auto& in : op->inputs) {
+            step.inputs.push_back(static_cast<const float*>(buffers[in.index]));
+        }
+
+        // Kernels read Float32, except the weights (input 1) of an FP16-weight
+        // MatMul or of a QuantizedLinear.
+        for (size_t i = 0; i < op->inputs.size(); ++i) {
+            const ir::DataType dtype = dtype_of(graph, op->inputs[i].index);
+            if (dtype == ir::DataType::Float16 && !(op->op == ir::OpType::MatMul && i == 1)) {
+                throw std::runtime_error("Float16 tensors are only supported as MatMul weights (input 1)");
+            }
+            if (dtype == ir::DataType::Int8 && !(op->op == ir::OpType::QuantizedLinear && i == 1)) {
+                throw std::runtime_error("Int8 tensors are only supported as QuantizedLinear weights (input 1)");
+            }
+        }
+
+        if (alias_of[node_idx] >= 0) {
+            // View resolved by the memory planner; the data is already in place.
+            step.trace_tag = "Alias (View) | Inputs: [" + std::to_string(alias_of[node_idx]) + "]";
+            continue;
+        }
+
+        bool used_simd = false;
+        [[maybe_unused]] bool used_avx512 = false; // Only read with VECTORIA_HAS_SIMD_AVX512
+        std::string tag;
+
+        switch (op->op) {
+            case ir::OpType::MatMul: {
+                require_inputs(*op, 2, "MatMul");
+                if (!op->int_params.empty()) {
+                    const int64_t trans = op->int_params[0];
+                    if (trans < static_cast<int64_t>(ir::MatMulTranspose::None) ||
+                        trans > static_cast<int64_t>(ir::MatMulTranspose::AB)) {
+                        throw std::runtime_error("MatMul transpose flags must be 0 (none), 1 (A), 2 (B) or 3 (both)");
+                    }
+                    step.trans = static_cast<uint32_t>(trans);
+                }
+                gemm_extents(graph, *op, step, "MatMul");
+                if (dtype_of(graph, op->inputs[1].index) == ir::DataType::Float16) {
+                    if (step.trans != VECTORIA_GEMM_TRANS_NONE) {
+                        throw std::runtime_error("MatMul with FP16 weights does not support transpose flags");
+                    }
+                    step.fn = run_gemm_f16w_ref;
+#if VECTORIA_HAS_SIMD_GEMM_F16W
+                    if (simd) { step.fn = run_gemm_f16w_simd; used_simd = true; }
+#elif VECTORIA_HAS_ASM_KERNELS
+                    if (simd) throw std::runtime_error("MatMul with FP16 weights has no SIMD kernel on this architecture");
+#else
+                    if (simd_policy) step.fn = run_gemm_unavailable;
+#endif
+                    tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op) + " | Weights: F16";
+                    if ((simd || !simd_policy) && tile_gemm(step, num_threads, tag)) {
+                        step.gemm_f16w = gemm_f16w_f32;
+#if VECTORIA_HAS_SIMD_GEMM_F16W
+                        if (simd) step.gemm_f16w = VECTORIA_SIMD_GEMM_F16W;
+#endif
+                    }
+                    break;
+                }
+                if (step.trans != VECTORIA_GEMM_TRANS_NONE) {
+                    step.fn = run_gemm_trans_ref;
+#if VECTORIA_HAS_SIMD_GEMM_TRANS
+                    if (simd) { step.fn = run_gemm_trans_simd; used_simd = true; }
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (avx512) { step.fn = run_gemm_trans_avx512; used_avx512 = true; }
+#endif
+#elif VECTORIA_HAS_ASM_KERNELS
+                    if (simd) throw std::runtime_error("MatMul with transposed operands has no SIMD kernel on this architecture");
+#else
+                    if (simd_policy) step.fn = run_gemm_unavailable;
+#endif
+                    tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op) +
+                          " | Trans: " + (step.trans == VECTORIA_GEMM_TRANS_A ? "TN" : step.trans == VECTORIA_GEMM_TRANS_B ? "NT" : "TT");
+                    if ((simd || !simd_policy) && tile_gemm(step, num_threads, tag)) {
+                        step.gemm_trans = gemm_trans_f32;
+#if VECTORIA_HAS_SIMD_GEMM_TRANS
+                        if (simd) step.gemm_trans = VECTORIA_SIMD_GEMM_TRANS;
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                        if (used_avx512) step.gemm_trans = gemm_trans_f32_avx512_packed;
+#endif
+                    }
+                    break;
+                }
+#if VECTORIA_HAS_ASM_KERNELS
+                step.fn = simd ? run_gemm_simd : run_gemm_ref;
+#else
+                step.fn = simd_policy ? run_gemm_unavailable : run_gemm_ref;
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                if (avx512) { step.fn = run_gemm_avx512; used_avx512 = true; }
+#endif
+                used_simd = simd;
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op);
+
+                if ((simd || !simd_policy) && tile_gemm(step, num_threads, tag)) {
+#if VECTORIA_HAS_ASM_KERNELS
+                    step.gemm = simd ? VECTORIA_SIMD_GEMM : gemm_f32;
+#else
+                    step.gemm = gemm_f32;
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (used_avx512) step.gemm = gemm_f32_avx512_packed;
+#endif
+                }
+                break;
+            }
+            case ir::OpType::BatchedMatMul: {
+                require_inputs(*op, 2, "BatchedMatMul");
+                const auto& shape_a = shape_of(graph, op->inputs[0].index);
+                const auto& shape_b = shape_of(graph, op->inputs[1].index);
+                if (shape_a.dims.size() != 3 || (shape_b.dims.size() != 3 && shape_b.dims.size() != 2)) {
+                    throw std::runtime_error("BatchedMatMul requires A [B, M, K] and B [B, K, N] or [K, N]");
+                }
+                const bool shared_b = (shape_b.dims.size() == 2);
+                step.batch = shape_a.dims[0];
+                step.m = shape_a.dims[1];
+                step.k = shape_a.dims[2];
+                step.n = shape_b.dims.back();
+                if ((!shared_b && shape_b.dims[0] != shape_a.dims[0]) ||
+                    shape_b.dims[shape_b.dims.size() - 2] != static_cast<int64_t>(step.k)) {
+                    throw std::runtime_error("BatchedMatMul dimension mismatch");
+                }
+                step.batch_stride_b = shared_b ? 0 : step.k * step.n;
+                // Same policy rules as MatMul: SIMD never falls back silently.
+#if VECTORIA_HAS_ASM_KERNELS
+                step.fn = run_batched_gemm;
+                step.gemm = simd ? VECTORIA_SIMD_GEMM : gemm_f32;
+#else
+                step.fn = simd_policy ? run_gemm_unavailable : run_batched_gemm;
+                step.gemm = gemm_f32;
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                if (avx512) { step.gemm = gemm_f32_avx512_packed; used_avx512 = true; }
+#endif
+                used_simd = simd;
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op) +
+                      " | Batch: " + std::to_string(step.batch);
+                if (num_threads > 1 && step.batch > 1) tag += " | Threads: " + std::to_string(num_threads);
+                break;
+            }
+            case ir::OpType::FusedLinear: {
+                if (op->int_params.empty()) throw std::runtime_error("FusedLinear requires an epilogue");
+                const int64_t epilogue = op->int_params[0];
+                if (epilogue < VECTORIA_EPILOGUE_NONE || epilogue > VECTORIA_EPILOGUE_BIAS_RELU) {
+                    throw std::runtime_error("FusedLinear epilogue must be 0 (none), 1 (bias) or 2 (bias + relu)");
+                }
+                step.epilogue = static_cast<uint32_t>(epilogue);
+                require_inputs(*op, step.epilogue == VECTORIA_EPILOGUE_NONE ? 2 : 3, "FusedLinear");
+                gemm_extents(graph, *op, step, "FusedLinear");
+                if (op->inputs.size() > 2 && element_count(shape_of(graph, op->inputs[2].index)) != step.n) {
+                    throw std::runtime_error("FusedLinear bias must have N elements");
+                }
+                // Same policy rules as MatMul: SIMD never falls back silently.
+#if VECTORIA_HAS_ASM_KERNELS
+                step.fn = simd ? run_linear_simd : run_linear_ref;
+#else
+                step.fn = simd_policy ? run_gemm_unavailable : run_linear_ref;
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                if (avx512) { step.fn = run_linear_avx512; used_avx512 = true; }
+#endif
+                used_simd = simd;
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op) +
+                      " | Epilogue: " + epilogue_name(step.epilogue);
+
+                if ((simd || !simd_policy) && tile_gemm(step, num_threads, tag)) {
+#if VECTORIA_HAS_ASM_KERNELS
+                    step.linear = simd ? VECTORIA_SIMD_LINEAR : linear_f32;
+#else
+                    step.linear = linear_f32;
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (used_avx512) step.linear = linear_f32_avx512;
+#endif
+                }
+                break;
+            }
+            case ir::OpType::QuantizedLinear: {
+                if (op->int_params.empty()) throw std::runtime_error("QuantizedLinear requires an epilogue");
+                const int64_t epilogue = op->int_params[0];
+                if (epilogue < VECTORIA_EPILOGUE_NONE || epilogue > VECTORIA_EPILOGUE_BIAS_RELU) {
+                    throw std::runtime_error("QuantizedLinear epilogue must be 0 (none), 1 (bias) or 2 (bias + relu)");
+                }
+                step.epilogue = static_cast<uint32_t>(epilogue);
+                require_inputs(*op, step.epilogue == VECTORIA_EPILOGUE_NONE ? 3 : 4, "QuantizedLinear");
+                if (dtype_of(graph, op->inputs[1].index) != ir::DataType::Int8) {
+                    throw std::runtime_error("QuantizedLinear weights must be Int8");
+                }
+                gemm_extents(graph, *op, step, "QuantizedLinear");
+                if (element_count(shape_of(graph, op->inputs[2].index)) != step.n ||
+                    (op->inputs.size() > 3 && element_count(shape_of(graph, op->inputs[3].index)) != step.n)) {
+                    throw std::runtime_error("QuantizedLinear scales and bias must have N elements");
+                }
+                if (step.k > VECTORIA_S8_MAX_K) throw std::runtime_error("QuantizedLinear K exceeds VECTORIA_S8_MAX_K");
+                // Same policy rules as MatMul: SIMD never falls back silently.
+                step.fn = run_linear_s8_ref;
+#if VECTORIA_HAS_SIMD_LINEAR_S8
+                if (simd) { step.fn = run_linear_s8_simd; used_simd = true; }
+#elif VECTORIA_HAS_ASM_KERNELS
+                if (simd) throw std::runtime_error("QuantizedLinear has no SIMD kernel on this architecture");
+#else
+                if (simd_policy) step.fn = run_gemm_unavailable;
+#endif
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op) +
+                      " | Epilogue: " + epilogue_name(step.epilogue) + " | Weights: S8";
+                if ((simd || !simd_policy) && tile_gemm(step, num_threads, tag)) {
+                    step.linear_s8 = linear_s8_f32;
+#if VECTORIA_HAS_SIMD_LINEAR_S8
+                    if (simd) step.linear_s8 = VECTORIA_SIMD_LINEAR_S8;
+#endif
+                }
+                break;
+            }
+            case ir::OpType::BiasAdd: {
+                require_inputs(*op, 2, "BiasAdd");
+                // Assume 2D [M, N]
+                const auto& shape_in = shape_of(graph, op->inputs[0].index);
+                if (shape_in.dims.size() != 2) throw std::runtime_error("BiasAdd requires a 2D input");
+                step.m = shape_in.dims[0];
+                step.n = shape_in.dims[1];
+                step.fn = run_bias_add_ref;
+#if VECTORIA_HAS_SIMD_BROADCAST
+                if (simd) { step.fn = run_bias_add_simd; used_simd = true; }
+#endif
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op);
+                break;
+            }
+            case ir::OpType::Relu: {
+                require_inputs(*op, 1, "Relu");
+                step.m = element_count(shape_of(graph, op->inputs[0].index));
+                step.fn = run_relu_ref;
+#if VECTORIA_HAS_ASM_KERNELS
+                if (simd) { step.fn = run_relu_simd; used_simd = true; }
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                if (avx512) { step.fn = run_relu_avx512; used_avx512 = true; }
+#endif
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op);
+                break;
+            }
+            case ir::OpType::Add: {
+                require_inputs(*op, 2, "Add");
+                size_t count_a = element_count(shape_of(graph, op->inputs[0].index));
+                size_t count_b = element_count(shape_of(graph, op->inputs[1].index));
+                if (count_a == count_b) {
+                    step.m = count_a;
+                    step.fn = run_add_ref;
+#if VECTORIA_HAS_ASM_KERNELS
+                    if (simd) { step.fn = run_add_simd; used_simd = true; }
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (avx512) { step.fn = run_add_avx512; used_avx512 = true; }
+#endif
+                } else {
+                    // Col-vector broadcast (A[i,j] + B[i]), or scalar broadcast (B[0]) if outer=1
+                    if (count_b == 0) throw std::runtime_error("Add broadcast div by zero");
+                    if (count_a % count_b != 0) throw std::runtime_error("Add broadcast shape mismatch");
+                    step.m = count_b;
+                    step.n = count_a / count_b;
+                    step.fn = run_add_broadcast_ref;
+#if VECTORIA_HAS_SIMD_BROADCAST
+                    if (simd) { step.fn = run_add_col_simd; used_simd = true; }
+#endif
+                }
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op);
+                break;
+            }
+            case ir::OpType::Mul: {
+                require_inputs(*op, 2, "Mul");
+                const auto& shape_a = shape_of(graph, op->inputs[0].index);
+                const auto& shape_b = shape_of(graph, op->inputs[1].index);
+                size_t count_a = element_count(shape_a);
+                size_t count_b = element_count(shape_b);
+                if (count_a == count_b) {
+                    step.m = count_a;
+                    step.fn = run_mul_ref;
+#if VECTORIA_HAS_ASM_KERNELS
+                    if (simd) { step.fn = run_mul_simd; used_simd = true; }
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (avx512) { step.fn = run_mul_avx512; used_avx512 = true; }
+#endif
+                } else {
+                    // A [Outer, Inner] * B [Inner], or scalar broadcast if count_b == 1
+                    bool is_scalar_b = (count_b == 1);
+                    if (!is_scalar_b && (shape_a.dims.empty() || shape_b.dims.empty())) {
+                        throw std::runtime_error("Mul broadcast requires rank >= 1 (unless scalar)");
+                    }
+                    size_t inner_a = shape_a.dims.empty() ? 1 : shape_a.dims.back();
+                    bool is_row_b = (count_b == inner_a);
+                    if (is_row_b) {
+                        step.m = count_a / inner_a;
+                        step.n = inner_a;
+                    } else if (is_scalar_b) {
+                        step.m = count_a;
+                        step.n = 1;
+                    } else {
+                        throw std::runtime_error("Mul broadcast shape mismatch: Expected B size " + std::to_string(inner_a) + " or 1, but got " + std::to_string(count_b));
+                    }
+                    step.fn = run_mul_broadcast_ref;
+#if VECTORIA_HAS_SIMD_BROADCAST
+                    if (simd) { step.fn = is_row_b ? run_mul_row_simd : run_mul_scalar_simd; used_simd = true; }
+#endif
+                }
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::Sub:
+            case ir::OpType::Div: {
+                bool is_sub = (op->op == ir::OpType::Sub);
+                require_inputs(*op, 2, is_sub ? "Sub" : "Div");
+                size_t count_a = element_count(shape_of(graph, op->inputs[0].index));
+                size_t count_b = element_count(shape_of(graph, op->inputs[1].index));
+                if (count_a == count_b) {
+                    step.m = count_a;
+                    step.fn = is_sub ? run_sub_ref : run_div_ref;
+#if VECTORIA_HAS_ASM_KERNELS
+                    if (simd) { step.fn = is_sub ? run_sub_simd : run_div_simd; used_simd = true; }
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (avx512) { step.fn = is_sub ? run_sub_avx512 : run_div_avx512; used_avx512 = true; }
+#endif
+                } else {
+                    if (count_b == 0 || count_a % count_b != 0) {
+                        throw std::runtime_error(std::string(is_sub ? "Sub" : "Div") + " broadcast shape mismatch");
+                    }
+                    step.m = count_b;
+                    step.n = count_a / count_b;
+                    step.fn = is_sub ? run_sub_broadcast_ref : run_div_broadcast_ref;
+#if VECTORIA_HAS_SIMD_BROADCAST
+                    if (simd) { step.fn = is_sub ? run_sub_col_simd : run_div_col_simd; used_simd = true; }
+#endif
+                }
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::ReduceSum:
+            case ir::OpType::ReduceMax: {
+                bool is_sum = (op->op == ir::OpType::ReduceSum);
+                const char* name = is_sum ? "ReduceSum" : "ReduceMax";
+                require_inputs(*op, 1, name);
+                size_t outer, reduced, inner;
+                const size_t count = reduce_extents(shape_of(graph, op->inputs[0].index), *op, outer, reduced, inner, name);
+                if (element_count(op->output_shape) != count) {
+                    throw std::runtime_error(std::string(name) + " output shape mismatch");
+                }
+                step.m = outer;
+                if (inner == 1) {
+                    // Contiguous: reduce rows of [outer, reduced]
+                    step.n = reduced;
+                    step.fn = is_sum ? run_reduce_sum_ref : run_reduce_max_ref;
+#if VECTORIA_HAS_ASM_KERNELS
+                    if (simd) { step.fn = is_sum ? run_reduce_sum_simd : run_reduce_max_simd; used_simd = true; }
+#endif
+#if VECTORIA_HAS_SIMD_AVX512
+                    if (avx512) { step.fn = is_sum ? run_reduce_sum_avx512 : run_reduce_max_avx512; used_avx512 = true; }
+#endif
+                } else {
+                    // Strided: reduce down the rows of each [reduced, inner] block
+                    step.k = reduced;
+                    step.n = inner;
+                    step.fn = is_sum ? run_reduce_sum_axis_ref : run_reduce_max_axis_ref;
+#if VECTORIA_HAS_SIMD_REDUCE_AXIS
+                    if (simd) { step.fn = is_sum ? run_reduce_sum_axis_simd : run_reduce_max_axis_simd; used_simd = true; }
+#endif
+                }
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::ReduceMeanVar: {
+                require_inputs(*op, 1, "ReduceMeanVar");
+                const size_t count = reduce_extents(shape_of(graph, op->inputs[0].index), *op, step.m, step.k, step.n, "ReduceMeanVar");
+                if (step.k == 0) throw std::runtime_error("ReduceMeanVar over an empty axis");
+                if (element_count(op->output_shape) != 2 * count) {
+                    throw std::runtime_error("ReduceMeanVar output must be [2, ...reduced shape]");
+                }
+                step.fn = run_reduce_mean_var_ref;
+#if VECTORIA_HAS_SIMD_REDUCE_AXIS
+                if (simd) { step.fn = run_reduce_mean_var_simd; used_simd = true; }
+#endif
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::Exp:
+            case ir::OpType::Sqrt:
+            case ir::OpType::Log: {
+                const char* name = op->op == ir::OpType::Exp ? "Exp" : (op->op == ir::OpType::Sqrt ? "Sqrt" : "Log");
+                require_inputs(*op, 1, name);
+                step.m = element_count(shape_of(graph, op->inputs[0].index));
+                step.fn = op->op == ir::OpType::Exp ? run_exp_ref : (op->op == ir::OpType::Sqrt ? run_sqrt_ref : run_log_ref);
+#if VECTORIA_HAS_SIMD_TRANSCENDENTALS
+                // Exp / Log are polynomial approximations (<= 1 ulp), Sqrt is exact.
+                if (simd) {
+                    step.fn = op->op == ir::OpType::Exp ? run_exp_simd : (op->op == ir::OpType::Sqrt ? run_sqrt_simd : run_log_simd);
+                    used_simd = true;
+                }
+#endif
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::Softmax:
+            case ir::OpType::LogSoftmax: {
+                bool is_log = (op->op == ir::OpType::LogSoftmax);
+                const char* name = is_log ? "LogSoftmax" : "Softmax";
+                require_inputs(*op, 1, name);
+                outer_inner(shape_of(graph, op->inputs[0].index), step.m, step.n, name);
+                step.fn = is_log ? run_logsoftmax_ref : run_softmax_ref;
+#if VECTORIA_HAS_SIMD_TRANSCENDENTALS
+                if (simd) { step.fn = is_log ? run_logsoftmax_simd : run_softmax_simd; used_simd = true; }
+#endif
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::LayerNorm: {
+                require_inputs(*op, 3, "LayerNorm");
+                if (op->int_params.empty()) throw std::runtime_error("LayerNorm requires an epsilon");
+                step.scalar = ir::decode_f32_param(op->int_params[0]);
+                if (!(step.scalar >= 0.0f)) throw std::runtime_error("LayerNorm epsilon must be non-negative");
+                outer_inner(shape_of(graph, op->inputs[0].index), step.m, step.n, "LayerNorm");
+                if (element_count(shape_of(graph, op->inputs[1].index)) != step.n ||
+                    element_count(shape_of(graph, op->inputs[2].index)) != step.n) {
+                    throw std::runtime_error("LayerNorm gamma and beta must match the last dimension");
+                }
+                step.fn = run_layernorm_ref;
+#if VECTORIA_HAS_SIMD_LAYERNORM
+                if (simd) { step.fn = run_layernorm_simd; used_simd = true; }
+#endif
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op);
+                break;
+            }
+            case ir::OpType::Attention: {
+                require_inputs(*op, 3, "Attention");
+                if (op->int_params.empty()) throw std::runtime_error("Attention requires a score scale");
+                const auto& q = shape_of(graph, op->inputs[0].index);
+                const auto& k = shape_of(graph, op->inputs[1].index);
+                const auto& v = shape_of(graph, op->inputs[2].index);
+                if (q.dims.size() != 2 || k.dims.size() != 2 || v.dims.size() != 2) {
+                    throw std::runtime_error("Attention requires 2D Q, K and V");
+                }
+                if (q.dims[1] != k.dims[1] || k.dims[0] != v.dims[0] || k.dims[0] <= 0) {
+                    throw std::runtime_error("Attention shape mismatch: Q [T, d], K [S, d], V [S, d_v] required");
+                }
+                step.m = q.dims[0];
+                step.k = q.dims[1];
+                step.kv_len = k.dims[0];
+                step.n = v.dims[1];
+                step.scalar = ir::decode_f32_param(op->int_params[0]);
+                step.fn = run_attention_ref;
+#if VECTORIA_HAS_SIMD_ATTENTION
+                if (simd) { step.fn = run_attention_simd; used_simd = true; }
+#endif
+                tag = (used_simd ? VECTORIA_SIMD_TAG : "Reference") + inputs_tag(*op);
+                break;
+            }
+            case ir::OpType::Reshape: {
+                require_inputs(*op, 1, "Reshape");
+                step.m = element_count(shape_of(graph, op->inputs[0].index));
+                step.fn = run_copy;
+                tag = "Reference (Copy) | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::Transpose: {
+                require_inputs(*op, 1, "Transpose");
+                step.dims = shape_of(graph, op->inputs[0].index).dims;
+                step.perm = op->int_params;
+                step.fn = run_transpose_ref;
+#if VECTORIA_HAS_SIMD_TRANSPOSE
+                if (simd) { step.fn = run_transpose_simd; used_simd = true; }
+#endif
+                tag = used_simd ? "SIMD | Inputs: [...]" : "Reference | Inputs: [...]";
+                break;
+            }
+            case ir::OpType::Concat: {
+                if (op->int_params.empty()) throw std::runtime_error("Concat requires an axis");
+                for (const auto& in : op->inputs) {
+                    step.input_dims.push_back(shape_of(graph, in.index).dims);
+                }
+                step.axis = op->int_params[0];
+                step.fn = run_concat_ref;
+                tag = "Reference | Axis: " + std::to_string(step.axis);
+                break;
+            }
+            case ir::OpType::Slice: {
+                require_inputs(*op, 1, "Slice");
+                if (op->int_params.size() < 3) throw std::runtime_error("Slice requires axis, start and end");
+                step.dims = shape_of(graph, op->inputs[0].index).dims;
+                step.axis = op->int_params[0];
+                step.start = op->int_params[1];
+                step.end = op->int_params[2];
+                step.fn = run_slice_ref;
+                tag = "Reference | Axis: " + std::to_string(step.axis);
+                break;
+            }
+            default:
+                // No kernel for this op.
+                break;
+        }
+
+#if VECTORIA_HAS_SIMD_AVX512
+        // Same tag layout, with the tier in the kernel name.
+        if (used_avx512) tag = VECTORIA_SIMD_TAG_AVX512 + tag.substr(tag.find(" |"));
+#endif
+        step.trace_tag = std::move(tag);
+    }
+
+    return plan;
+}
+
+} // namespace exec
+} // namespace vectoria
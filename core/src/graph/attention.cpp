@@ -8,7 +8,7 @@
 namespace vectoria {
 namespace graph {
 
-int add_attention_composed(ir::Graph& graph, int q_id, int k_id, int v_id) {
+int add_attention_composed(ir::Graph& graph, int q_id, int k_id, int v_id, bool fused) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
         std::vector<ir::NodeId> ins;
@@ -54,17 +54,28 @@ int add_attention_composed(ir::Graph& graph, int q_id, int k_id, int v_id) {
         throw std::runtime_error("K and V sequence length mismatch"); // In self-attention they match
     }
 
+    // Scale = 1 / sqrt(d_k), shared by both forms
+    float scale_factor = 1.0f / std::sqrt(static_cast<float>(d_k));
+
+    if (fused) {
+        ir::TensorShape fused_shape;
+        fused_shape.dims = {q_shape.dims[0], v_shape.dims[1]};
+        int attn = mk_op(ir::OpType::Attention,
+                         {static_cast<size_t>(q_id), static_cast<size_t>(k_id), static_cast<size_t>(v_id)}, fused_shape);
+        std::get<ir::OpNode>(graph.nodes[attn].data).int_params = {ir::encode_f32_param(scale_factor)};
+        return attn;
+    }
+
     // 1. K_t = Transpose(K) -> [d_k, T]
     int k_t_node = add_transpose(graph, k_id, {1, 0});
     
-    // 2. Scores = MatMul(Q, K_t) -> [T, T]
+    // 2. Scores = MatMul(Q, K_t) -> [T, S]
     int64_t seq_len = q_shape.dims[0];
     ir::TensorShape scores_shape;
-    scores_shape.dims = {seq_len, seq_len}; // Q[T, d] * K_t[d, T] -> [T, T]
+    scores_shape.dims = {seq_len, k_shape.dims[0]}; // Q[T, d] * K_t[d, S] -> [T, S] (S == T in self-attention)
     int scores_node = mk_op(ir::OpType::MatMul, {static_cast<size_t>(q_id), static_cast<size_t>(k_t_node)}, scores_shape);
 
-    // 3. Scale = 1 / sqrt(d_k)
-    float scale_factor = 1.0f / std::sqrt(static_cast<float>(d_k));
+    // 3. Scale constant
     int scale_const = mk_const(scale_factor, {});
     
     // 4. ScaledScores = Mul(Scores, Scale) -> [T, T]
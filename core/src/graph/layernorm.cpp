@@ -6,7 +6,7 @@
 namespace vectoria {
 namespace graph {
 
-int add_layernorm_composed(ir::Graph& graph, int input_id, int gamma_id, int beta_id) {
+int add_layernorm_composed(ir::Graph& graph, int input_id, int gamma_id, int beta_id, bool fused) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
         std::vector<ir::NodeId> ins;
@@ -50,6 +50,13 @@ int add_layernorm_composed(ir::Graph& graph, int input_id, int gamma_id, int bet
     int64_t last_dim_size = in_shape.dims.back();
     if (last_dim_size <= 0) throw std::runtime_error("LayerNorm last dimension invalid");
 
+    if (fused) {
+        int ln = mk_op(ir::OpType::LayerNorm,
+                       {static_cast<size_t>(input_id), static_cast<size_t>(gamma_id), static_cast<size_t>(beta_id)}, in_shape);
+        std::get<ir::OpNode>(graph.nodes[ln].data).int_params = {ir::encode_f32_param(1e-5f)};
+        return ln;
+    }
+
     // Shapes
     ir::TensorShape reduced_shape = in_shape;
     reduced_shape.dims.pop_back(); // Rank N-1
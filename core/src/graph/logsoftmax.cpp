@@ -6,7 +6,7 @@
 namespace vectoria {
 namespace graph {
 
-int add_logsoftmax_composed(ir::Graph& graph, int input_id) {
+int add_logsoftmax_composed(ir::Graph& graph, int input_id, bool fused) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
         std::vector<ir::NodeId> ins;
@@ -27,6 +27,8 @@ int add_logsoftmax_composed(ir::Graph& graph, int input_id) {
     ir::TensorShape in_shape = get_shape(input_id);
     if (in_shape.dims.empty()) throw std::runtime_error("LogSoftmax input cannot be empty");
 
+    if (fused) return mk_op(ir::OpType::LogSoftmax, {static_cast<size_t>(input_id)}, in_shape);
+
     // Shapes
     ir::TensorShape reduced_shape = in_shape;
     reduced_shape.dims.pop_back(); // Rank N-1
@@ -1,10 +1,12 @@
 #include "vectoria/graph/multi_head_attention.hpp"
 #include "vectoria/graph/attention.hpp"
+#include "vectoria/graph/stable_softmax.hpp"
 #include "vectoria/graph/transpose.hpp"
 #include "vectoria/graph/reshape.hpp"
 #include "vectoria/graph/slice.hpp"
 #include "vectoria/graph/concatenation.hpp"
 #include <stdexcept>
+#include <cmath>
 #include <variant>
 
 namespace vectoria {
@@ -14,7 +16,9 @@ int add_multi_head_attention_composed(
     ir::Graph& graph, 
     int x_id, 
     int w_q_id, int w_k_id, int w_v_id, int w_o_id, 
-    int num_heads
+    int num_heads,
+    bool fused_attention,
+    bool batched_heads
 ) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
@@ -50,10 +54,40 @@ int add_multi_head_attention_composed(
     int k_split = add_reshape(graph, k_all, split_view.dims);
     int v_split = add_reshape(graph, v_all, split_view.dims);
 
+    // The batched path reads K as [h, d_k, T] instead (built below)
+    const bool batched = batched_heads && !fused_attention;
     int q_trans = add_transpose(graph, q_split, {1, 0, 2});
-    int k_trans = add_transpose(graph, k_split, {1, 0, 2});
+    int k_trans = batched ? -1 : add_transpose(graph, k_split, {1, 0, 2});
     int v_trans = add_transpose(graph, v_split, {1, 0, 2});
 
+    if (batched) {
+        // 3'. All heads at once: two BatchedMatMuls over [h, T, *]
+        // K^T per head: [T, h, d_k] -> [h, d_k, T]
+        int k_heads_t = add_transpose(graph, k_split, {1, 2, 0});
+
+        // Scores = Q_h K_h^T -> [h, T, T]
+        ir::TensorShape scores_shape; scores_shape.dims = {static_cast<int64_t>(num_heads), seq_len, seq_len};
+        int scores = mk_op(ir::OpType::BatchedMatMul, {static_cast<size_t>(q_trans), static_cast<size_t>(k_heads_t)}, scores_shape);
+
+        // Scaled by 1 / sqrt(d_k) (rank-0 constant), softmax over the last axis
+        size_t scale_id = graph.nodes.size();
+        ir::ConstantNode scale_const;
+        scale_const.dtype = ir::DataType::Float32;
+        scale_const.data_f32 = {1.0f / std::sqrt(static_cast<float>(d_k))};
+        graph.nodes.push_back({ {scale_id}, scale_const });
+        int scaled = mk_op(ir::OpType::Mul, {static_cast<size_t>(scores), scale_id}, scores_shape);
+        int probs = add_softmax_stable_composed(graph, scaled);
+
+        // Context = P_h V_h -> [h, T, d_k], back to [T, h, d_k] -> [T, d_model]
+        ir::TensorShape ctx_shape; ctx_shape.dims = {static_cast<int64_t>(num_heads), seq_len, d_k};
+        int ctx = mk_op(ir::OpType::BatchedMatMul, {static_cast<size_t>(probs), static_cast<size_t>(v_trans)}, ctx_shape);
+        int ctx_t = add_transpose(graph, ctx, {1, 0, 2});
+        int merged = add_reshape(graph, ctx_t, {seq_len, d_model});
+
+        ir::TensorShape final_shape; final_shape.dims = {seq_len, d_model};
+        return mk_op(ir::OpType::MatMul, {static_cast<size_t>(merged), static_cast<size_t>(w_o_id)}, final_shape);
+    }
+
     // 3. Per-head Attention
     std::vector<int> head_outputs;
     for (int h = 0; h < num_heads; ++h) {
@@ -68,7 +102,7 @@ int add_multi_head_attention_composed(
         int k_h_2d = add_reshape(graph, k_h, head_shape.dims);
         int v_h_2d = add_reshape(graph, v_h, head_shape.dims);
 
-        int head_out = add_attention_composed(graph, q_h_2d, k_h_2d, v_h_2d);
+        int head_out = add_attention_composed(graph, q_h_2d, k_h_2d, v_h_2d, fused_attention);
         head_outputs.push_back(head_out);
     }
 
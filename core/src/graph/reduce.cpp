@@ -0,0 +1,43 @@
+#include "vectoria/graph/reduce.hpp"
+#include <stdexcept>
+#include <variant>
+
+namespace vectoria {
+namespace graph {
+
+int add_reduce(ir::Graph& graph, ir::OpType op_type, int input_id, int64_t axis) {
+    if (op_type != ir::OpType::ReduceSum && op_type != ir::OpType::ReduceMax && op_type != ir::OpType::ReduceMeanVar) {
+        throw std::runtime_error("add_reduce expects ReduceSum, ReduceMax or ReduceMeanVar");
+    }
+    const auto& n = graph.nodes[input_id];
+    ir::TensorShape in_shape;
+    ir::DataType dtype;
+
+    if (auto* i = std::get_if<ir::InputNode>(&n.data)) { in_shape = i->shape; dtype = i->dtype; }
+    else if (auto* p = std::get_if<ir::ParameterNode>(&n.data)) { in_shape = p->shape; dtype = p->dtype; }
+    else if (auto* c = std::get_if<ir::ConstantNode>(&n.data)) { in_shape = c->shape; dtype = c->dtype; }
+    else if (auto* o = std::get_if<ir::OpNode>(&n.data)) { in_shape = o->output_shape; dtype = o->output_dtype; }
+    else throw std::runtime_error("Invalid input node for reduction");
+
+    const int64_t rank = static_cast<int64_t>(in_shape.dims.size());
+    if (axis < 0) axis += rank;
+    if (axis < 0 || axis >= rank) throw std::runtime_error("Reduction axis out of range");
+
+    ir::TensorShape out_shape = in_shape;
+    out_shape.dims.erase(out_shape.dims.begin() + axis);
+    if (op_type == ir::OpType::ReduceMeanVar) out_shape.dims.insert(out_shape.dims.begin(), 2);
+
+    size_t id = graph.nodes.size();
+    ir::OpNode op;
+    op.op = op_type;
+    op.inputs = {{static_cast<size_t>(input_id)}};
+    op.output_shape = out_shape;
+    op.output_dtype = dtype;
+    op.int_params = {axis};
+
+    graph.nodes.push_back({ {id}, op });
+    return static_cast<int>(id);
+}
+
+} // namespace graph
+} // namespace vectoria
@@ -5,7 +5,7 @@
 namespace vectoria {
 namespace graph {
 
-int add_softmax_composed(ir::Graph& graph, int input_id) {
+int add_softmax_composed(ir::Graph& graph, int input_id, bool fused) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
         std::vector<ir::NodeId> ins;
@@ -25,6 +25,8 @@ int add_softmax_composed(ir::Graph& graph, int input_id) {
     ir::TensorShape in_shape = get_shape(input_id);
     if (in_shape.dims.empty()) throw std::runtime_error("Softmax input cannot be empty");
 
+    if (fused) return mk_op(ir::OpType::Softmax, {static_cast<size_t>(input_id)}, in_shape);
+
     // reduce_max(x, axis=-1) -> [Outer] (assuming last dim reduced)
     ir::TensorShape reduced_shape = in_shape;
     reduced_shape.dims.pop_back(); 
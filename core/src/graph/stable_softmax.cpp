@@ -7,7 +7,7 @@
 namespace vectoria {
 namespace graph {
 
-int add_softmax_stable_composed(ir::Graph& graph, int input_id) {
+int add_softmax_stable_composed(ir::Graph& graph, int input_id, bool fused) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
         std::vector<ir::NodeId> ins;
@@ -25,6 +25,12 @@ int add_softmax_stable_composed(ir::Graph& graph, int input_id) {
         return {};
     };
 
+    if (fused) {
+        ir::TensorShape in_shape = get_shape(input_id);
+        if (in_shape.dims.empty()) throw std::runtime_error("Softmax input cannot be empty");
+        return mk_op(ir::OpType::Softmax, {static_cast<size_t>(input_id)}, in_shape);
+    }
+
     // 1. LogSoftmax
     int log_softmax_node = add_logsoftmax_composed(graph, input_id);
 
@@ -13,7 +13,12 @@ int add_transformer_encoder_composed(
     int w_q_id, int w_k_id, int w_v_id, int w_o_id, int num_heads,
     int gamma1_id, int beta1_id,
     int w1_id, int b1_id, int w2_id, int b2_id,
-    int gamma2_id, int beta2_id
+    int gamma2_id, int beta2_id,
+    bool fuse_ffn,
+    bool fuse_layernorm,
+    bool fuse_attention,
+    bool batch_heads,
+    int w1_scales_id, int w2_scales_id
 ) {
     auto mk_op = [&](ir::OpType type, std::vector<size_t> inputs, const ir::TensorShape& out_shape) {
         size_t id = graph.nodes.size();
@@ -38,11 +43,11 @@ int add_transformer_encoder_composed(
     int64_t d_model = x_shape.dims[1];
 
     // 1. Multi-Head Attention
-    int mha_out = add_multi_head_attention_composed(graph, x_id, w_q_id, w_k_id, w_v_id, w_o_id, num_heads);
+    int mha_out = add_multi_head_attention_composed(graph, x_id, w_q_id, w_k_id, w_v_id, w_o_id, num_heads, fuse_attention, batch_heads);
 
     // 2. Residual + LayerNorm 1
     int add1 = mk_op(ir::OpType::Add, {static_cast<size_t>(x_id), static_cast<size_t>(mha_out)}, x_shape);
-    int ln1 = add_layernorm_composed(graph, add1, gamma1_id, beta1_id);
+    int ln1 = add_layernorm_composed(graph, add1, gamma1_id, beta1_id, fuse_layernorm);
 
     // 3. FFN: Linear1 -> ReLU -> Linear2
     ir::TensorShape w1_shape = get_shape(w1_id);
@@ -50,17 +55,43 @@ int add_transformer_encoder_composed(
     int64_t d_ff = w1_shape.dims[1];
 
     ir::TensorShape ffn1_shape; ffn1_shape.dims = {seq_len, d_ff};
-    int ffn1_mm = mk_op(ir::OpType::MatMul, {static_cast<size_t>(ln1), static_cast<size_t>(w1_id)}, ffn1_shape);
-    int ffn1_bias = mk_op(ir::OpType::BiasAdd, {static_cast<size_t>(ffn1_mm), static_cast<size_t>(b1_id)}, ffn1_shape);
-    int ffn1_relu = mk_op(ir::OpType::Relu, {static_cast<size_t>(ffn1_bias)}, ffn1_shape);
-
     ir::TensorShape ffn2_shape; ffn2_shape.dims = {seq_len, d_model};
-    int ffn2_mm = mk_op(ir::OpType::MatMul, {static_cast<size_t>(ffn1_relu), static_cast<size_t>(w2_id)}, ffn2_shape);
-    int ffn2_bias = mk_op(ir::OpType::BiasAdd, {static_cast<size_t>(ffn2_mm), static_cast<size_t>(b2_id)}, ffn2_shape);
+    int ffn2_bias = -1;
+
+    const bool quantized_ffn = (w1_scales_id >= 0);
+    if (quantized_ffn != (w2_scales_id >= 0)) {
+        throw std::runtime_error("Quantized FFN needs the scales of both W1 and W2");
+    }
+
+    if (quantized_ffn) {
+        auto mk_linear = [&](size_t in, int w, int scales, int b, ir::LinearEpilogue epilogue, const ir::TensorShape& out_shape) {
+            int id = mk_op(ir::OpType::QuantizedLinear,
+                           {in, static_cast<size_t>(w), static_cast<size_t>(scales), static_cast<size_t>(b)}, out_shape);
+            std::get<ir::OpNode>(graph.nodes[id].data).int_params = {static_cast<int64_t>(epilogue)};
+            return id;
+        };
+        int ffn1 = mk_linear(static_cast<size_t>(ln1), w1_id, w1_scales_id, b1_id, ir::LinearEpilogue::BiasRelu, ffn1_shape);
+        ffn2_bias = mk_linear(static_cast<size_t>(ffn1), w2_id, w2_scales_id, b2_id, ir::LinearEpilogue::Bias, ffn2_shape);
+    } else if (fuse_ffn) {
+        auto mk_linear = [&](size_t in, int w, int b, ir::LinearEpilogue epilogue, const ir::TensorShape& out_shape) {
+            int id = mk_op(ir::OpType::FusedLinear, {in, static_cast<size_t>(w), static_cast<size_t>(b)}, out_shape);
+            std::get<ir::OpNode>(graph.nodes[id].data).int_params = {static_cast<int64_t>(epilogue)};
+            return id;
+        };
+        int ffn1 = mk_linear(static_cast<size_t>(ln1), w1_id, b1_id, ir::LinearEpilogue::BiasRelu, ffn1_shape);
+        ffn2_bias = mk_linear(static_cast<size_t>(ffn1), w2_id, b2_id, ir::LinearEpilogue::Bias, ffn2_shape);
+    } else {
+        int ffn1_mm = mk_op(ir::OpType::MatMul, {static_cast<size_t>(ln1), static_cast<size_t>(w1_id)}, ffn1_shape);
+        int ffn1_bias = mk_op(ir::OpType::BiasAdd, {static_cast<size_t>(ffn1_mm), static_cast<size_t>(b1_id)}, ffn1_shape);
+        int ffn1_relu = mk_op(ir::OpType::Relu, {static_cast<size_t>(ffn1_bias)}, ffn1_shape);
+
+        int ffn2_mm = mk_op(ir::OpType::MatMul, {static_cast<size_t>(ffn1_relu), static_cast<size_t>(w2_id)}, ffn2_shape);
+        ffn2_bias = mk_op(ir::OpType::BiasAdd, {static_cast<size_t>(ffn2_mm), static_cast<size_t>(b2_id)}, ffn2_shape);
+    }
 
     // 4. Residual + LayerNorm 2
     int add2 = mk_op(ir::OpType::Add, {static_cast<size_t>(ln1), static_cast<size_t>(ffn2_bias)}, x_shape);
-    int ln2 = add_layernorm_composed(graph, add2, gamma2_id, beta2_id);
+    int ln2 = add_layernorm_composed(graph, add2, gamma2_id, beta2_id, fuse_layernorm);
 
     return ln2;
 }
@@ -0,0 +1,66 @@
+#include "vectoria/kernel_abi.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+extern "C" {
+    VectoriaStatus reduce_max_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+}
+
+namespace {
+// 96 rows = 16 micro-kernel row blocks; the [96, 256] score block (96 KB) stays in L2.
+constexpr size_t kAttentionTileQ = 96;   // query rows per tile (accumulated in Out)
+constexpr size_t kAttentionTileK = 256;  // keys per online-softmax step
+} // namespace
+
+// Per query tile, key blocks are visited in increasing order:
+//   S = scale * Q_tile K_block^T                  (packed GEMM, K^T transposed once)
+//   per row: m' = max(m, max S), P = exp(S - m'), l = l * exp(m - m') + sum P
+//   Out_tile = Out_tile * exp(m - m') + P V_block (mul_col, then GEMM with beta = 1)
+// then Out_tile /= l. Only K^T [d, Tk] and one [TileQ, TileK] score block
+// are held besides the output; the tile order is fixed, so the result does
+// not depend on anything but the inputs.
+
+extern "C" VectoriaStatus attention_f32_avx2(const float* q, const float* k, const float* v, float* out,
+                                             size_t tq, size_t tk, size_t d, size_t dv, float scale) {
+    if (!q || !k || !v || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (tk == 0) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (tq == 0 || dv == 0) return VECTORIA_SUCCESS;
+
+    std::vector<float> k_t(d * tk + 1);
+    std::vector<float> scores(kAttentionTileQ * kAttentionTileK);
+    float m[kAttentionTileQ], l[kAttentionTileQ], correction[kAttentionTileQ];
+    if (d > 0) transpose_2d_f32_avx2(k, k_t.data(), tk, d, d, tk);
+
+    for (size_t i0 = 0; i0 < tq; i0 += kAttentionTileQ) {
+        const size_t bq = std::min(kAttentionTileQ, tq - i0);
+        float* acc = out + i0 * dv;
+        for (size_t j0 = 0; j0 < tk; j0 += kAttentionTileK) {
+            const size_t bk = std::min(kAttentionTileK, tk - j0);
+            const bool first = (j0 == 0);
+            gemm_f32_avx2_packed(q + i0 * d, k_t.data() + j0, scores.data(), bq, bk, d, d, tk, bk, scale, 0.0f);
+            for (size_t r = 0; r < bq; ++r) {
+                float* s = scores.data() + r * bk;
+                float block_max, sum;
+                reduce_max_f32_avx2(s, &block_max, 1, bk);
+                const float m_new = first ? block_max : std::max(m[r], block_max);
+                exp_shift_sum_f32_avx2(s, s, bk, &m_new, &sum);
+                if (first) {
+                    l[r] = sum;
+                } else {
+                    correction[r] = std::exp(m[r] - m_new);
+                    l[r] = l[r] * correction[r] + sum;
+                }
+                m[r] = m_new;
+            }
+            if (!first) mul_col_f32_avx2(acc, correction, acc, bq, dv);
+            gemm_f32_avx2_packed(scores.data(), v + j0 * dv, acc, bq, dv, bk, bk, dv, dv, 1.0f, first ? 0.0f : 1.0f);
+        }
+        div_col_f32_avx2(acc, l, acc, bq, dv);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include "vectoria/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+namespace {
+constexpr size_t kAttentionBlockK = 64; // keys scored per online-softmax step
+} // namespace
+
+VectoriaStatus attention_f32(
+    const float* q,
+    const float* k,
+    const float* v,
+    float* output,
+    size_t tq,
+    size_t tk,
+    size_t d,
+    size_t dv,
+    float scale
+) {
+    if (!q || !k || !v || !output) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (tk == 0) return VECTORIA_ERROR_INVALID_SHAPE;
+    std::vector<float> scores(std::min(tk, kAttentionBlockK));
+    for (size_t i = 0; i < tq; ++i) {
+        const float* qi = q + i * d;
+        float* acc = output + i * dv;
+        std::fill(acc, acc + dv, 0.0f);
+        float m = -std::numeric_limits<float>::infinity();
+        float l = 0.0f;
+        for (size_t j0 = 0; j0 < tk; j0 += kAttentionBlockK) {
+            const size_t bk = std::min(kAttentionBlockK, tk - j0);
+            float block_max = -std::numeric_limits<float>::infinity();
+            for (size_t j = 0; j < bk; ++j) {
+                const float* kj = k + (j0 + j) * d;
+                float dot = 0.0f;
+                for (size_t p = 0; p < d; ++p) dot += qi[p] * kj[p];
+                scores[j] = scale * dot;
+                block_max = std::max(block_max, scores[j]);
+            }
+            // Rescale what was accumulated under the previous maximum
+            const float m_new = std::max(m, block_max);
+            if (j0 > 0) {
+                const float correction = std::exp(m - m_new);
+                l *= correction;
+                for (size_t c = 0; c < dv; ++c) acc[c] *= correction;
+            }
+            for (size_t j = 0; j < bk; ++j) {
+                const float p = std::exp(scores[j] - m_new);
+                const float* vj = v + (j0 + j) * dv;
+                l += p;
+                for (size_t c = 0; c < dv; ++c) acc[c] += p * vj[c];
+            }
+            m = m_new;
+        }
+        for (size_t c = 0; c < dv; ++c) acc[c] /= l;
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
@@ -0,0 +1,117 @@
+#include "vectoria/kernels.hpp"
+#include <cstring>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+uint16_t f32_to_f16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t exponent = (bits >> 23) & 0xffu;
+    const uint32_t mantissa = bits & 0x7fffffu;
+
+    if (exponent == 0xffu) {
+        // Inf stays Inf; NaN keeps its top payload bits and becomes quiet.
+        return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? (0x200u | (mantissa >> 13)) : 0u));
+    }
+
+    // Unbiased exponent; half normals cover [-14, 15].
+    const int32_t e = static_cast<int32_t>(exponent) - 127;
+    if (e > 15) return static_cast<uint16_t>(sign | 0x7c00u);
+
+    // Rounding is to nearest, ties to even. A carry out of the mantissa bumps
+    // the exponent, which is exactly the next representable value (or Inf).
+    uint32_t half;
+    uint32_t rest;
+    uint32_t halfway;
+    if (e >= -14) {
+        half = (static_cast<uint32_t>(e + 15) << 10) | (mantissa >> 13);
+        rest = mantissa & 0x1fffu;
+        halfway = 0x1000u;
+    } else {
+        // Subnormal half: count units of 2^-24, implicit 1 included. Below
+        // 2^-25 (half the smallest subnormal) everything rounds to zero.
+        if (e < -25) return sign;
+        const uint32_t shift = static_cast<uint32_t>(-1 - e);  // 14 .. 24
+        const uint32_t full = mantissa | 0x800000u;
+        half = full >> shift;
+        rest = full & ((1u << shift) - 1u);
+        halfway = 1u << (shift - 1);
+    }
+    if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float f16_to_f32(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1fu;
+    const uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0x1fu) {
+        // Inf, or a NaN made quiet like F16C's vcvtph2ps does.
+        bits = sign | 0x7f800000u | (mantissa << 13) | (mantissa ? 0x00400000u : 0u);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal half: normalize into a float normal.
+        uint32_t m = mantissa;
+        uint32_t e = 113;
+        while (!(m & 0x400u)) {
+            m <<= 1;
+            --e;
+        }
+        bits = sign | (e << 23) | ((m & 0x3ffu) << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+VectoriaStatus convert_f32_to_f16(const float* input, uint16_t* output, size_t count) {
+    if (count && (!input || !output)) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i = 0; i < count; ++i) output[i] = f32_to_f16(input[i]);
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus convert_f16_to_f32(const uint16_t* input, float* output, size_t count) {
+    if (count && (!input || !output)) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i = 0; i < count; ++i) output[i] = f16_to_f32(input[i]);
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus gemm_f16w_f32(
+    const float* a,
+    const uint16_t* b,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta
+) {
+    if (!a || !b || !c) {
+        return VECTORIA_ERROR_INVALID_SHAPE;
+    }
+
+    // gemm_f32's loop with each weight widened exactly on load.
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            float sum = 0.0f;
+            for (size_t p = 0; p < k; ++p) {
+                float val_a = a[i * lda + p];
+                float val_b = f16_to_f32(b[p * ldb + j]);
+                sum += val_a * val_b;
+            }
+            size_t c_idx = i * ldc + j;
+            c[c_idx] = (beta == 0.0f) ? alpha * sum : alpha * sum + beta * c[c_idx];
+        }
+    }
+
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
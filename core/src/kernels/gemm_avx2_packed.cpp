@@ -0,0 +1,330 @@
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/memory.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+namespace {
+
+// Register tiles of the micro-kernels, and cache blocking: a KC x NR B
+// panel stays in L1 (24 KB for AVX2, 48 KB for AVX-512), the MC x KC A
+// block (144 KB) in L2 and the KC x NC B block (1.5 MB) in L3. Both tiers
+// split K at the same KC, so they produce the same bits.
+using MicroKernel = VectoriaStatus (*)(const float*, const float*, float*, size_t, size_t, uint64_t,
+                                       float, float, const float*);
+
+struct Avx2Tile {
+    static constexpr size_t MR = 6;
+    static constexpr size_t NR = 16;
+    static constexpr MicroKernel kernel = gemm_f32_avx2_kernel_6x16;
+};
+
+struct Avx512Tile {
+    static constexpr size_t MR = 12;
+    static constexpr size_t NR = 32;
+    static constexpr MicroKernel kernel = gemm_f32_avx512_kernel_12x32;
+};
+
+constexpr size_t kGemmKC = 384;
+constexpr size_t kGemmMC = 96;
+constexpr size_t kGemmNC = 1024;
+
+constexpr uint64_t kContinue = 1; // Reload partial sums from C
+constexpr uint64_t kFinal = 2;    // Last K block: apply alpha / beta
+constexpr uint64_t kBias = 4;     // Final block: add bias[j]
+constexpr uint64_t kRelu = 8;     // Final block: max(x, 0)
+
+// Packs a kc-deep slice of `rows` rows of A into MR-row panels:
+// panel p holds, for each k, rows p*MR .. p*MR+MR-1 (zero padded).
+template <size_t MR>
+void pack_a(const float* a, size_t lda, size_t rows, size_t kc, float* out) {
+    for (size_t i0 = 0; i0 < rows; i0 += MR) {
+        const size_t mr = std::min(MR, rows - i0);
+        for (size_t p = 0; p < kc; ++p) {
+            size_t r = 0;
+            for (; r < mr; ++r) out[r] = a[(i0 + r) * lda + p];
+            for (; r < MR; ++r) out[r] = 0.0f;
+            out += MR;
+        }
+    }
+}
+
+// Packs kc rows of `cols` columns of B into NR-column panels:
+// panel p holds, for each k, columns p*NR .. p*NR+NR-1 (zero padded).
+template <size_t NR>
+void pack_b(const float* b, size_t ldb, size_t kc, size_t cols, float* out) {
+    for (size_t j0 = 0; j0 < cols; j0 += NR) {
+        const size_t nr = std::min(NR, cols - j0);
+        for (size_t p = 0; p < kc; ++p) {
+            const float* src = b + p * ldb + j0;
+            std::memcpy(out, src, nr * sizeof(float));
+            std::fill(out + nr, out + NR, 0.0f);
+            out += NR;
+        }
+    }
+}
+
+// pack_a for A stored transposed ([k, rows], row stride lda): the rows of
+// a panel are contiguous for each k.
+template <size_t MR>
+void pack_a_trans(const float* a, size_t lda, size_t rows, size_t kc, float* out) {
+    for (size_t i0 = 0; i0 < rows; i0 += MR) {
+        const size_t mr = std::min(MR, rows - i0);
+        for (size_t p = 0; p < kc; ++p) {
+            std::memcpy(out, a + p * lda + i0, mr * sizeof(float));
+            std::fill(out + mr, out + MR, 0.0f);
+            out += MR;
+        }
+    }
+}
+
+// pack_b for B stored transposed ([cols, k], row stride ldb): each column
+// of a panel is one contiguous source row.
+template <size_t NR>
+void pack_b_trans(const float* b, size_t ldb, size_t kc, size_t cols, float* out) {
+    for (size_t j0 = 0; j0 < cols; j0 += NR) {
+        const size_t nr = std::min(NR, cols - j0);
+        for (size_t c = 0; c < NR; ++c) {
+            const float* src = b + (j0 + c) * ldb;
+            if (c < nr) {
+                for (size_t p = 0; p < kc; ++p) out[p * NR + c] = src[p];
+            } else {
+                for (size_t p = 0; p < kc; ++p) out[p * NR + c] = 0.0f;
+            }
+        }
+        out += kc * NR;
+    }
+}
+
+// pack_b for FP16 weights: full 16-column panels are widened by F16C while
+// packing, other panels row by row (zero padded).
+template <size_t NR>
+void pack_b_half(const uint16_t* b, size_t ldb, size_t kc, size_t cols, float* out) {
+    for (size_t j0 = 0; j0 < cols; j0 += NR) {
+        const size_t nr = std::min(NR, cols - j0);
+        if (NR == 16 && nr == NR) {
+            pack_b_f16_avx2(b + j0, ldb, kc, out);
+            out += kc * NR;
+            continue;
+        }
+        for (size_t p = 0; p < kc; ++p) {
+            convert_f16_f32_avx2(b + p * ldb + j0, out, nr);
+            std::fill(out + nr, out + NR, 0.0f);
+            out += NR;
+        }
+    }
+}
+
+size_t round_up(size_t v, size_t to) { return (v + to - 1) / to * to; }
+
+// C = alpha * op(A) * op(B) + beta * C, then the epilogue bits of
+// `epilogue` (kBias / kRelu) on the final K block. `trans` and `b_half`
+// (FP16 B, read instead of `b`) only change how panels are packed.
+// k must be > 0. Tile selects the micro-kernel (Avx2Tile, Avx512Tile).
+template <typename Tile>
+void gemm_packed(
+    const float* a, const float* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta, const float* bias, uint64_t epilogue,
+    uint32_t trans = VECTORIA_GEMM_TRANS_NONE, const uint16_t* b_half = nullptr
+) {
+    const bool trans_a = (trans & VECTORIA_GEMM_TRANS_A) != 0;
+    const bool trans_b = (trans & VECTORIA_GEMM_TRANS_B) != 0;
+    constexpr size_t MR = Tile::MR;
+    constexpr size_t NR = Tile::NR;
+
+    // Pack buffers are reused across calls; each executor thread has its own.
+    thread_local vectoria::memory::Arena pack_arena(4 * 1024 * 1024);
+
+    // Splitting K keeps the raw partial sums in C between blocks, which is
+    // only possible when C's old value is not needed (beta == 0). Either way
+    // every element sees the same FMA sequence as the unblocked kernel.
+    const size_t kc_max = (beta == 0.0f) ? kGemmKC : k;
+
+    alignas(64) float edge[MR * NR] = {};
+    alignas(64) float edge_bias[NR] = {};
+
+    for (size_t jc = 0; jc < n; jc += kGemmNC) {
+        const size_t nc = std::min(kGemmNC, n - jc);
+        for (size_t pc = 0; pc < k; pc += kc_max) {
+            const size_t kc = std::min(kc_max, k - pc);
+            const uint64_t flags = (pc > 0 ? kContinue : 0) | (pc + kc == k ? kFinal | epilogue : 0);
+
+            pack_arena.reset();
+            float* b_pack = static_cast<float*>(pack_arena.allocate(round_up(nc, NR) * kc * sizeof(float), 64));
+            float* a_pack = static_cast<float*>(
+                pack_arena.allocate(round_up(std::min(kGemmMC, m), MR) * kc * sizeof(float), 64));
+            if (b_half) {
+                pack_b_half<NR>(b_half + pc * ldb + jc, ldb, kc, nc, b_pack);
+            } else if (trans_b) {
+                pack_b_trans<NR>(b + jc * ldb + pc, ldb, kc, nc, b_pack);
+            } else {
+                pack_b<NR>(b + pc * ldb + jc, ldb, kc, nc, b_pack);
+            }
+
+            for (size_t ic = 0; ic < m; ic += kGemmMC) {
+                const size_t mc = std::min(kGemmMC, m - ic);
+                if (trans_a) {
+                    pack_a_trans<MR>(a + pc * lda + ic, lda, mc, kc, a_pack);
+                } else {
+                    pack_a<MR>(a + ic * lda + pc, lda, mc, kc, a_pack);
+                }
+
+                for (size_t jr = 0; jr < nc; jr += NR) {
+                    const size_t nr = std::min(NR, nc - jr);
+                    const float* b_panel = b_pack + jr * kc;
+                    const float* bias_panel = (flags & kBias) ? bias + jc + jr : nullptr;
+                    if (bias_panel && nr < NR) {
+                        std::memcpy(edge_bias, bias_panel, nr * sizeof(float));
+                        bias_panel = edge_bias;
+                    }
+                    for (size_t ir = 0; ir < mc; ir += MR) {
+                        const size_t mr = std::min(MR, mc - ir);
+                        const float* a_panel = a_pack + ir * kc;
+                        float* c_tile = c + (ic + ir) * ldc + jc + jr;
+
+                        if (mr == MR && nr == NR) {
+                            Tile::kernel(a_panel, b_panel, c_tile, kc, ldc, flags, alpha, beta, bias_panel);
+                            continue;
+                        }
+
+                        // Partial tile: run the full kernel on a scratch tile.
+                        const bool reads_c = (flags & kContinue) || ((flags & kFinal) && !(beta == 0.0f));
+                        if (reads_c) {
+                            for (size_t r = 0; r < mr; ++r) {
+                                std::memcpy(edge + r * NR, c_tile + r * ldc, nr * sizeof(float));
+                            }
+                        }
+                        Tile::kernel(a_panel, b_panel, edge, kc, NR, flags, alpha, beta, bias_panel);
+                        for (size_t r = 0; r < mr; ++r) {
+                            std::memcpy(c_tile + r * ldc, edge + r * NR, nr * sizeof(float));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Entry points shared by both tiers; the argument checks and empty-K
+// paths do not depend on the micro-kernel.
+template <typename Tile>
+VectoriaStatus gemm_entry(
+    const float* a, const float* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta, uint32_t trans
+) {
+    if (trans & ~uint32_t(VECTORIA_GEMM_TRANS_A | VECTORIA_GEMM_TRANS_B)) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (m == 0 || n == 0) return VECTORIA_SUCCESS;
+    // Empty K never reads A or B: only the scaling of C remains.
+    if (k == 0) return gemm_f32_avx2(a, b, c, m, n, k, lda, ldb, ldc, alpha, beta);
+    gemm_packed<Tile>(a, b, c, m, n, k, lda, ldb, ldc, alpha, beta, nullptr, 0, trans);
+    return VECTORIA_SUCCESS;
+}
+
+template <typename Tile>
+VectoriaStatus linear_entry(
+    const float* a, const float* b, const float* bias, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+) {
+    uint64_t flags = 0;
+    switch (epilogue) {
+        case VECTORIA_EPILOGUE_NONE: break;
+        case VECTORIA_EPILOGUE_BIAS: flags = kBias; break;
+        case VECTORIA_EPILOGUE_BIAS_RELU: flags = kBias | kRelu; break;
+        default: return VECTORIA_ERROR_INVALID_SHAPE;
+    }
+    if ((flags & kBias) && !bias) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (m == 0 || n == 0) return VECTORIA_SUCCESS;
+
+    if (k == 0) {
+        // Empty K: every sum is +0, the epilogue still applies.
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                float v = 0.0f;
+                if (flags & kBias) v = v + bias[j];
+                if (flags & kRelu) v = std::max(0.0f, v);
+                c[i * ldc + j] = v;
+            }
+        }
+        return VECTORIA_SUCCESS;
+    }
+    gemm_packed<Tile>(a, b, c, m, n, k, lda, ldb, ldc, 1.0f, 0.0f, bias, flags);
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace
+
+extern "C" VectoriaStatus gemm_f32_avx2_packed(
+    const float* a, const float* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta
+) {
+    return gemm_entry<Avx2Tile>(a, b, c, m, n, k, lda, ldb, ldc, alpha, beta, VECTORIA_GEMM_TRANS_NONE);
+}
+
+extern "C" VectoriaStatus gemm_trans_f32_avx2_packed(
+    const float* a, const float* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta, uint32_t trans
+) {
+    return gemm_entry<Avx2Tile>(a, b, c, m, n, k, lda, ldb, ldc, alpha, beta, trans);
+}
+
+extern "C" VectoriaStatus gemm_f16w_f32_avx2_packed(
+    const float* a, const uint16_t* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta
+) {
+    if (m == 0 || n == 0) return VECTORIA_SUCCESS;
+    // Empty K never reads B: only the scaling of C remains.
+    if (k == 0) return gemm_f32_avx2(a, nullptr, c, m, n, k, lda, ldb, ldc, alpha, beta);
+    gemm_packed<Avx2Tile>(a, nullptr, c, m, n, k, lda, ldb, ldc, alpha, beta, nullptr, 0, VECTORIA_GEMM_TRANS_NONE, b);
+    return VECTORIA_SUCCESS;
+}
+
+extern "C" VectoriaStatus linear_f32_avx2(
+    const float* a, const float* b, const float* bias, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+) {
+    return linear_entry<Avx2Tile>(a, b, bias, c, m, n, k, lda, ldb, ldc, epilogue);
+}
+
+extern "C" VectoriaStatus gemm_f32_avx512_packed(
+    const float* a, const float* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta
+) {
+    return gemm_entry<Avx512Tile>(a, b, c, m, n, k, lda, ldb, ldc, alpha, beta, VECTORIA_GEMM_TRANS_NONE);
+}
+
+extern "C" VectoriaStatus gemm_trans_f32_avx512_packed(
+    const float* a, const float* b, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta, uint32_t trans
+) {
+    return gemm_entry<Avx512Tile>(a, b, c, m, n, k, lda, ldb, ldc, alpha, beta, trans);
+}
+
+extern "C" VectoriaStatus linear_f32_avx512(
+    const float* a, const float* b, const float* bias, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+) {
+    return linear_entry<Avx512Tile>(a, b, bias, c, m, n, k, lda, ldb, ldc, epilogue);
+}
+
+#endif
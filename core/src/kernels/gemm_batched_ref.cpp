@@ -0,0 +1,28 @@
+#include "vectoria/kernels.hpp"
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+VectoriaStatus gemm_batched_f32(
+    const float* a,
+    const float* b,
+    float* c,
+    size_t batch,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    size_t stride_a, size_t stride_b, size_t stride_c,
+    gemm_f32_t gemm
+) {
+    if (!a || !b || !c || !gemm) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i = 0; i < batch; ++i) {
+        VectoriaStatus status = gemm(a + i * stride_a, b + i * stride_b, c + i * stride_c,
+                                     m, n, k, lda, ldb, ldc, 1.0f, 0.0f);
+        if (status != VECTORIA_SUCCESS) return status;
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
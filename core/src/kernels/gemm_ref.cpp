@@ -31,8 +31,46 @@ VectoriaStatus gemm_f32(
             }
             
             // C = alpha * sum + beta * C
+            // As in BLAS, C is not read when beta is zero: planned buffers
+            // may hold stale (or uninitialized) data, and 0 * NaN is NaN.
             size_t c_idx = i * ldc + j;
-            c[c_idx] = alpha * sum + beta * c[c_idx];
+            c[c_idx] = (beta == 0.0f) ? alpha * sum : alpha * sum + beta * c[c_idx];
+        }
+    }
+
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus gemm_trans_f32(
+    const float* a,
+    const float* b,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    float alpha, float beta,
+    uint32_t trans
+) {
+    if (!a || !b || !c || (trans & ~uint32_t(VECTORIA_GEMM_TRANS_A | VECTORIA_GEMM_TRANS_B))) {
+        return VECTORIA_ERROR_INVALID_SHAPE;
+    }
+
+    // Element strides of op(A) / op(B) along (row, col).
+    const bool trans_a = (trans & VECTORIA_GEMM_TRANS_A) != 0;
+    const bool trans_b = (trans & VECTORIA_GEMM_TRANS_B) != 0;
+    const size_t a_row = trans_a ? 1 : lda, a_col = trans_a ? lda : 1;
+    const size_t b_row = trans_b ? 1 : ldb, b_col = trans_b ? ldb : 1;
+
+    // Same loop nest and summation order as gemm_f32.
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            float sum = 0.0f;
+            for (size_t p = 0; p < k; ++p) {
+                float val_a = a[i * a_row + p * a_col];
+                float val_b = b[p * b_row + j * b_col];
+                sum += val_a * val_b;
+            }
+            size_t c_idx = i * ldc + j;
+            c[c_idx] = (beta == 0.0f) ? alpha * sum : alpha * sum + beta * c[c_idx];
         }
     }
 
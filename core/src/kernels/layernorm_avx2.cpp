@@ -0,0 +1,28 @@
+#include "vectoria/kernel_abi.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+// Each row: shifted moments (layernorm_moments), then one normalize / scale /
+// shift pass (layernorm_apply). Same statistics as the Reference twin in
+// layernorm_ref.cpp; only the summation order differs (8 lanes, fixed reduction).
+
+extern "C" VectoriaStatus layernorm_f32_avx2(const float* in, const float* gamma, const float* beta,
+                                             float* out, size_t outer, size_t inner, float epsilon) {
+    if (!in || !gamma || !beta || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (inner == 0) return VECTORIA_SUCCESS;
+    const float n = static_cast<float>(inner);
+    for (size_t i = 0; i < outer; ++i) {
+        const float* x = in + i * inner;
+        float sums[2];
+        layernorm_moments_f32_avx2(x, inner, x, sums);
+        const float mean = x[0] + sums[0] / n;
+        const float var = std::max(0.0f, (sums[1] - sums[0] * (sums[0] / n)) / n);
+        const float stats[2] = {mean, 1.0f / std::sqrt(var + epsilon)};
+        layernorm_apply_f32_avx2(x, gamma, beta, out + i * inner, inner, stats);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "vectoria/kernels.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+VectoriaStatus layernorm_f32(
+    const float* input,
+    const float* gamma,
+    const float* beta,
+    float* output,
+    size_t outer,
+    size_t inner,
+    float epsilon
+) {
+    if (!input || !gamma || !beta || !output) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (inner == 0) return VECTORIA_SUCCESS;
+    const float n = static_cast<float>(inner);
+    for (size_t i = 0; i < outer; ++i) {
+        const float* x = input + i * inner;
+        float* y = output + i * inner;
+
+        // One read for both moments, shifted by the first element of the row
+        const float shift = x[0];
+        float s1 = 0.0f, s2 = 0.0f;
+        for (size_t j = 0; j < inner; ++j) {
+            const float d = x[j] - shift;
+            s1 += d;
+            s2 += d * d;
+        }
+        const float mean = shift + s1 / n;
+        const float var = std::max(0.0f, (s2 - s1 * (s1 / n)) / n);
+        const float inv_std = 1.0f / std::sqrt(var + epsilon);
+
+        for (size_t j = 0; j < inner; ++j) y[j] = (x[j] - mean) * inv_std * gamma[j] + beta[j];
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
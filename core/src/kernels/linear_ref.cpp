@@ -0,0 +1,46 @@
+#include "vectoria/kernels.hpp"
+#include <algorithm>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+VectoriaStatus linear_f32(
+    const float* a,
+    const float* b,
+    const float* bias,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+) {
+    if (!a || !b || !c) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (epilogue > VECTORIA_EPILOGUE_BIAS_RELU) return VECTORIA_ERROR_INVALID_SHAPE;
+
+    const bool add_bias = (epilogue != VECTORIA_EPILOGUE_NONE);
+    const bool relu = (epilogue == VECTORIA_EPILOGUE_BIAS_RELU);
+    if (add_bias && !bias) return VECTORIA_ERROR_INVALID_SHAPE;
+
+    // Same loop and operation order as gemm_f32 (alpha = 1, beta = 0),
+    // bias_add_f32 and relu_f32 applied to one element at a time.
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            float sum = 0.0f;
+            for (size_t p = 0; p < k; ++p) {
+                float val_a = a[i * lda + p];
+                float val_b = b[p * ldb + j];
+                sum += val_a * val_b;
+            }
+
+            float value = 1.0f * sum;
+            if (add_bias) value = value + bias[j];
+            if (relu) value = std::max(0.0f, value);
+            c[i * ldc + j] = value;
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
@@ -0,0 +1,188 @@
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/memory.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+namespace {
+
+// Register tile and cache blocking of the FP32 packed GEMM, with K counted
+// in pairs: a KC-pair B panel (16 columns x 2 int16 per pair) has the same
+// 24 KB as the FP32 KC x NR panel.
+constexpr size_t kS8MR = 6;
+constexpr size_t kS8NR = 16;
+constexpr size_t kS8KC = 384;
+constexpr size_t kS8MC = 96;
+constexpr size_t kS8NC = 1024;
+
+constexpr uint64_t kContinue = 1; // Reload int32 sums from C
+constexpr uint64_t kFinal = 2;    // Last K block: dequantize
+constexpr uint64_t kBias = 4;     // Final block: add bias[j]
+constexpr uint64_t kRelu = 8;     // Final block: max(x, 0)
+
+size_t round_up(size_t v, size_t to) { return (v + to - 1) / to * to; }
+
+// Packs pairs [p0, p0 + kp) of `rows` quantized rows (row stride ldq) into
+// kS8MR-row panels: for each pair, the two values of every row (zero past
+// k and past the last row).
+void pack_a_s8(const int8_t* q, size_t ldq, size_t rows, size_t k, size_t p0, size_t kp, int16_t* out) {
+    const size_t full = std::min(p0 + kp, k / 2) - std::min(p0, k / 2);
+    for (size_t i0 = 0; i0 < rows; i0 += kS8MR) {
+        const size_t mr = std::min(kS8MR, rows - i0);
+        for (size_t r = 0; r < kS8MR; ++r) {
+            int16_t* dst = out + 2 * r;
+            if (r >= mr) {
+                for (size_t p = 0; p < kp; ++p) dst[p * 2 * kS8MR] = dst[p * 2 * kS8MR + 1] = 0;
+                continue;
+            }
+            const int8_t* src = q + (i0 + r) * ldq + 2 * p0;
+            for (size_t p = 0; p < full; ++p) {
+                dst[p * 2 * kS8MR] = src[2 * p];
+                dst[p * 2 * kS8MR + 1] = src[2 * p + 1];
+            }
+            if (full < kp) {
+                // Odd k: the last pair has one value.
+                dst[full * 2 * kS8MR] = src[2 * full];
+                dst[full * 2 * kS8MR + 1] = 0;
+            }
+        }
+        out += kp * 2 * kS8MR;
+    }
+}
+
+// Packs pairs [p0, p0 + kp) of `cols` columns of B into kS8NR-column
+// panels. Full panels are widened by pack_b_s8_avx2; the right edge panel
+// and an odd last row go through the scalar loop (zero padded).
+void pack_b_s8(const int8_t* b, size_t ldb, size_t k, size_t p0, size_t kp, size_t cols, int16_t* out) {
+    for (size_t j0 = 0; j0 < cols; j0 += kS8NR) {
+        const size_t nr = std::min(kS8NR, cols - j0);
+        size_t p = p0;
+        if (nr == kS8NR) {
+            const size_t full = std::min(p0 + kp, k / 2) - std::min(p0, k / 2);
+            pack_b_s8_avx2(b + 2 * p0 * ldb + j0, ldb, full, out);
+            out += full * 2 * kS8NR;
+            p += full;
+        }
+        for (; p < p0 + kp; ++p) {
+            const int8_t* row0 = b + 2 * p * ldb + j0;
+            const bool has_row1 = 2 * p + 1 < k;
+            for (size_t c = 0; c < kS8NR; ++c) {
+                out[2 * c] = c < nr ? row0[c] : 0;
+                out[2 * c + 1] = (c < nr && has_row1) ? row0[ldb + c] : 0;
+            }
+            out += 2 * kS8NR;
+        }
+    }
+}
+
+} // namespace
+
+extern "C" VectoriaStatus linear_s8_f32_avx2(
+    const float* a, const int8_t* b, const float* b_scales, const float* bias, float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+) {
+    uint64_t epilogue_flags = 0;
+    switch (epilogue) {
+        case VECTORIA_EPILOGUE_NONE: break;
+        case VECTORIA_EPILOGUE_BIAS: epilogue_flags = kBias; break;
+        case VECTORIA_EPILOGUE_BIAS_RELU: epilogue_flags = kBias | kRelu; break;
+        default: return VECTORIA_ERROR_INVALID_SHAPE;
+    }
+    if (!a || !b || !b_scales || !c || k > VECTORIA_S8_MAX_K) return VECTORIA_ERROR_INVALID_SHAPE;
+    if ((epilogue_flags & kBias) && !bias) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (m == 0 || n == 0) return VECTORIA_SUCCESS;
+
+    if (k == 0) {
+        // Empty K: every sum and every row scale is 0, the epilogue still applies.
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                float v = (0.0f * 0.0f) * b_scales[j];
+                if (epilogue_flags & kBias) v = v + bias[j];
+                if (epilogue_flags & kRelu) v = std::max(0.0f, v);
+                c[i * ldc + j] = v;
+            }
+        }
+        return VECTORIA_SUCCESS;
+    }
+
+    // Each executor thread has its own buffers, reused across calls: the
+    // quantized rows live for the whole call, pack buffers per K block.
+    thread_local vectoria::memory::Arena quant_arena(1024 * 1024);
+    thread_local vectoria::memory::Arena pack_arena(4 * 1024 * 1024);
+
+    // Every row is quantized once, whatever the blocking.
+    quant_arena.reset();
+    int8_t* q = static_cast<int8_t*>(quant_arena.allocate(m * k, 64));
+    float* a_scales = static_cast<float*>(quant_arena.allocate(round_up(m, kS8MR) * sizeof(float), 64));
+    for (size_t i = 0; i < m; ++i) quantize_row_s8_avx2(a + i * lda, k, q + i * k, a_scales + i);
+    std::fill(a_scales + m, a_scales + round_up(m, kS8MR), 0.0f);
+
+    const size_t k_pairs = (k + 1) / 2;
+    alignas(32) float edge[kS8MR * kS8NR] = {};
+    alignas(32) float edge_scales[kS8NR] = {};
+    alignas(32) float edge_bias[kS8NR] = {};
+
+    for (size_t jc = 0; jc < n; jc += kS8NC) {
+        const size_t nc = std::min(kS8NC, n - jc);
+        for (size_t pc = 0; pc < k_pairs; pc += kS8KC) {
+            const size_t kp = std::min(kS8KC, k_pairs - pc);
+            const uint64_t flags = (pc > 0 ? kContinue : 0) | (pc + kp == k_pairs ? kFinal | epilogue_flags : 0);
+
+            pack_arena.reset();
+            int16_t* b_pack = static_cast<int16_t*>(pack_arena.allocate(round_up(nc, kS8NR) * kp * 2 * sizeof(int16_t), 64));
+            int16_t* a_pack = static_cast<int16_t*>(
+                pack_arena.allocate(round_up(std::min(kS8MC, m), kS8MR) * kp * 2 * sizeof(int16_t), 64));
+            pack_b_s8(b + jc, ldb, k, pc, kp, nc, b_pack);
+
+            for (size_t ic = 0; ic < m; ic += kS8MC) {
+                const size_t mc = std::min(kS8MC, m - ic);
+                pack_a_s8(q + ic * k, k, mc, k, pc, kp, a_pack);
+
+                for (size_t jr = 0; jr < nc; jr += kS8NR) {
+                    const size_t nr = std::min(kS8NR, nc - jr);
+                    const int16_t* b_panel = b_pack + jr * kp * 2;
+                    const float* scales_panel = b_scales + jc + jr;
+                    const float* bias_panel = (flags & kBias) ? bias + jc + jr : nullptr;
+                    if (nr < kS8NR) {
+                        std::memcpy(edge_scales, scales_panel, nr * sizeof(float));
+                        scales_panel = edge_scales;
+                        if (bias_panel) {
+                            std::memcpy(edge_bias, bias_panel, nr * sizeof(float));
+                            bias_panel = edge_bias;
+                        }
+                    }
+                    for (size_t ir = 0; ir < mc; ir += kS8MR) {
+                        const size_t mr = std::min(kS8MR, mc - ir);
+                        const int16_t* a_panel = a_pack + ir * kp * 2;
+                        const float* a_scale_panel = a_scales + ic + ir;
+                        float* c_tile = c + (ic + ir) * ldc + jc + jr;
+
+                        if (mr == kS8MR && nr == kS8NR) {
+                            gemm_s8_avx2_kernel_6x16(a_panel, b_panel, c_tile, kp, ldc, flags,
+                                                     a_scale_panel, scales_panel, bias_panel);
+                            continue;
+                        }
+
+                        // Partial tile: run the full kernel on a scratch tile.
+                        if (flags & kContinue) {
+                            for (size_t r = 0; r < mr; ++r) {
+                                std::memcpy(edge + r * kS8NR, c_tile + r * ldc, nr * sizeof(float));
+                            }
+                        }
+                        gemm_s8_avx2_kernel_6x16(a_panel, b_panel, edge, kp, kS8NR, flags,
+                                                 a_scale_panel, scales_panel, bias_panel);
+                        for (size_t r = 0; r < mr; ++r) {
+                            std::memcpy(c_tile + r * ldc, edge + r * kS8NR, nr * sizeof(float));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
+#endif
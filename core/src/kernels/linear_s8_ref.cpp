@@ -0,0 +1,83 @@
+#include "vectoria/kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+namespace {
+
+// Quantizes `count` values read `stride` apart; returns absmax / 127.
+// The comparisons are written so that NaNs lose (absmax) and clamp to -127,
+// exactly like vmaxps / vminps with the value as first source.
+float quantize_vector(const float* x, size_t count, size_t stride, int8_t* q, size_t q_stride) {
+    float amax = 0.0f;
+    for (size_t p = 0; p < count; ++p) {
+        const float ax = std::fabs(x[p * stride]);
+        if (ax > amax) amax = ax;
+    }
+    const float inv = amax > 0.0f ? 127.0f / amax : 0.0f;
+    for (size_t p = 0; p < count; ++p) {
+        float v = x[p * stride] * inv;
+        v = v > -127.0f ? v : -127.0f;
+        v = v < 127.0f ? v : 127.0f;
+        q[p * q_stride] = static_cast<int8_t>(std::nearbyint(v));
+    }
+    return amax / 127.0f;
+}
+
+} // namespace
+
+VectoriaStatus quantize_rows_s8(const float* a, size_t m, size_t k, size_t lda, int8_t* q, size_t ldq, float* scales) {
+    if (m && (!a || !q || !scales)) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i = 0; i < m; ++i) scales[i] = quantize_vector(a + i * lda, k, 1, q + i * ldq, 1);
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus quantize_weights_s8(const float* w, size_t k, size_t n, int8_t* q, float* scales) {
+    if (n && (!w || !q || !scales)) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t j = 0; j < n; ++j) scales[j] = quantize_vector(w + j, k, n, q + j, n);
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus linear_s8_f32(
+    const float* a,
+    const int8_t* b,
+    const float* b_scales,
+    const float* bias,
+    float* c,
+    size_t m, size_t n, size_t k,
+    size_t lda, size_t ldb, size_t ldc,
+    uint32_t epilogue
+) {
+    if (!a || !b || !b_scales || !c) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (epilogue > VECTORIA_EPILOGUE_BIAS_RELU || k > VECTORIA_S8_MAX_K) return VECTORIA_ERROR_INVALID_SHAPE;
+
+    const bool add_bias = (epilogue != VECTORIA_EPILOGUE_NONE);
+    const bool relu = (epilogue == VECTORIA_EPILOGUE_BIAS_RELU);
+    if (add_bias && !bias) return VECTORIA_ERROR_INVALID_SHAPE;
+
+    std::vector<int8_t> q(k);
+    for (size_t i = 0; i < m; ++i) {
+        const float a_scale = quantize_vector(a + i * lda, k, 1, q.data(), 1);
+        for (size_t j = 0; j < n; ++j) {
+            int32_t sum = 0;
+            for (size_t p = 0; p < k; ++p) {
+                sum += static_cast<int32_t>(q[p]) * static_cast<int32_t>(b[p * ldb + j]);
+            }
+
+            float value = static_cast<float>(sum) * a_scale;
+            value = value * b_scales[j];
+            if (add_bias) value = value + bias[j];
+            if (relu) value = std::max(0.0f, value);
+            c[i * ldc + j] = value;
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
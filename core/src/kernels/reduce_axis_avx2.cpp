@@ -0,0 +1,82 @@
+#include "vectoria/kernel_abi.hpp"
+#include <algorithm>
+#include <limits>
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+extern "C" {
+    VectoriaStatus reduce_sum_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus reduce_max_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+}
+
+// Inner == 1 is the last-axis case and runs the row kernels. Otherwise each
+// [reduced, inner] block is reduced down its rows with the columns in the
+// vector lanes (reduce_rows_avx2.S): no transpose and no horizontal sums, and
+// the same result bits as the Reference axis kernels. The row kernels
+// accumulate, so a tall block is fed in bands of kBandRows rows: a column
+// sweep then stays within a few pages instead of striding the whole block,
+// and each output still sees the rows in order.
+static constexpr size_t kBandRows = 64;
+
+template <typename RowsKernel>
+static void reduce_bands(RowsKernel kernel, const float* in, float* out, size_t reduced, size_t inner) {
+    for (size_t r = 0; r < reduced; r += kBandRows) {
+        kernel(in + r * inner, out, std::min(kBandRows, reduced - r), inner);
+    }
+}
+
+extern "C" VectoriaStatus reduce_sum_axis_f32_avx2(const float* in, float* out, size_t outer,
+                                                   size_t reduced, size_t inner) {
+    if (!in || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (inner == 1) return reduce_sum_f32_avx2(in, out, outer, reduced);
+    std::fill(out, out + outer * inner, 0.0f);
+    for (size_t o = 0; o < outer; ++o) {
+        reduce_bands(reduce_sum_rows_f32_avx2, in + o * reduced * inner, out + o * inner, reduced, inner);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+extern "C" VectoriaStatus reduce_max_axis_f32_avx2(const float* in, float* out, size_t outer,
+                                                   size_t reduced, size_t inner) {
+    if (!in || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (inner == 1) return reduce_max_f32_avx2(in, out, outer, reduced);
+    std::fill(out, out + outer * inner, -std::numeric_limits<float>::infinity());
+    for (size_t o = 0; o < outer; ++o) {
+        reduce_bands(reduce_max_rows_f32_avx2, in + o * reduced * inner, out + o * inner, reduced, inner);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+// Shifted moments as in reduce_mean_var_f32 (Reference). Rows (inner == 1)
+// use the LayerNorm moments kernel, which sums in 8 lanes; columns sum in
+// row order and give the Reference bits.
+extern "C" VectoriaStatus reduce_mean_var_f32_avx2(const float* in, float* mean, float* var, size_t outer,
+                                                   size_t reduced, size_t inner) {
+    if (!in || !mean || !var || reduced == 0) return VECTORIA_ERROR_INVALID_SHAPE;
+    const float n = static_cast<float>(reduced);
+    for (size_t o = 0; o < outer; ++o) {
+        const float* x = in + o * reduced * inner;
+        float* s1 = mean + o * inner;
+        float* s2 = var + o * inner;
+        if (inner == 1) {
+            float sums[2];
+            layernorm_moments_f32_avx2(x, reduced, x, sums);
+            s1[0] = sums[0];
+            s2[0] = sums[1];
+        } else {
+            std::fill(s1, s1 + inner, 0.0f);
+            std::fill(s2, s2 + inner, 0.0f);
+            for (size_t r = 0; r < reduced; r += kBandRows) {
+                reduce_moments_rows_f32_avx2(x + r * inner, x, s1, s2, std::min(kBandRows, reduced - r), inner);
+            }
+        }
+        for (size_t j = 0; j < inner; ++j) {
+            const float sum = s1[j];
+            s1[j] = x[j] + sum / n;
+            s2[j] = std::max(0.0f, (s2[j] - sum * (sum / n)) / n);
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#include "vectoria/kernels.hpp"
+#include <algorithm>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+VectoriaStatus reduce_mean_var_f32(
+    const float* input,
+    float* mean,
+    float* var,
+    size_t outer_dim,
+    size_t reduced_dim,
+    size_t inner_dim
+) {
+    if (!input || !mean || !var || reduced_dim == 0) return VECTORIA_ERROR_INVALID_SHAPE;
+    const float n = static_cast<float>(reduced_dim);
+    for (size_t o = 0; o < outer_dim; ++o) {
+        const float* x = input + o * reduced_dim * inner_dim;
+        float* s1 = mean + o * inner_dim;
+        float* s2 = var + o * inner_dim;
+
+        // One read for both moments, shifted by the first row (the first
+        // element when Inner is 1, as in LayerNorm)
+        for (size_t j = 0; j < inner_dim; ++j) {
+            s1[j] = 0.0f;
+            s2[j] = 0.0f;
+        }
+        for (size_t i = 0; i < reduced_dim; ++i) {
+            for (size_t j = 0; j < inner_dim; ++j) {
+                const float d = x[i * inner_dim + j] - x[j];
+                s1[j] += d;
+                s2[j] += d * d;
+            }
+        }
+        for (size_t j = 0; j < inner_dim; ++j) {
+            const float sum = s1[j];
+            s1[j] = x[j] + sum / n;
+            s2[j] = std::max(0.0f, (s2[j] - sum * (sum / n)) / n);
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
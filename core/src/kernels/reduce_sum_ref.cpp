@@ -22,6 +22,28 @@ VectoriaStatus reduce_sum_f32(
     return VECTORIA_SUCCESS;
 }
 
+VectoriaStatus reduce_sum_axis_f32(
+    const float* input,
+    float* output,
+    size_t outer_dim,
+    size_t reduced_dim,
+    size_t inner_dim
+) {
+    if (!input || !output) return VECTORIA_ERROR_INVALID_SHAPE;
+
+    for (size_t o = 0; o < outer_dim; ++o) {
+        const float* in = input + o * reduced_dim * inner_dim;
+        float* out = output + o * inner_dim;
+        for (size_t j = 0; j < inner_dim; ++j) out[j] = 0.0f;
+        for (size_t i = 0; i < reduced_dim; ++i) {
+            for (size_t j = 0; j < inner_dim; ++j) {
+                out[j] += in[i * inner_dim + j];
+            }
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
 } // namespace reference
 } // namespace kernels
 } // namespace vectoria
@@ -0,0 +1,46 @@
+#include "vectoria/kernel_abi.hpp"
+#include <cmath>
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+extern "C" {
+    VectoriaStatus reduce_max_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+}
+
+// Each row: m = max (reduce_max), s = sum exp(x - m) (exp_shift_sum), then
+// one output pass with the broadcast kernels. Same arithmetic as the
+// Reference twins in softmax_ref.cpp; only the exp and the sum order differ.
+
+extern "C" VectoriaStatus softmax_f32_avx2(const float* in, float* out, size_t outer, size_t inner) {
+    if (!in || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (inner == 0) return VECTORIA_SUCCESS;
+    for (size_t i = 0; i < outer; ++i) {
+        const float* x = in + i * inner;
+        float* y = out + i * inner;
+        float max_val, sum;
+        reduce_max_f32_avx2(x, &max_val, 1, inner);
+        exp_shift_sum_f32_avx2(x, y, inner, &max_val, &sum);
+        const float inv_sum = 1.0f / sum;
+        mul_col_f32_avx2(y, &inv_sum, y, 1, inner);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+extern "C" VectoriaStatus logsoftmax_f32_avx2(const float* in, float* out, size_t outer, size_t inner) {
+    if (!in || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (inner == 0) return VECTORIA_SUCCESS;
+    for (size_t i = 0; i < outer; ++i) {
+        const float* x = in + i * inner;
+        float* y = out + i * inner;
+        float max_val, sum;
+        reduce_max_f32_avx2(x, &max_val, 1, inner);
+        exp_shift_sum_f32_avx2(x, nullptr, inner, &max_val, &sum);
+        // (x - m) - log(s), rounded in two steps like the composed graph
+        const float log_sum = std::log(sum);
+        sub_col_f32_avx2(x, &max_val, y, 1, inner);
+        sub_col_f32_avx2(y, &log_sum, y, 1, inner);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "vectoria/kernels.hpp"
+#include <cmath>
+#include <limits>
+
+namespace vectoria {
+namespace kernels {
+namespace reference {
+
+namespace {
+
+float row_max(const float* x, size_t inner) {
+    float max_val = -std::numeric_limits<float>::infinity();
+    for (size_t j = 0; j < inner; ++j) {
+        if (x[j] > max_val) max_val = x[j];
+    }
+    return max_val;
+}
+
+} // namespace
+
+VectoriaStatus softmax_f32(
+    const float* input,
+    float* output,
+    size_t outer,
+    size_t inner
+) {
+    if (!input || !output) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i = 0; i < outer; ++i) {
+        const float* x = input + i * inner;
+        float* y = output + i * inner;
+        const float max_val = row_max(x, inner);
+        float sum = 0.0f;
+        for (size_t j = 0; j < inner; ++j) {
+            y[j] = std::exp(x[j] - max_val);
+            sum += y[j];
+        }
+        const float inv_sum = 1.0f / sum;
+        for (size_t j = 0; j < inner; ++j) y[j] *= inv_sum;
+    }
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus logsoftmax_f32(
+    const float* input,
+    float* output,
+    size_t outer,
+    size_t inner
+) {
+    if (!input || !output) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i = 0; i < outer; ++i) {
+        const float* x = input + i * inner;
+        float* y = output + i * inner;
+        const float max_val = row_max(x, inner);
+        float sum = 0.0f;
+        for (size_t j = 0; j < inner; ++j) sum += std::exp(x[j] - max_val);
+        const float log_sum = std::log(sum);
+        for (size_t j = 0; j < inner; ++j) y[j] = (x[j] - max_val) - log_sum;
+    }
+    return VECTORIA_SUCCESS;
+}
+
+} // namespace reference
+} // namespace kernels
+} // namespace vectoria
@@ -1,66 +1,178 @@
 #include "vectoria/kernels.hpp"
 #include <vector>
-#include <numeric>
+#include <algorithm>
+#include <cstring>
 
 namespace vectoria {
 namespace kernels {
 namespace reference {
 
-// Helper to convert flat index to multi-dim index
-static void unravel_index(size_t index, const std::vector<int64_t>& shape, std::vector<size_t>& multi_indices) {
-    for (int i = static_cast<int>(shape.size()) - 1; i >= 0; --i) {
-        multi_indices[i] = index % shape[i];
-        index /= shape[i];
+namespace {
+
+constexpr size_t kTransposeBlock = 32; // 32x32 floats = 4 KB per block
+
+// Drops size-1 axes and merges runs of axes that stay adjacent and in order
+// under `perm`, e.g. [B, S, H, D] with {0, 2, 1, 3} stays rank 4, while
+// [B, S, D] with {0, 1, 2} collapses to a single axis.
+void canonicalize(const std::vector<int64_t>& shape, const std::vector<int64_t>& perm,
+                  std::vector<size_t>& dims, std::vector<size_t>& order) {
+    // Renumber the non-trivial axes so that dropping size-1 axes keeps them adjacent
+    std::vector<int64_t> compact(shape.size(), -1);
+    std::vector<size_t> extents;
+    for (size_t axis = 0; axis < shape.size(); ++axis) {
+        if (shape[axis] != 1) {
+            compact[axis] = static_cast<int64_t>(extents.size());
+            extents.push_back(static_cast<size_t>(shape[axis]));
+        }
+    }
+
+    // Groups of consecutive (compacted) input axes, in output order
+    std::vector<std::pair<int64_t, int64_t>> groups;
+    for (int64_t axis : perm) {
+        const int64_t c = compact[axis];
+        if (c < 0) continue;
+        if (!groups.empty() && groups.back().second + 1 == c) {
+            groups.back().second = c;
+        } else {
+            groups.push_back({c, c});
+        }
+    }
+
+    // Input order of the groups defines the collapsed input shape
+    std::vector<size_t> by_input(groups.size());
+    for (size_t g = 0; g < groups.size(); ++g) by_input[g] = g;
+    std::sort(by_input.begin(), by_input.end(), [&](size_t x, size_t y) { return groups[x].first < groups[y].first; });
+
+    dims.assign(groups.size(), 1);
+    order.assign(groups.size(), 0);
+    for (size_t pos = 0; pos < by_input.size(); ++pos) {
+        const auto& grp = groups[by_input[pos]];
+        for (int64_t axis = grp.first; axis <= grp.second; ++axis) dims[pos] *= extents[axis];
+        order[by_input[pos]] = pos;
     }
 }
 
-// Helper to convert multi-dim index to flat index
-static size_t ravel_index(const std::vector<size_t>& multi_indices, const std::vector<int64_t>& shape) {
-    size_t index = 0;
-    size_t stride = 1;
-    for (int i = static_cast<int>(shape.size()) - 1; i >= 0; --i) {
-        index += multi_indices[i] * stride;
-        stride *= shape[i];
+// Walks the output in order; the innermost output axis is copied as one
+// row (memcpy when it is also innermost in the input).
+void transpose_strided(const float* input, float* output,
+                       const std::vector<size_t>& dims, const std::vector<size_t>& order) {
+    const size_t rank = dims.size();
+    if (rank == 0) return;
+    std::vector<size_t> in_strides(rank, 1);
+    for (size_t d = rank - 1; d > 0; --d) in_strides[d - 1] = in_strides[d] * dims[d];
+
+    std::vector<size_t> out_dims(rank), strides(rank);
+    for (size_t d = 0; d < rank; ++d) {
+        out_dims[d] = dims[order[d]];
+        strides[d] = in_strides[order[d]];
+    }
+
+    const size_t inner = out_dims[rank - 1];
+    const size_t inner_stride = strides[rank - 1];
+    size_t rows = 1;
+    for (size_t d = 0; d + 1 < rank; ++d) rows *= out_dims[d];
+
+    std::vector<size_t> index(rank, 0);
+    size_t offset = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        const float* src = input + offset;
+        if (inner_stride == 1) {
+            std::memcpy(output, src, inner * sizeof(float));
+        } else {
+            for (size_t j = 0; j < inner; ++j) output[j] = src[j * inner_stride];
+        }
+        output += inner;
+
+        // Advance the outer output index, carrying into higher axes
+        for (size_t d = rank - 1; d-- > 0;) {
+            offset += strides[d];
+            if (++index[d] < out_dims[d]) break;
+            offset -= strides[d] * out_dims[d];
+            index[d] = 0;
+        }
     }
-    return index;
 }
 
-VectoriaStatus transpose_f32(
+} // namespace
+
+VectoriaStatus transpose_2d_f32(
+    const float* in,
+    float* out,
+    size_t rows,
+    size_t cols,
+    size_t ld_in,
+    size_t ld_out
+) {
+    if (!in || !out) return VECTORIA_ERROR_INVALID_SHAPE;
+    for (size_t i0 = 0; i0 < rows; i0 += kTransposeBlock) {
+        const size_t i1 = std::min(rows, i0 + kTransposeBlock);
+        for (size_t j0 = 0; j0 < cols; j0 += kTransposeBlock) {
+            const size_t j1 = std::min(cols, j0 + kTransposeBlock);
+            for (size_t i = i0; i < i1; ++i) {
+                for (size_t j = j0; j < j1; ++j) out[j * ld_out + i] = in[i * ld_in + j];
+            }
+        }
+    }
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus transpose_f32_tiled(
     const float* input,
     float* output,
     const std::vector<int64_t>& input_shape,
-    const std::vector<int64_t>& perm
+    const std::vector<int64_t>& perm,
+    transpose_2d_f32_t tile
 ) {
-    if (!input || !output) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (!input || !output || !tile) return VECTORIA_ERROR_INVALID_SHAPE;
+    if (perm.size() != input_shape.size()) return VECTORIA_ERROR_INVALID_SHAPE;
 
+    std::vector<bool> seen(perm.size(), false);
     size_t count = 1;
-    for (auto d : input_shape) count *= d;
-
-    // Output shape calculation
-    std::vector<int64_t> output_shape(input_shape.size());
     for (size_t i = 0; i < perm.size(); ++i) {
-        output_shape[i] = input_shape[perm[i]];
+        if (perm[i] < 0 || perm[i] >= static_cast<int64_t>(perm.size()) || seen[perm[i]]) {
+            return VECTORIA_ERROR_INVALID_SHAPE;
+        }
+        seen[perm[i]] = true;
+        if (input_shape[i] < 0) return VECTORIA_ERROR_INVALID_SHAPE;
+        count *= static_cast<size_t>(input_shape[i]);
     }
+    if (count == 0) return VECTORIA_SUCCESS;
 
-    std::vector<size_t> in_indices(input_shape.size());
-    std::vector<size_t> out_indices(input_shape.size());
+    std::vector<size_t> dims, order;
+    canonicalize(input_shape, perm, dims, order);
 
-    // Iterate over input in linear order
-    for (size_t i = 0; i < count; ++i) {
-        unravel_index(i, input_shape, in_indices);
-        
-        // Map to output indices based on permutation
-        for (size_t d = 0; d < perm.size(); ++d) {
-            out_indices[d] = in_indices[perm[d]];
+    if (dims.size() <= 1) {
+        // Identity (after dropping size-1 axes)
+        std::memcpy(output, input, count * sizeof(float));
+        return VECTORIA_SUCCESS;
+    }
+    if (dims.size() == 2) {
+        // {1, 0}: the only non-identity rank-2 order
+        return tile(input, output, dims[0], dims[1], dims[1], dims[0]);
+    }
+    if (dims.size() == 3 && order[0] == 0 && order[1] == 2 && order[2] == 1) {
+        // {0, 2, 1}: one 2D transpose per batch
+        const size_t plane = dims[1] * dims[2];
+        for (size_t b = 0; b < dims[0]; ++b) {
+            VectoriaStatus status = tile(input + b * plane, output + b * plane, dims[1], dims[2], dims[2], dims[1]);
+            if (status != VECTORIA_SUCCESS) return status;
         }
-        
-        size_t out_idx = ravel_index(out_indices, output_shape);
-        output[out_idx] = input[i];
+        return VECTORIA_SUCCESS;
     }
-
+    // Covers {1, 0, 2} (contiguous rows) and general permutations
+    transpose_strided(input, output, dims, order);
     return VECTORIA_SUCCESS;
 }
 
+VectoriaStatus transpose_f32(
+    const float* input,
+    float* output,
+    const std::vector<int64_t>& input_shape,
+    const std::vector<int64_t>& perm
+) {
+    return transpose_f32_tiled(input, output, input_shape, perm, transpose_2d_f32);
+}
+
 } // namespace reference
 } // namespace kernels
 } // namespace vectoria
@@ -21,6 +21,11 @@ std::string dtype_to_mil(ir::DataType dt) {
     }
 }
 
+// Axis of a ReduceSum / ReduceMax / ReduceMeanVar (int_params[0], default -1).
+int64_t reduce_axis(const ir::OpNode& op) {
+    return op.int_params.empty() ? -1 : op.int_params[0];
+}
+
 std::string shape_to_mil(const ir::TensorShape& shape) {
     std::stringstream ss;
     ss << "(";
@@ -81,6 +86,59 @@ void export_to_coreml(const ir::Graph& graph, const std::string& output_path) {
                 }
             }
 
+            if (op->op == ir::OpType::FusedLinear) {
+                // Unfused again for CoreML: matmul, then add / relu on the result.
+                int64_t epilogue = op->int_params.empty() ? 0 : op->int_params[0];
+                if (epilogue == static_cast<int64_t>(ir::LinearEpilogue::None)) {
+                    mil_file << "  " << node_name << " = matmul(x=" << inputs[0] << ", y=" << inputs[1] << ");\n";
+                } else {
+                    mil_file << "  " << node_name << "_mm = matmul(x=" << inputs[0] << ", y=" << inputs[1] << ");\n";
+                    if (epilogue == static_cast<int64_t>(ir::LinearEpilogue::BiasRelu)) {
+                        mil_file << "  " << node_name << "_bias = add(x=" << node_name << "_mm, y=" << inputs[2] << ");\n";
+                        mil_file << "  " << node_name << " = relu(x=" << node_name << "_bias);\n";
+                    } else {
+                        mil_file << "  " << node_name << " = add(x=" << node_name << "_mm, y=" << inputs[2] << ");\n";
+                    }
+                }
+                continue;
+            }
+
+            if (op->op == ir::OpType::LogSoftmax) {
+                // x - logsumexp(x), the same stable form as the fused kernel
+                mil_file << "  " << node_name << "_lse = reduce_log_sum_exp(x=" << inputs[0] << ", axes=[-1], keep_dims=true);\n";
+                mil_file << "  " << node_name << " = sub(x=" << inputs[0] << ", y=" << node_name << "_lse);\n";
+                continue;
+            }
+
+            if (op->op == ir::OpType::LayerNorm) {
+                const float eps = op->int_params.empty() ? 1e-5f : ir::decode_f32_param(op->int_params[0]);
+                mil_file << "  " << node_name << " = layer_norm(x=" << inputs[0] << ", axes=[-1], gamma=" << inputs[1]
+                         << ", beta=" << inputs[2] << ", epsilon=" << eps << ");\n";
+                continue;
+            }
+
+            if (op->op == ir::OpType::ReduceMeanVar) {
+                // [mean; population variance] stacked on a new leading axis
+                const int64_t axis = reduce_axis(*op);
+                mil_file << "  " << node_name << "_mk = reduce_mean(x=" << inputs[0] << ", axes=[" << axis << "], keep_dims=true);\n";
+                mil_file << "  " << node_name << "_d = sub(x=" << inputs[0] << ", y=" << node_name << "_mk);\n";
+                mil_file << "  " << node_name << "_sq = square(x=" << node_name << "_d);\n";
+                mil_file << "  " << node_name << "_m = reduce_mean(x=" << inputs[0] << ", axes=[" << axis << "], keep_dims=false);\n";
+                mil_file << "  " << node_name << "_v = reduce_mean(x=" << node_name << "_sq, axes=[" << axis << "], keep_dims=false);\n";
+                mil_file << "  " << node_name << " = stack(values=[" << node_name << "_m, " << node_name << "_v], axis=0);\n";
+                continue;
+            }
+
+            if (op->op == ir::OpType::Attention) {
+                // Materialized again for CoreML: softmax(scale * Q K^T) V
+                const float scale = ir::decode_f32_param(op->int_params[0]);
+                mil_file << "  " << node_name << "_s = matmul(x=" << inputs[0] << ", y=" << inputs[1] << ", transpose_y=true);\n";
+                mil_file << "  " << node_name << "_ss = mul(x=" << node_name << "_s, y=" << scale << ");\n";
+                mil_file << "  " << node_name << "_p = softmax(x=" << node_name << "_ss, axis=-1);\n";
+                mil_file << "  " << node_name << " = matmul(x=" << node_name << "_p, y=" << inputs[2] << ");\n";
+                continue;
+            }
+
             mil_file << "  " << node_name << " = ";
             
             switch (op->op) {
@@ -100,19 +158,29 @@ void export_to_coreml(const ir::Graph& graph, const std::string& output_path) {
                     mil_file << "relu(x=" << inputs[0] << ");\n";
                     break;
                 case ir::OpType::MatMul:
-                    // CoreML linear/matmul expects specific args
-                    // Simple matmul: x, y
-                    mil_file << "matmul(x=" << inputs[0] << ", y=" << inputs[1] << ");\n";
+                case ir::OpType::BatchedMatMul: // matmul broadcasts over leading (batch) axes
+                    {
+                        // CoreML linear/matmul expects specific args
+                        // Simple matmul: x, y (+ transpose flags of a folded MatMul)
+                        const int64_t trans = (op->op == ir::OpType::MatMul && !op->int_params.empty()) ? op->int_params[0] : 0;
+                        mil_file << "matmul(x=" << inputs[0] << ", y=" << inputs[1];
+                        if (trans & static_cast<int64_t>(ir::MatMulTranspose::A)) mil_file << ", transpose_x=true";
+                        if (trans & static_cast<int64_t>(ir::MatMulTranspose::B)) mil_file << ", transpose_y=true";
+                        mil_file << ");\n";
+                    }
                     break;
                 case ir::OpType::ReduceSum:
-                    mil_file << "reduce_sum(x=" << inputs[0] << ", axes=[-1], keep_dims=false);\n";
+                    mil_file << "reduce_sum(x=" << inputs[0] << ", axes=[" << reduce_axis(*op) << "], keep_dims=false);\n";
                     break;
                 case ir::OpType::ReduceMax:
-                    mil_file << "reduce_max(x=" << inputs[0] << ", axes=[-1], keep_dims=false);\n";
+                    mil_file << "reduce_max(x=" << inputs[0] << ", axes=[" << reduce_axis(*op) << "], keep_dims=false);\n";
                     break;
                 case ir::OpType::Exp:
                     mil_file << "exp(x=" << inputs[0] << ");\n";
                     break;
+                case ir::OpType::Softmax:
+                    mil_file << "softmax(x=" << inputs[0] << ", axis=-1);\n";
+                    break;
                 case ir::OpType::Sqrt:
                     mil_file << "sqrt(x=" << inputs[0] << ");\n";
                     break;
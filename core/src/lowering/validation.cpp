@@ -29,11 +29,21 @@ void validate_for_deployment(const ir::Graph& graph) {
                 case ir::OpType::Reshape:
                 case ir::OpType::Concat:
                 case ir::OpType::Slice:
+                case ir::OpType::FusedLinear:
+                case ir::OpType::BatchedMatMul:
                     // Basic ops are supported structurally
                     break;
                 
                 case ir::OpType::ReduceSum:
                 case ir::OpType::ReduceMax:
+                case ir::OpType::ReduceMeanVar:
+                    // Any axis: lowered with axes=[int_params[0]] (default -1)
+                    break;
+
+                case ir::OpType::Softmax:
+                case ir::OpType::LogSoftmax:
+                case ir::OpType::LayerNorm:
+                case ir::OpType::Attention:
                     // Must validate axis semantics if we tracked axis (we assume last axis)
                     break;
                     
@@ -41,6 +51,12 @@ void validate_for_deployment(const ir::Graph& graph) {
                     throw std::runtime_error("Unsupported OpType for deployment: " + std::to_string(static_cast<int>(op->op)));
             }
 
+            if (op->op == ir::OpType::FusedLinear) {
+                bool ok = !op->int_params.empty() && op->int_params[0] >= 0 && op->int_params[0] <= 2 &&
+                          op->inputs.size() == (op->int_params[0] == 0 ? 2u : 3u);
+                if (!ok) throw std::runtime_error("FusedLinear requires an epilogue (0-2) and matching inputs");
+            }
+
             // Check Input Validity
             for (auto inp : op->inputs) {
                 if (inp.index >= graph.nodes.size()) {
@@ -1,6 +1,7 @@
 #include "vectoria/memory.hpp"
 #include <cstdlib>
 #include <algorithm>
+#include <limits>
 
 namespace vectoria {
 namespace memory {
@@ -57,5 +58,63 @@ void Arena::add_block(size_t min_size) {
     blocks_.push_back({static_cast<uint8_t*>(data), size, 0});
 }
 
+MemoryPlan plan_memory(const std::vector<BufferLifetime>& requests, size_t alignment) {
+    MemoryPlan plan;
+    plan.offsets.assign(requests.size(), 0);
+    if (alignment == 0) alignment = 1;
+
+    auto align_up = [&](size_t v) { return (v + alignment - 1) / alignment * alignment; };
+    constexpr size_t kForever = std::numeric_limits<size_t>::max();
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (requests[i].size == 0) continue;
+        plan.naive_bytes += align_up(requests[i].size);
+        order.push_back(i);
+    }
+
+    // Largest first keeps big activations at low offsets and small ones filling gaps.
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (requests[a].size != requests[b].size) return requests[a].size > requests[b].size;
+        return requests[a].first_use < requests[b].first_use;
+    });
+
+    auto live_range = [&](size_t i) {
+        const auto& r = requests[i];
+        if (r.pinned) return std::make_pair(size_t(0), kForever);
+        return std::make_pair(r.first_use, std::max(r.first_use, r.last_use));
+    };
+
+    std::vector<size_t> placed;
+    std::vector<std::pair<size_t, size_t>> conflicts; // [offset, end) of overlapping live buffers
+
+    for (size_t idx : order) {
+        auto [begin, end] = live_range(idx);
+        size_t size = align_up(requests[idx].size);
+
+        conflicts.clear();
+        for (size_t other : placed) {
+            auto [o_begin, o_end] = live_range(other);
+            if (o_begin <= end && begin <= o_end) {
+                conflicts.push_back({plan.offsets[other], plan.offsets[other] + align_up(requests[other].size)});
+            }
+        }
+        std::sort(conflicts.begin(), conflicts.end());
+
+        // First fit: walk occupied regions in address order and take the first gap.
+        size_t offset = 0;
+        for (const auto& c : conflicts) {
+            if (offset + size <= c.first) break;
+            offset = std::max(offset, c.second);
+        }
+
+        plan.offsets[idx] = offset;
+        plan.peak_bytes = std::max(plan.peak_bytes, offset + size);
+        placed.push_back(idx);
+    }
+
+    return plan;
+}
+
 } // namespace memory
 } // namespace vectoria
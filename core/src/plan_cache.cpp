@@ -0,0 +1,172 @@
+#include "vectoria/plan_cache.hpp"
+#include <cstring>
+
+namespace vectoria {
+namespace cache {
+
+namespace {
+
+template <typename T>
+void put(std::string& key, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    key.append(bytes, sizeof(T));
+}
+
+void put_dims(std::string& key, const std::vector<int64_t>& dims) {
+    put<uint64_t>(key, dims.size());
+    for (int64_t d : dims) put<int64_t>(key, d);
+}
+
+template <typename T>
+T* rebase(T* p, uintptr_t from, uint8_t* to) {
+    if (!p) return nullptr;
+    return reinterpret_cast<T*>(to + (reinterpret_cast<uintptr_t>(p) - from));
+}
+
+} // namespace
+
+std::string structural_key(const ir::Graph& graph) {
+    std::string key;
+    key.reserve(graph.nodes.size() * 64);
+    put<uint64_t>(key, graph.nodes.size());
+    for (const auto& node : graph.nodes) {
+        put<uint64_t>(key, node.id.index);
+        if (auto* in = std::get_if<ir::InputNode>(&node.data)) {
+            key.push_back('I');
+            put_dims(key, in->shape.dims);
+            put<uint8_t>(key, static_cast<uint8_t>(in->dtype));
+        } else if (auto* p = std::get_if<ir::ParameterNode>(&node.data)) {
+            key.push_back('P');
+            put_dims(key, p->shape.dims);
+            put<uint8_t>(key, static_cast<uint8_t>(p->dtype));
+        } else if (auto* c = std::get_if<ir::ConstantNode>(&node.data)) {
+            // Values matter: constants are copied into the slab and may be folded.
+            key.push_back('C');
+            put_dims(key, c->shape.dims);
+            put<uint8_t>(key, static_cast<uint8_t>(c->dtype));
+            put<uint64_t>(key, c->data_f32.size());
+            key.append(reinterpret_cast<const char*>(c->data_f32.data()), c->data_f32.size() * sizeof(float));
+        } else if (auto* op = std::get_if<ir::OpNode>(&node.data)) {
+            key.push_back('O');
+            put<uint16_t>(key, static_cast<uint16_t>(op->op));
+            put<uint64_t>(key, op->inputs.size());
+            for (const auto& in : op->inputs) put<uint64_t>(key, in.index);
+            put_dims(key, op->output_shape.dims);
+            put<uint8_t>(key, static_cast<uint8_t>(op->output_dtype));
+            put_dims(key, op->int_params);
+        }
+    }
+    put<uint64_t>(key, graph.outputs.size());
+    for (const auto& out : graph.outputs) put<uint64_t>(key, out.index);
+    return key;
+}
+
+uint64_t fingerprint(const std::string& key) {
+    // FNV-1a over 64-bit words (keys are mostly 8-byte fields), then the
+    // remaining bytes, then a final avalanche so low bits mix the whole key.
+    const uint64_t prime = 1099511628211ull;
+    uint64_t h = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= key.size(); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, key.data() + i, sizeof(word));
+        h = (h ^ word) * prime;
+    }
+    for (; i < key.size(); ++i) h = (h ^ static_cast<unsigned char>(key[i])) * prime;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t graph_fingerprint(const ir::Graph& graph) {
+    return fingerprint(structural_key(graph));
+}
+
+std::vector<exec::ExecStep> CompiledPlan::rebase_steps(uint8_t* slab) const {
+    std::vector<exec::ExecStep> out = steps;
+    for (auto& step : out) {
+        for (auto& in : step.inputs) in = rebase(in, slab_base, slab);
+        step.output = rebase(step.output, slab_base, slab);
+    }
+    return out;
+}
+
+PlanCache& PlanCache::global() {
+    static PlanCache cache;
+    return cache;
+}
+
+std::shared_ptr<const CompiledPlan> PlanCache::find(uint64_t fingerprint, const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = plans_.find(fingerprint);
+    if (it == plans_.end() || it->second.plan->key != key) {
+        misses_++;
+        return nullptr;
+    }
+    hits_++;
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.plan;
+}
+
+void PlanCache::insert(std::shared_ptr<const CompiledPlan> plan) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // First plan wins; a colliding key simply stays uncached.
+    if (capacity_ == 0 || plans_.count(plan->fingerprint)) return;
+    evict_to(capacity_ - 1);
+    const uint64_t fp = plan->fingerprint;
+    lru_.push_front(fp);
+    plans_.emplace(fp, Entry{std::move(plan), lru_.begin()});
+}
+
+void PlanCache::evict_to(size_t capacity) {
+    while (plans_.size() > capacity) {
+        plans_.erase(lru_.back());
+        lru_.pop_back();
+        evictions_++;
+    }
+}
+
+void PlanCache::set_capacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    evict_to(capacity_);
+}
+
+size_t PlanCache::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+void PlanCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.clear();
+    lru_.clear();
+    hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+}
+
+size_t PlanCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return plans_.size();
+}
+
+uint64_t PlanCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t PlanCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+uint64_t PlanCache::evictions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return evictions_;
+}
+
+} // namespace cache
+} // namespace vectoria
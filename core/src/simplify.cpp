@@ -0,0 +1,132 @@
+#include "vectoria/simplify.hpp"
+#include "vectoria/exec_plan.hpp"
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <tuple>
+
+namespace vectoria {
+namespace simplify {
+
+namespace {
+
+size_t element_count(const ir::TensorShape& shape) {
+    size_t count = 1;
+    for (auto d : shape.dims) count *= d;
+    return count;
+}
+
+// Constants compare by bit pattern so -0.0f and distinct NaNs are never merged.
+std::vector<uint32_t> bits_of(const std::vector<float>& data) {
+    std::vector<uint32_t> bits(data.size());
+    if (!data.empty()) std::memcpy(bits.data(), data.data(), data.size() * sizeof(float));
+    return bits;
+}
+
+// Constant whose value is fully known at compile time, nullptr otherwise.
+const ir::ConstantNode* complete_constant(const ir::Graph& graph, size_t idx) {
+    auto* c = std::get_if<ir::ConstantNode>(&graph.nodes[idx].data);
+    if (!c || c->dtype != ir::DataType::Float32) return nullptr;
+    if (c->data_f32.size() != element_count(c->shape)) return nullptr;
+    return c;
+}
+
+using ConstantKey = std::tuple<std::vector<int64_t>, std::vector<uint32_t>>;
+using OpKey = std::tuple<ir::OpType, std::vector<size_t>, std::vector<int64_t>, std::vector<int64_t>, ir::DataType>;
+
+} // namespace
+
+SimplifyResult simplify_graph(ir::Graph& graph, KernelPolicy policy, SimdTier tier) {
+    const size_t n = graph.nodes.size();
+    SimplifyResult result;
+    result.canonical.resize(n);
+    std::iota(result.canonical.begin(), result.canonical.end(), 0);
+
+    // Ordered maps: the first node of each key wins, independent of hashing.
+    std::map<ConstantKey, size_t> constants;
+    std::map<OpKey, size_t> ops;
+
+    // Scratch for evaluating a single step on constant data.
+    std::vector<void*> buffers(n, nullptr);
+    const std::vector<int64_t> alias_of(n, -1);
+
+    for (size_t i = 0; i < n; ++i) {
+        auto& data = graph.nodes[i].data;
+
+        if (auto* op = std::get_if<ir::OpNode>(&data)) {
+            for (auto& in : op->inputs) in.index = result.canonical[in.index];
+
+            bool foldable = !op->inputs.empty() && op->output_dtype == ir::DataType::Float32 &&
+                            element_count(op->output_shape) > 0;
+            for (const auto& in : op->inputs) {
+                foldable = foldable && complete_constant(graph, in.index) != nullptr;
+            }
+
+            if (foldable) {
+                std::vector<float> value(element_count(op->output_shape));
+                for (const auto& in : op->inputs) {
+                    auto* c = complete_constant(graph, in.index);
+                    buffers[in.index] = const_cast<float*>(c->data_f32.data());
+                }
+                buffers[i] = value.data();
+                std::vector<exec::ExecStep> plan = exec::build_exec_plan(graph, {i}, buffers, alias_of, policy, 1, tier);
+                for (const auto& in : op->inputs) buffers[in.index] = nullptr;
+                buffers[i] = nullptr;
+
+                // Ops without a kernel of their own are left for execute().
+                if (plan[0].fn) {
+                    plan[0].fn(plan[0], exec::ExecContext{});
+                    ir::ConstantNode folded{op->output_shape, ir::DataType::Float32, std::move(value)};
+                    data = std::move(folded);
+                    result.folded.push_back(i);
+                }
+            }
+        }
+
+        if (auto* c = std::get_if<ir::ConstantNode>(&data)) {
+            if (!complete_constant(graph, i)) continue;
+            auto it = constants.emplace(ConstantKey{c->shape.dims, bits_of(c->data_f32)}, i).first;
+            result.canonical[i] = it->second;
+        } else if (auto* op = std::get_if<ir::OpNode>(&data)) {
+            std::vector<size_t> inputs;
+            for (const auto& in : op->inputs) inputs.push_back(in.index);
+            OpKey key{op->op, std::move(inputs), op->int_params, op->output_shape.dims, op->output_dtype};
+            result.canonical[i] = ops.emplace(std::move(key), i).first->second;
+        }
+    }
+
+    return result;
+}
+
+std::vector<TransposeFold> find_transpose_folds(const ir::Graph& graph, KernelPolicy policy) {
+    std::vector<TransposeFold> folds;
+    if (!exec::has_transposed_gemm(policy)) return folds;
+
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        auto* op = std::get_if<ir::OpNode>(&graph.nodes[i].data);
+        if (!op || op->op != ir::OpType::MatMul || op->inputs.size() != 2) continue;
+        const int64_t trans = op->int_params.empty() ? 0 : op->int_params[0];
+        for (size_t operand = 0; operand < 2; ++operand) {
+            if (trans & (int64_t(1) << operand)) continue;
+            const size_t t = op->inputs[operand].index;
+            auto* producer = std::get_if<ir::OpNode>(&graph.nodes[t].data);
+            if (!producer || producer->op != ir::OpType::Transpose || producer->inputs.size() != 1) continue;
+            if (producer->int_params != std::vector<int64_t>{1, 0} || producer->output_shape.dims.size() != 2) continue;
+            folds.push_back({i, operand, t, producer->inputs[0].index});
+        }
+    }
+    return folds;
+}
+
+void fold_transposes(ir::Graph& graph, const std::vector<TransposeFold>& folds) {
+    for (const auto& fold : folds) {
+        auto& op = std::get<ir::OpNode>(graph.nodes[fold.matmul].data);
+        if (op.int_params.empty()) op.int_params.push_back(static_cast<int64_t>(ir::MatMulTranspose::None));
+        op.int_params[0] |= int64_t(1) << fold.operand;
+        op.inputs[fold.operand].index = fold.source;
+    }
+}
+
+} // namespace simplify
+} // namespace vectoria
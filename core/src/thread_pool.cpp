@@ -0,0 +1,167 @@
+#include "vectoria/thread_pool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace vectoria {
+namespace exec {
+
+namespace {
+
+// Shared state of one parallel_for call. Lives on the caller's stack, which
+// outlives every helper because the caller waits for all of them.
+struct ParallelJob {
+    ThreadPool* pool = nullptr;
+    void (*body)(void* ctx, size_t index, size_t worker) = nullptr;
+    void* ctx = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> helpers_remaining{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    void run(size_t worker) {
+        try {
+            for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                body(ctx, i, worker);
+            }
+        } catch (...) {
+            // Stop handing out indices; the caller rethrows the first error.
+            next.store(count, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+};
+
+void run_parallel_helper(void* ctx, size_t, size_t worker) {
+    ParallelJob* job = static_cast<ParallelJob*>(ctx);
+    job->run(worker);
+    job->pool->finish(job->helpers_remaining);
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_workers) {
+    if (num_workers == 0) num_workers = 1;
+    for (size_t w = 0; w < num_workers; ++w) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t w = 1; w < num_workers; ++w) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void ThreadPool::push(size_t worker, Task task) {
+    queued_.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(workers_[worker]->mutex);
+        workers_[worker]->tasks.push_back(task);
+    }
+    {
+        // Pairs with the predicate check in the waiters; prevents a lost wakeup.
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::try_pop(size_t worker, Task& task) {
+    if (queued_.load(std::memory_order_acquire) == 0) return false;
+
+    {
+        Worker& own = *workers_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < workers_.size(); ++i) {
+        Worker& victim = *workers_[(worker + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::help_until(size_t worker, const std::atomic<size_t>& remaining) {
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        Task task;
+        if (try_pop(worker, task)) {
+            task.fn(task.ctx, task.arg, worker);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [&] {
+            return queued_.load(std::memory_order_acquire) > 0 ||
+                   remaining.load(std::memory_order_acquire) == 0;
+        });
+    }
+}
+
+void ThreadPool::finish(std::atomic<size_t>& remaining) {
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        wake_.notify_all();
+    }
+}
+
+void ThreadPool::parallel_for(size_t worker, size_t count,
+                              void (*body)(void* ctx, size_t index, size_t worker), void* ctx) {
+    size_t helpers = std::min(count, workers_.size());
+    helpers = helpers ? helpers - 1 : 0;
+    if (helpers == 0) {
+        for (size_t i = 0; i < count; ++i) body(ctx, i, worker);
+        return;
+    }
+
+    ParallelJob job;
+    job.pool = this;
+    job.body = body;
+    job.ctx = ctx;
+    job.count = count;
+    job.helpers_remaining.store(helpers, std::memory_order_relaxed);
+    for (size_t h = 0; h < helpers; ++h) push(worker, {&run_parallel_helper, &job, h});
+
+    job.run(worker);
+    help_until(worker, job.helpers_remaining);
+
+    if (job.error) std::rethrow_exception(job.error);
+}
+
+void ThreadPool::worker_loop(size_t worker) {
+    for (;;) {
+        Task task;
+        if (try_pop(worker, task)) {
+            task.fn(task.ctx, task.arg, worker);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [&] {
+            return stop_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+        if (stop_ && queued_.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+} // namespace exec
+} // namespace vectoria
@@ -1,14 +1,117 @@
 #include "vectoria/trace.hpp"
-#include <iostream>
+#include <algorithm>
 
 namespace vectoria {
 namespace trace {
 
-void Tracer::log(EventType type, size_t node_id, const std::string& details) {
-    using namespace std::chrono;
-    uint64_t now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
-    
-    events_.push_back({type, now, node_id, details});
+const char* event_type_name(EventType type) {
+    switch (type) {
+        case EventType::GraphCompilation: return "GraphCompilation";
+        case EventType::MemoryAllocation: return "MemoryAllocation";
+        case EventType::NodeExecutionStart: return "NodeExecutionStart";
+        case EventType::NodeExecutionEnd: return "NodeExecutionEnd";
+        case EventType::KernelDispatch: return "KernelDispatch";
+    }
+    return "Unknown";
+}
+
+void Tracer::configure(TraceLevel level, size_t capacity, size_t num_nodes,
+                       size_t retain_executions, std::shared_ptr<TraceSink> sink) {
+    level_ = level;
+
+    size_t ring = 0;
+    if (level == TraceLevel::Full) {
+        ring = 1;
+        while (ring < std::max<size_t>(capacity, 1)) ring <<= 1;
+    }
+    if (records_.size() != ring) {
+        records_.assign(ring, TraceRecord{});
+        records_.shrink_to_fit();
+    }
+    mask_ = ring ? ring - 1 : 0;
+
+    counters_.assign(level == TraceLevel::Off ? 0 : num_nodes, NodeCounter{});
+    execution_starts_.assign(retain_executions, 0);
+    sink_ = std::move(sink);
+    clear();
+}
+
+uint32_t Tracer::intern(const std::string& details) {
+    std::lock_guard<std::mutex> lock(intern_mutex_);
+    auto it = detail_ids_.find(details);
+    if (it != detail_ids_.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(details_.size());
+    details_.push_back(details);
+    detail_ids_.emplace(details, id);
+    return id;
+}
+
+void Tracer::log(EventType type, size_t node_id, const std::string& details, size_t worker_id) {
+    if (records_.empty()) return;
+    record(type, now_ns(), node_id, intern(details), worker_id);
+}
+
+void Tracer::begin_execution() {
+    if (execution_starts_.empty()) return;
+    execution_starts_[executions_ % execution_starts_.size()] = head_.load(std::memory_order_relaxed);
+    executions_++;
+}
+
+void Tracer::publish() {
+    if (!sink_ || records_.empty()) return;
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t oldest = head > records_.size() ? head - records_.size() : 0;
+    if (published_ < oldest) {
+        sink_dropped_ += oldest - published_;
+        published_ = oldest;
+    }
+    // At most two contiguous spans (before and after the ring wraps).
+    while (published_ < head) {
+        size_t slot = static_cast<size_t>(published_ & mask_);
+        size_t n = static_cast<size_t>(std::min<uint64_t>(head - published_, records_.size() - slot));
+        sink_->consume(&records_[slot], n, details_);
+        published_ += n;
+    }
+}
+
+// First ring position still held: bounded by capacity and by the start of
+// the oldest retained execution.
+uint64_t Tracer::tail() const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t first = head > records_.size() ? head - records_.size() : 0;
+    size_t n = execution_starts_.size();
+    if (n && executions_ > n) first = std::max(first, execution_starts_[executions_ % n]);
+    return first;
+}
+
+size_t Tracer::size() const {
+    return static_cast<size_t>(head_.load(std::memory_order_acquire) - tail());
+}
+
+uint64_t Tracer::dropped() const {
+    return tail();
+}
+
+TraceEvent Tracer::event_at(size_t i) const {
+    const TraceRecord& r = records_[(tail() + i) & mask_];
+    return {static_cast<EventType>(r.type), r.timestamp_ns, static_cast<size_t>(r.node_id),
+            details_[r.detail_id], r.worker_id};
+}
+
+std::vector<TraceEvent> Tracer::get_events() const {
+    std::vector<TraceEvent> events;
+    size_t n = size();
+    events.reserve(n);
+    for (size_t i = 0; i < n; ++i) events.push_back(event_at(i));
+    return events;
+}
+
+void Tracer::clear() {
+    head_.store(0, std::memory_order_relaxed);
+    executions_ = 0;
+    published_ = 0;
+    sink_dropped_ = 0;
+    std::fill(counters_.begin(), counters_.end(), NodeCounter{});
 }
 
 } // namespace trace
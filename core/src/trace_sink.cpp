@@ -0,0 +1,137 @@
+#include "vectoria/trace_sink.hpp"
+#include <cstdio>
+#include <stdexcept>
+
+namespace vectoria {
+namespace trace {
+
+namespace {
+
+void write_json_string(std::ostream& os, const std::string& s) {
+    os << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    os << buf;
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+template <typename T>
+void write_raw(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+constexpr uint32_t kBinaryVersion = 1;
+
+} // namespace
+
+FileTraceSink::FileTraceSink(const std::string& path, SinkFormat format)
+    : format_(format) {
+    out_.open(path, format == SinkFormat::Binary ? std::ios::binary | std::ios::trunc : std::ios::trunc);
+    if (!out_) throw std::runtime_error("Cannot open trace sink file: " + path);
+    if (format_ == SinkFormat::Binary) {
+        out_.write("VTRC", 4);
+        write_raw(out_, kBinaryVersion);
+    }
+    thread_ = std::thread(&FileTraceSink::writer_loop, this);
+}
+
+FileTraceSink::~FileTraceSink() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    out_.flush();
+}
+
+void FileTraceSink::consume(const TraceRecord* records, size_t count, const std::vector<std::string>& details) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.insert(pending_.end(), records, records + count);
+        for (; details_seen_ < details.size(); ++details_seen_) pending_details_.push_back(details[details_seen_]);
+    }
+    wake_.notify_one();
+}
+
+void FileTraceSink::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return pending_.empty() && pending_details_.empty() && !busy_; });
+}
+
+uint64_t FileTraceSink::written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+void FileTraceSink::writer_loop() {
+    std::vector<TraceRecord> batch;
+    std::vector<std::string> new_details;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stop_ || !pending_.empty() || !pending_details_.empty(); });
+        if (pending_.empty() && pending_details_.empty()) break; // stop_ with nothing queued
+
+        batch.swap(pending_);
+        new_details.swap(pending_details_);
+        busy_ = true;
+        lock.unlock();
+
+        write_batch(batch, new_details);
+        out_.flush();
+
+        lock.lock();
+        written_ += batch.size();
+        batch.clear();
+        new_details.clear();
+        busy_ = false;
+        idle_.notify_all();
+    }
+}
+
+void FileTraceSink::write_batch(const std::vector<TraceRecord>& batch, const std::vector<std::string>& new_details) {
+    if (format_ == SinkFormat::Binary) {
+        for (const std::string& d : new_details) {
+            uint32_t id = static_cast<uint32_t>(details_.size());
+            uint32_t len = static_cast<uint32_t>(d.size());
+            out_.put('D');
+            write_raw(out_, id);
+            write_raw(out_, len);
+            out_.write(d.data(), d.size());
+            details_.push_back(d);
+        }
+        for (const TraceRecord& r : batch) {
+            out_.put('R');
+            write_raw(out_, r);
+        }
+        return;
+    }
+
+    details_.insert(details_.end(), new_details.begin(), new_details.end());
+    for (const TraceRecord& r : batch) {
+        out_ << "{\"type\": \"" << event_type_name(static_cast<EventType>(r.type)) << "\""
+             << ", \"timestamp_ns\": " << r.timestamp_ns
+             << ", \"node_id\": ";
+        if (r.node_id == static_cast<uint64_t>(-1)) out_ << -1;
+        else out_ << r.node_id;
+        out_ << ", \"details\": ";
+        write_json_string(out_, r.detail_id < details_.size() ? details_[r.detail_id] : std::string());
+        out_ << ", \"worker_id\": " << r.worker_id << "}\n";
+    }
+}
+
+} // namespace trace
+} // namespace vectoria
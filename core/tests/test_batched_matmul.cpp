@@ -0,0 +1,178 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+
+using namespace vectoria;
+
+const test::LeafFill kLeaves{11};
+
+// run() inspector that records the BatchedMatMul dispatch tag.
+std::function<void(const Engine&)> batch_tag(std::string& tag) {
+    return [&tag](const Engine& e) {
+        for (const auto& step : e.get_plan()) {
+            if (step.trace_tag.find("Batch:") != std::string::npos) tag = step.trace_tag;
+        }
+    };
+}
+
+// A [B, M, K] x B [B, K, N] (or a shared [K, N]) as one BatchedMatMul node.
+ir::Graph build_batched(int64_t batch, int64_t m, int64_t n, int64_t k, bool shared_b) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"A", {{batch, m, k}}, ir::DataType::Float32} });
+    ir::TensorShape shape_b;
+    shape_b.dims = shared_b ? std::vector<int64_t>{k, n} : std::vector<int64_t>{batch, k, n};
+    g.nodes.push_back({ {1}, ir::InputNode{"B", shape_b, ir::DataType::Float32} });
+    ir::OpNode op;
+    op.op = ir::OpType::BatchedMatMul;
+    op.inputs = {{0}, {1}};
+    op.output_shape.dims = {batch, m, n};
+    op.output_dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {2}, op });
+    g.outputs = {{2}};
+    return g;
+}
+
+// Each batch item must equal a plain gemm of that item, bit for bit: the
+// batch only decides which pointers the GEMM sees.
+void test_items(KernelPolicy policy) {
+    std::cout << "Testing BatchedMatMul items against per-item GEMM (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference") << ") ... ";
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    gemm_f32_t gemm = policy == KernelPolicy::SIMD ? gemm_f32_avx2_packed : kernels::reference::gemm_f32;
+#elif defined(VECTORIA_USE_ASM) && defined(__aarch64__)
+    gemm_f32_t gemm = policy == KernelPolicy::SIMD ? gemm_f32_neon : kernels::reference::gemm_f32;
+#else
+    gemm_f32_t gemm = kernels::reference::gemm_f32;
+#endif
+    const int64_t shapes[][4] = {{1, 1, 1, 1}, {3, 5, 7, 9}, {8, 64, 64, 16}, {4, 17, 33, 65}, {2, 128, 96, 64}};
+    for (const auto& s : shapes) {
+        for (bool shared_b : {false, true}) {
+            const size_t batch = s[0], m = s[1], n = s[2], k = s[3];
+            std::vector<float> a(batch * m * k), b((shared_b ? 1 : batch) * k * n), expected(batch * m * n);
+            test::DeterministicRNG(11).fill(a.data(), a.size());
+            test::DeterministicRNG(12).fill(b.data(), b.size());
+            for (size_t i = 0; i < batch; ++i) {
+                gemm(a.data() + i * m * k, b.data() + (shared_b ? 0 : i * k * n), expected.data() + i * m * n,
+                     m, n, k, k, n, n, 1.0f, 0.0f);
+            }
+            std::vector<float> out = test::run(build_batched(s[0], s[1], s[2], s[3], shared_b), policy, kLeaves);
+            if (std::memcmp(out.data(), expected.data(), expected.size() * sizeof(float)) != 0) {
+                std::cout << "FAILED ([" << batch << ", " << m << ", " << n << ", " << k << "]"
+                          << (shared_b ? " shared B" : "") << ")" << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_threads(KernelPolicy policy) {
+    std::cout << "Testing BatchedMatMul is identical on 1 and 4 threads (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference") << ") ... ";
+    ir::Graph g = build_batched(12, 70, 48, 40, false);
+    std::string tag;
+    std::vector<float> one = test::run(g, policy, kLeaves, 1);
+    std::vector<float> four = test::run(g, policy, kLeaves, 4, batch_tag(tag));
+    if (one != four || tag.find("Batch: 12 | Threads: 4") == std::string::npos) {
+        std::cout << "FAILED (" << tag << ")" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_errors() {
+    std::cout << "Testing BatchedMatMul shape errors ... ";
+    for (int variant = 0; variant < 2; ++variant) {
+        // variant 0: batch mismatch, variant 1: K mismatch
+        ir::Graph g = build_batched(4, 8, 8, 8, false);
+        auto& b = std::get<ir::InputNode>(g.nodes[1].data);
+        b.shape.dims = variant == 0 ? std::vector<int64_t>{3, 8, 8} : std::vector<int64_t>{4, 7, 8};
+        bool threw = false;
+        try {
+            Engine e(g);
+            e.compile();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cout << "FAILED (variant " << variant << " compiled)" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+ir::Graph build_mha(bool batched_heads) {
+    const int64_t T = 37, d_model = 64;
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{T, d_model}}, ir::DataType::Float32} });
+    for (size_t i = 1; i <= 4; ++i) {
+        g.nodes.push_back({ {i}, ir::ParameterNode{"W" + std::to_string(i), {{d_model, d_model}}, ir::DataType::Float32, 0} });
+    }
+    int out = graph::add_multi_head_attention_composed(g, 0, 1, 2, 3, 4, 8, false, batched_heads);
+    g.outputs = {{static_cast<size_t>(out)}};
+    return g;
+}
+
+// Two BatchedMatMuls over all heads replace the per-head slice / MatMul chains.
+void test_mha(KernelPolicy policy) {
+    std::cout << "Testing MHA with batched heads (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference") << ") ... ";
+    ir::Graph per_head = build_mha(false);
+    ir::Graph batched = build_mha(true);
+    size_t batched_ops = 0;
+    for (const auto& node : batched.nodes) {
+        auto* op = std::get_if<ir::OpNode>(&node.data);
+        if (op && op->op == ir::OpType::BatchedMatMul) ++batched_ops;
+    }
+    if (batched_ops != 2 || batched.nodes.size() >= per_head.nodes.size()) {
+        std::cout << "FAILED (" << batched_ops << " BatchedMatMul nodes, " << batched.nodes.size()
+                  << " vs " << per_head.nodes.size() << " nodes)" << std::endl;
+        exit(1);
+    }
+    // The per-head path keeps its node numbering: Q, K and V head transposes
+    // are consecutive nodes over the Q, K and V splits, in that order.
+    std::vector<size_t> transposes;
+    for (size_t i = 0; i < per_head.nodes.size() && transposes.size() < 3; ++i) {
+        auto* op = std::get_if<ir::OpNode>(&per_head.nodes[i].data);
+        if (op && op->op == ir::OpType::Transpose) transposes.push_back(i);
+    }
+    auto source = [&](size_t i) { return std::get<ir::OpNode>(per_head.nodes[i].data).inputs[0].index; };
+    if (transposes.size() != 3 || transposes[2] != transposes[0] + 2 ||
+        !(source(transposes[0]) < source(transposes[1]) && source(transposes[1]) < source(transposes[2]))) {
+        std::cout << "FAILED (per-head Q / K / V transposes out of order)" << std::endl;
+        exit(1);
+    }
+
+    std::vector<float> expected = test::run(per_head, policy, kLeaves);
+    std::vector<float> out = test::run(batched, policy, kLeaves, 4);
+    std::string where;
+    if (!test::close(out, expected, 1e-5f, where)) {
+        std::cout << "FAILED (at " << where << ")" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating BatchedMatMul..." << std::endl;
+    test_items(KernelPolicy::Reference);
+    test_threads(KernelPolicy::Reference);
+    test_errors();
+    test_mha(KernelPolicy::Reference);
+#ifdef VECTORIA_USE_ASM
+    test_items(KernelPolicy::SIMD);
+    test_threads(KernelPolicy::SIMD);
+    test_mha(KernelPolicy::SIMD);
+#endif
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
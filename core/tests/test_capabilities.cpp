@@ -0,0 +1,196 @@
+#include "vectoria/capabilities.hpp"
+#include "vectoria/exec_plan.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/c_api.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace vectoria;
+
+void fail(const std::string& what) {
+    std::cout << "FAILED (" << what << ")" << std::endl;
+    exit(1);
+}
+
+template <typename F>
+bool throws(F&& f) {
+    try {
+        f();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Detected flags are self-consistent and agree with the summary fields.
+void test_host_features() {
+    std::cout << "Testing host feature detection ... ";
+    const capabilities::SystemCapabilities caps = capabilities::get_system_capabilities();
+    const capabilities::CpuFeatures& f = capabilities::host_cpu_features();
+
+    if (f.avx2 && !f.avx) fail("AVX2 without AVX");
+    if ((f.fma || f.f16c) && !f.avx) fail("FMA / F16C without AVX");
+    if ((f.avx512bw || f.avx512vl || f.avx512_vnni) && !f.avx512f) fail("AVX-512 extension without AVX-512F");
+    if ((f.neon_fp16 || f.neon_dotprod) && !f.neon) fail("NEON extension without NEON");
+    if (capabilities::host_has_avx512f() != f.avx512f) fail("host_has_avx512f");
+#if defined(__x86_64__)
+    if (f.neon) fail("NEON on x86_64");
+#elif defined(__aarch64__)
+    if (f.avx || f.avx2 || f.avx512f) fail("AVX on ARM64");
+    if (!f.neon) fail("ARM64 without NEON");
+#endif
+
+    const size_t set = f.avx + f.avx2 + f.fma + f.f16c + f.avx512f + f.avx512bw + f.avx512vl +
+                       f.avx512_vnni + f.avx_vnni + f.neon + f.neon_fp16 + f.neon_dotprod;
+    if (caps.feature_names.size() != set) fail("feature_names");
+
+    const capabilities::CacheInfo& c = capabilities::host_cache_info();
+    if (c.l1d_bytes && c.l2_bytes && c.l1d_bytes > c.l2_bytes) fail("L1D larger than L2");
+    if (caps.caches.l1d_bytes != c.l1d_bytes || caps.caches.l3_bytes != c.l3_bytes) fail("caches");
+
+    std::cout << "PASSED [";
+    for (size_t i = 0; i < caps.feature_names.size(); ++i) std::cout << (i ? " " : "") << caps.feature_names[i];
+    std::cout << "] L1D " << c.l1d_bytes / 1024 << " KiB, L2 " << c.l2_bytes / 1024
+              << " KiB, L3 " << c.l3_bytes / 1024 << " KiB" << std::endl;
+}
+
+// The registry lists exactly the variants of this build, and
+// simd_supported_on_host / selected_variant follow the host.
+void test_registry() {
+    std::cout << "Testing kernel variant registry ... ";
+    const auto& variants = capabilities::kernel_variants();
+    const capabilities::SystemCapabilities caps = capabilities::get_system_capabilities();
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    if (variants.size() != 2 || variants[0].tier != SimdTier::AVX512 || variants[1].tier != SimdTier::AVX2) fail("x86_64 variants");
+#elif defined(VECTORIA_USE_ASM) && defined(__aarch64__)
+    if (variants.size() != 1 || std::string(variants[0].name) != "NEON") fail("ARM64 variants");
+#else
+    if (!variants.empty()) fail("variants without VECTORIA_USE_ASM");
+#endif
+    std::string best = "Reference";
+    for (const auto& v : variants) {
+        if (v.supported(capabilities::host_cpu_features())) { best = v.name; break; }
+    }
+    if (caps.selected_variant != best) fail("selected_variant");
+    if (caps.simd_supported_on_host != (best != "Reference")) fail("simd_supported_on_host");
+    if (!caps.simd_compiled && caps.simd_supported_on_host) fail("supported but not compiled");
+    std::cout << "PASSED (" << best << ")" << std::endl;
+}
+
+// Selection against synthetic hosts: the best supported variant wins, Auto
+// falls back to the Reference policy on a host that supports none, and
+// explicit tiers the host cannot run fail.
+void test_selection() {
+    std::cout << "Testing kernel selection ... ";
+    capabilities::CpuFeatures none;
+    capabilities::CpuFeatures avx2;
+    avx2.avx = avx2.avx2 = avx2.fma = avx2.f16c = true;
+    capabilities::CpuFeatures avx512 = avx2;
+    avx512.avx512f = true;
+    capabilities::CpuFeatures neon;
+    neon.neon = true;
+
+    exec::KernelSelection ref = exec::select_kernels(KernelPolicy::Reference, SimdTier::AVX512, avx512);
+    if (ref.policy != KernelPolicy::Reference || ref.variant != "Reference") fail("Reference policy");
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    exec::KernelSelection s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, avx512);
+    if (s.policy != KernelPolicy::SIMD || s.tier != SimdTier::AVX512 || s.variant != "AVX-512F") fail("Auto on AVX-512F");
+    s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, avx2);
+    if (s.policy != KernelPolicy::SIMD || s.tier != SimdTier::AVX2 || s.variant != "AVX2") fail("Auto on AVX2");
+    s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::AVX2, avx512);
+    if (s.tier != SimdTier::AVX2) fail("pinned AVX2");
+    // AVX2 without FMA cannot run the GEMM micro-kernels.
+    capabilities::CpuFeatures no_fma = avx2;
+    no_fma.fma = false;
+    s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, no_fma);
+    if (s.policy != KernelPolicy::Reference || s.variant != "Reference") fail("Auto without FMA");
+    s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, none);
+    if (s.policy != KernelPolicy::Reference) fail("Auto without AVX2");
+    if (!throws([&] { exec::select_kernels(KernelPolicy::SIMD, SimdTier::AVX2, none); })) fail("AVX2 without AVX2");
+    if (!throws([&] { exec::select_kernels(KernelPolicy::SIMD, SimdTier::AVX512, avx2); })) fail("AVX512 without AVX-512F");
+#elif defined(VECTORIA_USE_ASM) && defined(__aarch64__)
+    exec::KernelSelection s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, neon);
+    if (s.policy != KernelPolicy::SIMD || s.variant != "NEON") fail("Auto on NEON");
+    s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, none);
+    if (s.policy != KernelPolicy::Reference) fail("Auto without NEON");
+    if (!throws([&] { exec::select_kernels(KernelPolicy::SIMD, SimdTier::AVX512, neon); })) fail("AVX512 on ARM64");
+#else
+    // Nothing compiled in: the SIMD policy keeps its Reference kernels.
+    exec::KernelSelection s = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto, avx512);
+    if (s.policy != KernelPolicy::SIMD || s.variant != "Reference") fail("Auto without kernels");
+    if (!throws([&] { exec::select_kernels(KernelPolicy::SIMD, SimdTier::AVX512, avx512); })) fail("AVX512 not compiled");
+#endif
+    std::cout << "PASSED" << std::endl;
+}
+
+// The engine compiles the host's selection, traces it and runs it here.
+void test_engine() {
+    std::cout << "Testing engine selection on this host ... ";
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"A", {{4, 8}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::InputNode{"B", {{4, 8}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {2}, ir::OpNode{ir::OpType::Add, {{0}, {1}}, {{4, 8}}, ir::DataType::Float32, {}} });
+    g.outputs = {{2}};
+
+    EngineConfig cfg;
+    cfg.policy = KernelPolicy::SIMD;
+    Engine e(g, cfg);
+    e.compile();
+    float* a = static_cast<float*>(e.get_buffer(0));
+    float* b = static_cast<float*>(e.get_buffer(1));
+    for (int i = 0; i < 32; ++i) { a[i] = 0.5f * i; b[i] = 1.0f - i; }
+    e.execute();
+    const float* out = static_cast<const float*>(e.get_buffer(2));
+    for (int i = 0; i < 32; ++i) {
+        if (out[i] != 0.5f * i + (1.0f - i)) fail("Add result");
+    }
+
+    const exec::KernelSelection selection = exec::select_kernels(KernelPolicy::SIMD, SimdTier::Auto);
+    if (selection.variant != capabilities::get_system_capabilities().selected_variant) fail("engine selection");
+    for (const auto& step : e.get_plan()) {
+        if (step.node_id != 2) continue;
+        const bool avx512_tag = step.trace_tag.find("AVX512") != std::string::npos;
+        if (avx512_tag != (selection.variant == "AVX-512F")) fail("dispatch tag: " + step.trace_tag);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+// The C API reports the same features, caches and variant.
+void test_c_api() {
+    std::cout << "Testing vectoria_get_host_features ... ";
+    const capabilities::SystemCapabilities caps = capabilities::get_system_capabilities();
+    uint64_t bits = 0;
+    size_t l1d = 1, l2 = 1, l3 = 1;
+    char variant[32];
+    vectoria_get_host_features(&bits, &l1d, &l2, &l3, variant, sizeof(variant));
+    if (((bits & VECTORIA_CPU_AVX2) != 0) != caps.features.avx2) fail("AVX2 bit");
+    if (((bits & VECTORIA_CPU_FMA) != 0) != caps.features.fma) fail("FMA bit");
+    if (((bits & VECTORIA_CPU_AVX512F) != 0) != caps.features.avx512f) fail("AVX-512F bit");
+    if (((bits & VECTORIA_CPU_AVX512_VNNI) != 0) != caps.features.avx512_vnni) fail("AVX-512 VNNI bit");
+    if (((bits & VECTORIA_CPU_NEON) != 0) != caps.features.neon) fail("NEON bit");
+    size_t popcount = 0;
+    for (uint64_t x = bits; x; x &= x - 1) ++popcount;
+    if (popcount != caps.feature_names.size()) fail("feature bit count");
+    if (l1d != caps.caches.l1d_bytes || l2 != caps.caches.l2_bytes || l3 != caps.caches.l3_bytes) fail("cache sizes");
+    if (caps.selected_variant != variant) fail("variant name");
+
+    // Every out-parameter is optional.
+    vectoria_get_host_features(nullptr, nullptr, nullptr, nullptr, nullptr, 0);
+    int simd_supported = -1;
+    vectoria_get_capabilities(nullptr, nullptr, &simd_supported, nullptr, 0);
+    if (simd_supported != (caps.simd_supported_on_host ? 1 : 0)) fail("simd_supported");
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_host_features();
+    test_registry();
+    test_selection();
+    test_engine();
+    test_c_api();
+    return 0;
+}
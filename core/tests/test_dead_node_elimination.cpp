@@ -0,0 +1,133 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+using namespace vectoria;
+
+size_t add_input(ir::Graph& g, const std::string& name, std::vector<int64_t> dims) {
+    size_t id = g.nodes.size();
+    g.nodes.push_back({ {id}, ir::InputNode{name, {dims}, ir::DataType::Float32} });
+    return id;
+}
+
+struct LossGraph {
+    ir::Graph g;
+    size_t x, w, target, logits;
+    size_t first_dead; // Every node from here on is only reachable from the loss.
+};
+
+// logits = X * W is the declared output; the cross-entropy branch hangs off it unused.
+LossGraph build_loss_graph() {
+    LossGraph lg;
+    ir::Graph& g = lg.g;
+    lg.x = add_input(g, "X", {4, 8});
+    lg.w = add_input(g, "W", {8, 6});
+    lg.target = add_input(g, "Target", {4, 6});
+
+    lg.logits = g.nodes.size();
+    ir::OpNode mm;
+    mm.op = ir::OpType::MatMul;
+    mm.inputs = {{lg.x}, {lg.w}};
+    mm.output_shape.dims = {4, 6};
+    mm.output_dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {lg.logits}, mm });
+
+    lg.first_dead = g.nodes.size();
+    graph::add_crossentropy_composed(g, static_cast<int>(lg.logits), static_cast<int>(lg.target));
+    g.outputs.push_back({lg.logits});
+    return lg;
+}
+
+std::vector<float> run(const LossGraph& lg, Engine& e) {
+    e.compile();
+    test::DeterministicRNG rng(11);
+    rng.fill(static_cast<float*>(e.get_buffer(lg.x)), 32);
+    rng.fill(static_cast<float*>(e.get_buffer(lg.w)), 48);
+    rng.fill(static_cast<float*>(e.get_buffer(lg.target)), 24);
+    e.execute();
+    const float* out = static_cast<const float*>(e.get_buffer(lg.logits));
+    return std::vector<float>(out, out + 24);
+}
+
+void test_unreachable_nodes_pruned() {
+    std::cout << "Testing Dead Node Elimination..." << std::endl;
+    LossGraph lg = build_loss_graph();
+
+    EngineConfig full_cfg;
+    full_cfg.eliminate_dead_nodes = false;
+    Engine full(lg.g, full_cfg);
+    std::vector<float> golden = run(lg, full);
+
+    for (size_t threads : {1, 3}) {
+        EngineConfig cfg;
+        cfg.num_threads = threads;
+        Engine engine(lg.g, cfg);
+        std::vector<float> out = run(lg, engine);
+
+        for (size_t i = 0; i < golden.size(); ++i) {
+            if (out[i] != golden[i]) {
+                std::cerr << "Logits differ at " << i << std::endl;
+                exit(1);
+            }
+        }
+
+        // Inputs stay allocated even when nothing reads them (Target).
+        if (!engine.get_buffer(lg.target)) {
+            std::cerr << "Unused input lost its buffer" << std::endl;
+            exit(1);
+        }
+
+        std::vector<bool> pruned(lg.g.nodes.size(), false), executed(lg.g.nodes.size(), false);
+        for (const auto& ev : engine.get_tracer().get_events()) {
+            if (ev.type == trace::EventType::GraphCompilation && ev.details.rfind("Pruned", 0) == 0) {
+                pruned[ev.node_id] = true;
+            }
+            if (ev.type == trace::EventType::NodeExecutionStart) executed[ev.node_id] = true;
+        }
+
+        for (size_t n = 0; n < lg.g.nodes.size(); ++n) {
+            bool dead = n >= lg.first_dead;
+            if (pruned[n] != dead || executed[n] == dead || (engine.get_buffer(n) == nullptr) != dead) {
+                std::cerr << "Node " << n << ": dead=" << dead << " pruned=" << pruned[n]
+                          << " executed=" << executed[n] << std::endl;
+                exit(1);
+            }
+        }
+        if (engine.get_schedule().size() != lg.first_dead) {
+            std::cerr << "Schedule still contains pruned nodes" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_no_outputs_keeps_everything() {
+    std::cout << "Testing Dead Node Elimination Without Outputs..." << std::endl;
+    LossGraph lg = build_loss_graph();
+    lg.g.outputs.clear();
+
+    Engine e(lg.g);
+    e.compile();
+    if (e.get_schedule().size() != lg.g.nodes.size()) {
+        std::cerr << "Nodes pruned from a graph without declared outputs" << std::endl;
+        exit(1);
+    }
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == trace::EventType::GraphCompilation && ev.details.rfind("Pruned", 0) == 0) {
+            std::cerr << "Unexpected pruning event for node " << ev.node_id << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_unreachable_nodes_pruned();
+    test_no_outputs_keeps_everything();
+    return 0;
+}
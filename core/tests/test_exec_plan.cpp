@@ -0,0 +1,138 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdlib>
+#include <cmath>
+
+using namespace vectoria;
+
+size_t add_input(ir::Graph& g, const std::string& name, std::vector<int64_t> dims) {
+    size_t id = g.nodes.size();
+    g.nodes.push_back({ {id}, ir::InputNode{name, {dims}, ir::DataType::Float32} });
+    return id;
+}
+
+size_t add_op(ir::Graph& g, ir::OpType type, std::vector<size_t> inputs, std::vector<int64_t> dims) {
+    size_t id = g.nodes.size();
+    ir::OpNode op;
+    op.op = type;
+    for (auto i : inputs) op.inputs.push_back({i});
+    op.output_shape.dims = dims;
+    op.output_dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {id}, op });
+    return id;
+}
+
+void test_plan_matches_trace() {
+    std::cout << "Testing Execution Plan vs Trace..." << std::endl;
+    ir::Graph g;
+    size_t x = add_input(g, "X", {4, 8});
+    size_t w = add_input(g, "W", {8, 8});
+    size_t b = add_input(g, "B", {8});
+    size_t mm = add_op(g, ir::OpType::MatMul, {x, w}, {4, 8});
+    size_t ba = add_op(g, ir::OpType::BiasAdd, {mm, b}, {4, 8});
+    int sm = graph::add_softmax_composed(g, static_cast<int>(ba));
+    g.outputs.push_back({static_cast<size_t>(sm)});
+
+    Engine e(g);
+    e.compile();
+
+    const auto& plan = e.get_plan();
+    if (plan.size() != g.nodes.size()) {
+        std::cerr << "Expected one step per node, got " << plan.size() << std::endl;
+        exit(1);
+    }
+    for (const auto& step : plan) {
+        bool is_op = std::holds_alternative<ir::OpNode>(g.nodes[step.node_id].data);
+        if (is_op != (step.fn != nullptr) || is_op == step.trace_tag.empty()) {
+            std::cerr << "Step " << step.node_id << " not resolved as expected" << std::endl;
+            exit(1);
+        }
+        if (step.output != e.get_buffer(step.node_id)) {
+            std::cerr << "Step " << step.node_id << " writes outside its planned buffer" << std::endl;
+            exit(1);
+        }
+    }
+    if (plan[mm].m != 4 || plan[mm].n != 8 || plan[mm].k != 8) {
+        std::cerr << "GEMM extents not precomputed" << std::endl;
+        exit(1);
+    }
+
+    test::DeterministicRNG rng(3);
+    rng.fill(static_cast<float*>(e.get_buffer(x)), 32);
+    rng.fill(static_cast<float*>(e.get_buffer(w)), 64);
+    rng.fill(static_cast<float*>(e.get_buffer(b)), 8);
+
+    size_t before = e.get_tracer().get_events().size();
+    e.execute();
+    const auto& events = e.get_tracer().get_events();
+
+    size_t next = 0;
+    for (size_t i = before; i < events.size(); ++i) {
+        if (events[i].type != trace::EventType::KernelDispatch) continue;
+        while (next < plan.size() && plan[next].trace_tag.empty()) next++;
+        if (next == plan.size() || events[i].node_id != plan[next].node_id ||
+            events[i].details != plan[next].trace_tag) {
+            std::cerr << "KernelDispatch event does not match the compiled plan" << std::endl;
+            exit(1);
+        }
+        next++;
+    }
+
+    // Softmax rows sum to 1
+    const float* out = static_cast<const float*>(e.get_buffer(sm));
+    for (int r = 0; r < 4; ++r) {
+        float sum = 0.0f;
+        for (int c = 0; c < 8; ++c) sum += out[r * 8 + c];
+        if (std::abs(sum - 1.0f) > 1e-5f) {
+            std::cerr << "Row " << r << " sums to " << sum << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_shape_errors_at_compile() {
+    std::cout << "Testing Compile-Time Shape Validation..." << std::endl;
+    ir::Graph g;
+    size_t a = add_input(g, "A", {4, 8});
+    size_t b = add_input(g, "B", {4, 8});
+    size_t mm = add_op(g, ir::OpType::MatMul, {a, b}, {4, 8}); // K mismatch
+    g.outputs.push_back({mm});
+
+    Engine e(g);
+    bool threw = false;
+    try {
+        e.compile();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cerr << "MatMul dimension mismatch must be rejected by compile()" << std::endl;
+        exit(1);
+    }
+
+    // A failed compile leaves the engine unusable until it compiles cleanly.
+    threw = false;
+    try {
+        e.execute();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cerr << "execute() ran after a failed compile()" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_plan_matches_trace();
+    test_shape_errors_at_compile();
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+
+using namespace vectoria;
+using kernels::reference::f32_to_f16;
+using kernels::reference::f16_to_f32;
+
+uint32_t bits_of(float x) {
+    uint32_t b;
+    std::memcpy(&b, &x, sizeof(b));
+    return b;
+}
+
+std::vector<uint16_t> to_half(const std::vector<float>& x) {
+    std::vector<uint16_t> h(x.size());
+    kernels::reference::convert_f32_to_f16(x.data(), h.data(), x.size());
+    return h;
+}
+
+std::vector<float> to_float(const std::vector<uint16_t>& h) {
+    std::vector<float> x(h.size());
+    kernels::reference::convert_f16_to_f32(h.data(), x.data(), h.size());
+    return x;
+}
+
+// Decoding is exact, so every half survives a round trip (NaNs as NaNs).
+void test_conversion() {
+    std::cout << "Testing FP16 <-> FP32 conversion ... ";
+    for (uint32_t h = 0; h < 65536; ++h) {
+        const float x = f16_to_f32(static_cast<uint16_t>(h));
+        const bool nan = (h & 0x7C00) == 0x7C00 && (h & 0x03FF);
+        if (nan ? !std::isnan(x) || (f32_to_f16(x) & 0x7FFF) <= 0x7C00 : f32_to_f16(x) != h) {
+            std::cout << "FAILED (half 0x" << std::hex << h << " round trip)" << std::endl;
+            exit(1);
+        }
+    }
+    // Round to nearest, ties to even, at the mantissa edge, the overflow
+    // threshold and the bottom of the subnormal range.
+    const struct { float in; float out; } cases[] = {
+        {1.0f + std::ldexp(1.0f, -11), 1.0f},
+        {1.0f + 3.0f * std::ldexp(1.0f, -11), 1.0f + std::ldexp(1.0f, -9)},
+        {1.0f + std::ldexp(1.0f, -11) + std::ldexp(1.0f, -20), 1.0f + std::ldexp(1.0f, -10)},
+        {65504.0f, 65504.0f}, {65519.0f, 65504.0f}, {65520.0f, INFINITY}, {-1e10f, -INFINITY},
+        {std::ldexp(1.0f, -24), std::ldexp(1.0f, -24)}, {std::ldexp(1.0f, -25), 0.0f},
+        {std::ldexp(1.5f, -25), std::ldexp(1.0f, -24)}, {std::ldexp(3.0f, -25), std::ldexp(2.0f, -24)},
+        {-std::ldexp(1.0f, -30), -0.0f},
+    };
+    for (const auto& c : cases) {
+        if (bits_of(f16_to_f32(f32_to_f16(c.in))) != bits_of(c.out)) {
+            std::cout << "FAILED (" << c.in << " -> " << f16_to_f32(f32_to_f16(c.in)) << ", expected " << c.out << ")" << std::endl;
+            exit(1);
+        }
+    }
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    std::vector<uint16_t> all(65536 + 5);
+    for (size_t h = 0; h < all.size(); ++h) all[h] = static_cast<uint16_t>(h);
+    std::vector<float> simd(all.size());
+    convert_f16_f32_avx2(all.data(), simd.data(), all.size());
+    const std::vector<float> ref = to_float(all);
+    if (std::memcmp(simd.data(), ref.data(), ref.size() * sizeof(float)) != 0) {
+        std::cout << "FAILED (convert_f16_f32_avx2 differs from the reference)" << std::endl;
+        exit(1);
+    }
+#endif
+    std::cout << "PASSED" << std::endl;
+}
+
+// FP16-weight GEMMs accumulate in FP32 and must give the bits of the FP32
+// GEMM of their family on the decoded weights.
+void test_kernel(gemm_f16w_f32_t gemm_f16w, gemm_f32_t gemm, const char* name) {
+    std::cout << "Testing " << name << " against FP32 on decoded weights ... ";
+    test::DeterministicRNG rng(2121);
+    const size_t shapes[][3] = {{1, 1, 1}, {5, 7, 3}, {6, 16, 8}, {13, 33, 70}, {97, 50, 400}, {7, 1030, 9}, {4, 3, 0}};
+    for (const auto& s : shapes) {
+        const size_t m = s[0], n = s[1], k = s[2];
+        std::vector<float> a(m * k + 1), b(k * n + 1), c0(m * n);
+        rng.fill(a.data(), a.size());
+        rng.fill(b.data(), b.size());
+        rng.fill(c0.data(), c0.size());
+        const std::vector<uint16_t> b_half = to_half(b);
+        const std::vector<float> b_decoded = to_float(b_half);
+        for (float beta : {0.0f, 0.5f}) {
+            std::vector<float> expected = c0, out = c0;
+            gemm(a.data(), b_decoded.data(), expected.data(), m, n, k, k, n, n, 1.5f, beta);
+            if (gemm_f16w(a.data(), b_half.data(), out.data(), m, n, k, k, n, n, 1.5f, beta) != VECTORIA_SUCCESS ||
+                std::memcmp(out.data(), expected.data(), out.size() * sizeof(float)) != 0) {
+                std::cout << "FAILED ([" << m << ", " << n << ", " << k << "] beta " << beta << ")" << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+ir::Graph build_projection(int64_t t, int64_t d, int64_t n, ir::DataType weights) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{t, d}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{d, n}}, weights, 1} });
+    ir::OpNode mm{ir::OpType::MatMul, {{0}, {1}}, {{t, n}}, ir::DataType::Float32, {}};
+    g.nodes.push_back({ {2}, mm });
+    ir::OpNode relu{ir::OpType::Relu, {{2}}, {{t, n}}, ir::DataType::Float32, {}};
+    g.nodes.push_back({ {3}, relu });
+    g.outputs = {{3}};
+    return g;
+}
+
+struct Run {
+    std::vector<float> out;
+    size_t peak = 0;
+    std::string tag;
+};
+
+Run run(const ir::Graph& g, KernelPolicy policy, size_t threads, const std::vector<float>& x, const void* w, size_t w_bytes) {
+    EngineConfig cfg;
+    cfg.policy = policy;
+    cfg.num_threads = threads;
+    Engine e(g, cfg);
+    e.compile();
+    std::memcpy(e.get_buffer(0), x.data(), x.size() * sizeof(float));
+    std::memcpy(e.get_buffer(1), w, w_bytes);
+    e.execute();
+    Run r;
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == trace::EventType::MemoryAllocation && ev.details.rfind("Plan |", 0) == 0) {
+            r.peak = std::stoull(ev.details.substr(ev.details.find("Peak:") + 5));
+        }
+    }
+    for (const auto& step : e.get_plan()) {
+        if (step.node_id == 2) r.tag = step.trace_tag;
+    }
+    const auto& shape = std::get<ir::OpNode>(g.nodes[3].data).output_shape;
+    const float* y = static_cast<const float*>(e.get_buffer(3));
+    r.out.assign(y, y + shape.dims[0] * shape.dims[1]);
+    return r;
+}
+
+// A MatMul reading FP16 parameters matches the FP32 graph holding the
+// decoded weights bit for bit, single-threaded and tiled, in less memory.
+void test_engine(KernelPolicy policy) {
+    std::cout << "Testing MatMul with FP16 weights (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference") << ") ... ";
+    const int64_t t = 70, d = 96, n = 200;
+    std::vector<float> x(t * d), w(d * n);
+    test::DeterministicRNG(7).fill(x.data(), x.size());
+    test::DeterministicRNG(8).fill(w.data(), w.size());
+    const std::vector<uint16_t> w_half = to_half(w);
+    const std::vector<float> w_decoded = to_float(w_half);
+    const ir::Graph g16 = build_projection(t, d, n, ir::DataType::Float16);
+    const ir::Graph g32 = build_projection(t, d, n, ir::DataType::Float32);
+    for (size_t threads : {1, 4}) {
+        Run half = run(g16, policy, threads, x, w_half.data(), w_half.size() * sizeof(uint16_t));
+        Run full = run(g32, policy, threads, x, w_decoded.data(), w_decoded.size() * sizeof(float));
+        if (std::memcmp(half.out.data(), full.out.data(), full.out.size() * sizeof(float)) != 0) {
+            std::cout << "FAILED (outputs differ on " << threads << " threads)" << std::endl;
+            exit(1);
+        }
+        if (half.tag.find("Weights: F16") == std::string::npos || full.tag.find("Weights: F16") != std::string::npos) {
+            std::cout << "FAILED (tag '" << half.tag << "')" << std::endl;
+            exit(1);
+        }
+        if (half.peak + w_half.size() * sizeof(uint16_t) != full.peak) {
+            std::cout << "FAILED (peak " << half.peak << " vs " << full.peak << " bytes)" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_errors() {
+    std::cout << "Testing FP16 tensor errors ... ";
+    // FP16 is only accepted as MatMul weights, untransposed.
+    for (int variant = 0; variant < 3; ++variant) {
+        ir::Graph g;
+        g.nodes.push_back({ {0}, ir::InputNode{"A", {{4, 6}}, variant == 1 ? ir::DataType::Float16 : ir::DataType::Float32} });
+        g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{variant == 2 ? 4 : 6, variant == 2 ? 6 : 4}}, ir::DataType::Float16, 1} });
+        ir::OpNode op{ir::OpType::MatMul, {{0}, {1}}, {{4, 4}}, ir::DataType::Float32, {}};
+        if (variant == 0) op = ir::OpNode{ir::OpType::Add, {{1}, {1}}, {{6, 4}}, ir::DataType::Float32, {}};
+        if (variant == 2) op.int_params = {static_cast<int64_t>(ir::MatMulTranspose::B)};
+        g.nodes.push_back({ {2}, op });
+        g.outputs = {{2}};
+        bool threw = false;
+        try {
+            Engine e(g);
+            e.compile();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cout << "FAILED (variant " << variant << " compiled)" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating FP16 Weights..." << std::endl;
+    test_conversion();
+    test_kernel(kernels::reference::gemm_f16w_f32, kernels::reference::gemm_f32, "gemm_f16w_f32");
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_kernel(gemm_f16w_f32_avx2_packed, gemm_f32_avx2_packed, "gemm_f16w_f32_avx2_packed");
+#endif
+    test_engine(KernelPolicy::Reference);
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_engine(KernelPolicy::SIMD);
+#endif
+    test_errors();
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
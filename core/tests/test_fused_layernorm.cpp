@@ -0,0 +1,144 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace vectoria;
+
+// Leaves as test::fill_leaves() writes them, X rows shifted by `offset`.
+test::LeafFill leaves(float offset) { return {1, 4.0f, offset}; }
+
+ir::Graph build_layernorm(int64_t rows, int64_t cols, bool fused) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{rows, cols}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::ParameterNode{"Gamma", {{cols}}, ir::DataType::Float32, 0} });
+    g.nodes.push_back({ {2}, ir::ParameterNode{"Beta", {{cols}}, ir::DataType::Float32, 0} });
+    int out = graph::add_layernorm_composed(g, 0, 1, 2, fused);
+    g.outputs = {{static_cast<size_t>(out)}};
+    return g;
+}
+
+// Double-precision LayerNorm of the leaves test::fill_leaves() writes for build_layernorm().
+std::vector<float> exact(int64_t rows, int64_t cols, float offset) {
+    std::vector<float> x(static_cast<size_t>(rows * cols)), gamma(cols), beta(cols), y(x.size());
+    test::DeterministicRNG(1).fill(x.data(), x.size(), 4.0f);
+    test::DeterministicRNG(2).fill(gamma.data(), gamma.size(), 4.0f);
+    test::DeterministicRNG(3).fill(beta.data(), beta.size(), 4.0f);
+    for (int64_t i = 0; i < rows; ++i) {
+        const float* row = x.data() + i * cols;
+        double mean = 0.0, var = 0.0;
+        for (int64_t j = 0; j < cols; ++j) mean += static_cast<double>(row[j] + offset);
+        mean /= cols;
+        for (int64_t j = 0; j < cols; ++j) var += (row[j] + offset - mean) * (row[j] + offset - mean);
+        var /= cols;
+        for (int64_t j = 0; j < cols; ++j) {
+            y[i * cols + j] = static_cast<float>((row[j] + offset - mean) / std::sqrt(var + 1e-5) * gamma[j] + beta[j]);
+        }
+    }
+    return y;
+}
+
+// Offset 100 puts every row far from zero, so mean and variance come from
+// cancelling large sums: the fused kernel's shifted moments must stay within
+// 1e-5 of double precision. The expansion's ReduceSum of those rows can be
+// ~5e-5 off, hence 1e-4 between the two.
+void certify(KernelPolicy policy) {
+    std::cout << "Certifying fused LayerNorm (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference")
+              << ") against the expansion ... ";
+    const int64_t shapes[][2] = {{1, 1}, {3, 7}, {4, 8}, {5, 17}, {2, 64}, {16, 129}, {1, 768}};
+    for (const auto& s : shapes) {
+        for (float offset : {0.0f, 100.0f}) {
+            std::vector<float> expected = test::run(build_layernorm(s[0], s[1], false), KernelPolicy::Reference, leaves(offset));
+            size_t steps = 0;
+            std::vector<float> out = test::run(build_layernorm(s[0], s[1], true), policy, leaves(offset), 1, test::count_steps(steps));
+            if (steps != 4) {
+                std::cout << "FAILED (fused plan has " << steps << " steps)" << std::endl;
+                exit(1);
+            }
+            std::string where;
+            if (!test::close(out, expected, 1e-4f, where) || !test::close(out, exact(s[0], s[1], offset), 1e-5f, where)) {
+                std::cout << "FAILED ([" << s[0] << ", " << s[1] << "] offset " << offset << " at " << where << ")" << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_encoder(KernelPolicy policy) {
+    std::cout << "Testing encoder with fused LayerNorm (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference") << ") ... ";
+    auto build = [](bool fuse_layernorm) {
+        test::EncoderOptions opt{19, 32, 64, 2};
+        opt.fuse_layernorm = fuse_layernorm;
+        return test::build_encoder(opt).g;
+    };
+    ir::Graph unfused = build(false);
+    ir::Graph fused = build(true);
+    if (fused.nodes.size() + 2 * 12 != unfused.nodes.size()) {
+        std::cout << "FAILED (expected 24 fewer nodes, got " << unfused.nodes.size() - fused.nodes.size() << ")" << std::endl;
+        exit(1);
+    }
+    std::string where;
+    if (!test::close(test::run(fused, policy, leaves(0.0f)), test::run(unfused, policy, leaves(0.0f)), 1e-4f, where)) {
+        std::cout << "FAILED (at " << where << ")" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+// Row 1 carries a 1e4 offset (cancellation in the 8-lane moments) and row 2
+// is constant, where the zero variance must give exactly beta.
+void test_twin() {
+    std::cout << "Testing LayerNorm [AVX2] against its Reference twin ... ";
+    test::DeterministicRNG rng(91);
+    for (size_t inner = 1; inner <= 40; ++inner) {
+        const size_t outer = 4;
+        std::vector<float> x(outer * inner), gamma(inner), beta(inner), expected(x.size()), out(x.size());
+        rng.fill(x.data(), x.size(), 10.0f);
+        rng.fill(gamma.data(), inner);
+        rng.fill(beta.data(), inner);
+        for (size_t j = 0; j < inner; ++j) {
+            x[inner + j] += 1e4f;      // large common offset
+            x[2 * inner + j] = 3.25f;  // constant row: output is exactly beta
+        }
+        kernels::reference::layernorm_f32(x.data(), gamma.data(), beta.data(), expected.data(), outer, inner, 1e-5f);
+        layernorm_f32_avx2(x.data(), gamma.data(), beta.data(), out.data(), outer, inner, 1e-5f);
+        for (size_t j = 0; j < inner; ++j) {
+            if (out[2 * inner + j] != beta[j] || expected[2 * inner + j] != beta[j]) {
+                std::cout << "FAILED (constant row, inner=" << inner << ")" << std::endl;
+                exit(1);
+            }
+        }
+        std::string where;
+        if (!test::close(out, expected, 2e-5f, where)) {
+            std::cout << "FAILED (inner=" << inner << " at " << where << ")" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+#endif
+
+int main() {
+    std::cout << "Validating Fused LayerNorm..." << std::endl;
+    certify(KernelPolicy::Reference);
+    certify(KernelPolicy::SIMD);
+    test_encoder(KernelPolicy::Reference);
+#ifdef VECTORIA_USE_ASM
+    test_encoder(KernelPolicy::SIMD);
+#endif
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_twin();
+#endif
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+using namespace vectoria;
+
+bool same_bits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+// Unfused composition of the epilogue on a finished GEMM output, as
+// BiasAdd + Relu apply it (relu_f32 and relu_f32_avx2 agree: max(x, 0)).
+void apply_epilogue(std::vector<float>& c, const std::vector<float>& bias, size_t m, size_t n, uint32_t epilogue) {
+    if (epilogue == VECTORIA_EPILOGUE_NONE) return;
+    std::vector<float> biased(c.size());
+    kernels::reference::bias_add_f32(c.data(), bias.data(), biased.data(), m, n);
+    c = biased;
+    if (epilogue == VECTORIA_EPILOGUE_BIAS_RELU) kernels::reference::relu_f32(c.data(), c.data(), c.size());
+}
+
+void test_kernels(size_t m, size_t n, size_t k, uint32_t epilogue) {
+    std::cout << "Testing FusedLinear kernels [" << m << "x" << n << "x" << k << " epilogue " << epilogue << "] ... ";
+    test::DeterministicRNG rng(static_cast<uint32_t>(m * 31 + n * 17 + k + epilogue));
+    std::vector<float> a(m * k + 1), b(k * n + 1), bias(n); // never empty: kernels reject null inputs
+    rng.fill(a.data(), a.size());
+    rng.fill(b.data(), b.size());
+    rng.fill(bias.data(), bias.size());
+    if (n > 2) {
+        bias[0] = -0.0f;
+        bias[1] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    std::vector<float> unfused(m * n), fused(m * n, 42.0f);
+    kernels::reference::gemm_f32(a.data(), b.data(), unfused.data(), m, n, k, k, n, n, 1.0f, 0.0f);
+    apply_epilogue(unfused, bias, m, n, epilogue);
+    if (kernels::reference::linear_f32(a.data(), b.data(), bias.data(), fused.data(), m, n, k, k, n, n, epilogue) != VECTORIA_SUCCESS ||
+        !same_bits(unfused, fused)) {
+        std::cout << "FAILED (reference twin)" << std::endl;
+        exit(1);
+    }
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    std::vector<float> simd_unfused(m * n), simd_fused(m * n, 42.0f);
+    gemm_f32_avx2(a.data(), b.data(), simd_unfused.data(), m, n, k, k, n, n, 1.0f, 0.0f);
+    apply_epilogue(simd_unfused, bias, m, n, epilogue);
+    if (linear_f32_avx2(a.data(), b.data(), bias.data(), simd_fused.data(), m, n, k, k, n, n, epilogue) != VECTORIA_SUCCESS ||
+        !same_bits(simd_unfused, simd_fused)) {
+        std::cout << "FAILED (AVX2 epilogue)" << std::endl;
+        exit(1);
+    }
+#endif
+    std::cout << "PASSED" << std::endl;
+}
+
+// --- Engine level: FusedLinear nodes vs MatMul -> BiasAdd -> Relu ---
+
+std::vector<float> run_graph(const ir::Graph& g, KernelPolicy policy, size_t threads, std::string* tags = nullptr) {
+    return test::run(g, policy, {}, threads, [tags](const Engine& e) {
+        if (!tags) return;
+        for (const auto& ev : e.get_tracer().get_events()) {
+            if (ev.type == trace::EventType::KernelDispatch) *tags += ev.details + "\n";
+        }
+    });
+}
+
+ir::Graph build_encoder(bool fuse_ffn) {
+    test::EncoderOptions opt{101, 32, 96, 4};
+    opt.fuse_ffn = fuse_ffn;
+    return test::build_encoder(opt).g;
+}
+
+void test_encoder_equivalence(KernelPolicy policy, const char* label) {
+    std::cout << "Testing Fused FFN Encoder Equivalence (" << label << ") ... ";
+    ir::Graph unfused = build_encoder(false);
+    ir::Graph fused = build_encoder(true);
+    if (fused.nodes.size() + 3 != unfused.nodes.size()) {
+        std::cout << "FAILED (expected 3 fewer nodes)" << std::endl;
+        exit(1);
+    }
+
+    std::vector<float> golden = run_graph(unfused, policy, 1);
+    for (size_t threads : {1, 4}) {
+        std::string tags;
+        std::vector<float> out = run_graph(fused, policy, threads, &tags);
+        if (!same_bits(golden, out)) {
+            std::cout << "FAILED (threads " << threads << ")" << std::endl;
+            exit(1);
+        }
+        bool has_bias = tags.find("Epilogue: Bias\n") != std::string::npos || tags.find("Epilogue: Bias |") != std::string::npos;
+        if (tags.find("Epilogue: BiasRelu") == std::string::npos || !has_bias) {
+            std::cout << "FAILED (missing epilogue in trace)" << std::endl << tags;
+            exit(1);
+        }
+        if (threads > 1 && tags.find("Epilogue: BiasRelu | Tiles:") == std::string::npos) {
+            std::cout << "FAILED (FFN1 not tiled)" << std::endl << tags;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_invalid_nodes() {
+    std::cout << "Testing FusedLinear Validation ... ";
+    auto build = [](std::vector<int64_t> params, size_t bias_len, bool with_bias) {
+        ir::Graph g;
+        g.nodes.push_back({ {0}, ir::InputNode{"X", {{4, 8}}, ir::DataType::Float32} });
+        g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{8, 5}}, ir::DataType::Float32, 0} });
+        g.nodes.push_back({ {2}, ir::ParameterNode{"B", {{static_cast<int64_t>(bias_len)}}, ir::DataType::Float32, 0} });
+        ir::OpNode op{ir::OpType::FusedLinear, {{0}, {1}}, {{4, 5}}, ir::DataType::Float32, params};
+        if (with_bias) op.inputs.push_back({2});
+        g.nodes.push_back({ {3}, op });
+        g.outputs.push_back({3});
+        return g;
+    };
+    auto rejects = [](const ir::Graph& g) {
+        try {
+            Engine e(g);
+            e.compile();
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    if (!rejects(build({}, 5, true)) || !rejects(build({3}, 5, true)) ||
+        !rejects(build({2}, 5, false)) || !rejects(build({1}, 4, true)) ||
+        rejects(build({0}, 5, false)) || rejects(build({2}, 5, true))) {
+        std::cout << "FAILED" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    const uint32_t epilogues[] = {VECTORIA_EPILOGUE_NONE, VECTORIA_EPILOGUE_BIAS, VECTORIA_EPILOGUE_BIAS_RELU};
+    for (uint32_t ep : epilogues) {
+        // Exact 6x16 tiles, ragged edges, K split across blocks, empty K.
+        test_kernels(6, 16, 8, ep);
+        test_kernels(7, 19, 33, ep);
+        test_kernels(50, 70, 400, ep);
+        test_kernels(3, 1030, 9, ep);
+        test_kernels(5, 9, 0, ep);
+    }
+
+    test_encoder_equivalence(KernelPolicy::Reference, "Reference");
+#ifdef VECTORIA_USE_ASM
+    test_encoder_equivalence(KernelPolicy::SIMD, "SIMD");
+#endif
+    test_invalid_nodes();
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
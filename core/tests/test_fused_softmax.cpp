@@ -0,0 +1,131 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace vectoria;
+
+enum class Kind { Softmax, StableSoftmax, LogSoftmax };
+
+const char* kind_name(Kind k) {
+    return k == Kind::Softmax ? "Softmax" : (k == Kind::StableSoftmax ? "StableSoftmax" : "LogSoftmax");
+}
+
+// Runs the composer (fused or expanded) on X [rows, cols] and returns the output.
+std::vector<float> run(Kind kind, bool fused, KernelPolicy policy, const std::vector<float>& x,
+                       int64_t rows, int64_t cols, size_t* steps = nullptr) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{rows, cols}}, ir::DataType::Float32} });
+    int out = kind == Kind::Softmax ? graph::add_softmax_composed(g, 0, fused)
+            : kind == Kind::StableSoftmax ? graph::add_softmax_stable_composed(g, 0, fused)
+            : graph::add_logsoftmax_composed(g, 0, fused);
+    g.outputs = {{static_cast<size_t>(out)}};
+
+    EngineConfig cfg;
+    cfg.policy = policy;
+    Engine e(g, cfg);
+    e.compile();
+    if (steps) *steps = e.get_plan().size();
+    std::copy(x.begin(), x.end(), static_cast<float*>(e.get_buffer(0)));
+    e.execute();
+    const float* y = static_cast<const float*>(e.get_buffer(static_cast<size_t>(out)));
+    return std::vector<float>(y, y + x.size());
+}
+
+// One logit per row sits ~1000 above the rest, so the unshifted exp would
+// overflow and LogSoftmax outputs reach -1000: the fused max shift has to
+// match the expansion's, and those log-probabilities are compared relatively.
+void certify(Kind kind, KernelPolicy policy) {
+    std::cout << "Certifying fused " << kind_name(kind) << " (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference")
+              << ") against the expansion ... ";
+    test::DeterministicRNG rng(2024);
+    const int64_t shapes[][2] = {{1, 1}, {3, 7}, {4, 8}, {5, 17}, {2, 64}, {16, 129}, {1, 1000}};
+    for (const auto& s : shapes) {
+        std::vector<float> x(static_cast<size_t>(s[0] * s[1]));
+        rng.fill(x.data(), x.size(), 20.0f);
+        x[0] += 1000.0f; // stability: one large logit
+        std::vector<float> expected = run(kind, false, KernelPolicy::Reference, x, s[0], s[1]);
+        size_t steps = 0;
+        std::vector<float> out = run(kind, true, policy, x, s[0], s[1], &steps);
+        if (steps != 2) {
+            std::cout << "FAILED (fused plan has " << steps << " steps)" << std::endl;
+            exit(1);
+        }
+        std::string where;
+        if (!test::close(out, expected, 1e-5f, where)) {
+            std::cout << "FAILED ([" << s[0] << ", " << s[1] << "] at " << where << ")" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_properties() {
+    std::cout << "Testing fused Softmax rows sum to 1 and LogSoftmax of equal logits ... ";
+    std::vector<float> x(3 * 1000);
+    test::DeterministicRNG rng(5);
+    rng.fill(x.data(), x.size(), 50.0f);
+    std::vector<float> p = run(Kind::Softmax, true, KernelPolicy::SIMD, x, 3, 1000);
+    for (size_t r = 0; r < 3; ++r) {
+        double sum = 0.0;
+        for (size_t c = 0; c < 1000; ++c) sum += p[r * 1000 + c];
+        if (std::abs(sum - 1.0) > 1e-5) {
+            std::cout << "FAILED (row " << r << " sums to " << sum << ")" << std::endl;
+            exit(1);
+        }
+    }
+    std::vector<float> same(2 * 5, 1000.0f);
+    std::vector<float> l = run(Kind::LogSoftmax, true, KernelPolicy::SIMD, same, 2, 5);
+    for (float v : l) {
+        if (std::abs(v + std::log(5.0f)) > 1e-6f) {
+            std::cout << "FAILED (" << v << ")" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+// Every row length up to 40 hits each 8-lane tail of the AVX2 kernels.
+void test_twin(VectoriaStatus (*simd)(const float*, float*, size_t, size_t),
+               VectoriaStatus (*ref)(const float*, float*, size_t, size_t), const char* name) {
+    std::cout << "Testing " << name << " [AVX2] against its Reference twin ... ";
+    test::DeterministicRNG rng(77);
+    for (size_t inner = 1; inner <= 40; ++inner) {
+        const size_t outer = 3;
+        std::vector<float> x(outer * inner), expected(x.size()), out(x.size());
+        rng.fill(x.data(), x.size(), 30.0f);
+        ref(x.data(), expected.data(), outer, inner);
+        simd(x.data(), out.data(), outer, inner);
+        std::string where;
+        if (!test::close(out, expected, 1e-5f, where)) {
+            std::cout << "FAILED (inner=" << inner << " at " << where << ")" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+#endif
+
+int main() {
+    std::cout << "Validating Fused Softmax / LogSoftmax..." << std::endl;
+    for (Kind kind : {Kind::Softmax, Kind::StableSoftmax, Kind::LogSoftmax}) {
+        certify(kind, KernelPolicy::Reference);
+        certify(kind, KernelPolicy::SIMD);
+    }
+    test_properties();
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_twin(softmax_f32_avx2, kernels::reference::softmax_f32, "Softmax");
+    test_twin(logsoftmax_f32_avx2, kernels::reference::logsoftmax_f32, "LogSoftmax");
+#endif
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include "vectoria/memory.hpp" // For Arena/Aligned alloc
 #include <iostream>
 #include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 
 using namespace vectoria;
 
@@ -81,6 +84,34 @@ void run_test(size_t m, size_t n, size_t k) {
 #endif
 }
 
+// With beta == 0, C is write-only: stale NaNs in a reused buffer must not leak into the result.
+void run_beta_zero_test(size_t m, size_t n, size_t k) {
+    std::cout << "Testing GEMM beta=0 over NaN-filled C [" << m << "x" << n << "x" << k << "] ... ";
+
+    test::DeterministicRNG rng;
+    std::vector<float> a(m * k), b(k * n);
+    rng.fill(a.data(), m * k);
+    rng.fill(b.data(), k * n);
+
+    std::vector<float> c_ref(m * n, std::numeric_limits<float>::quiet_NaN());
+    std::vector<float> c_simd(m * n, std::numeric_limits<float>::quiet_NaN());
+
+    kernels::reference::gemm_f32(a.data(), b.data(), c_ref.data(), m, n, k, k, n, n, 1.0f, 0.0f);
+#if defined(VECTORIA_USE_ASM) && (defined(__x86_64__) || defined(__aarch64__))
+    call_simd_kernel(a.data(), b.data(), c_simd.data(), m, n, k, k, n, n, 1.0f, 0.0f);
+#else
+    c_simd = c_ref;
+#endif
+
+    for (size_t i = 0; i < m * n; ++i) {
+        if (std::isnan(c_ref[i]) || std::isnan(c_simd[i])) {
+            std::cout << "FAILED (NaN at " << i << ")" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
 int main() {
     std::cout << "=== SIMD Correctness Validation ===" << std::endl;
     
@@ -94,6 +125,8 @@ int main() {
     
     // Larger
     run_test(64, 64, 64);
+
+    run_beta_zero_test(5, 19, 7);
     
     return 0;
 }
@@ -0,0 +1,172 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdlib>
+
+using namespace vectoria;
+
+size_t add_input(ir::Graph& g, const std::string& name, std::vector<int64_t> dims) {
+    size_t id = g.nodes.size();
+    g.nodes.push_back({ {id}, ir::InputNode{name, {dims}, ir::DataType::Float32} });
+    return id;
+}
+
+size_t add_const(ir::Graph& g, std::vector<int64_t> dims, std::vector<float> data) {
+    size_t id = g.nodes.size();
+    g.nodes.push_back({ {id}, ir::ConstantNode{{dims}, ir::DataType::Float32, data} });
+    return id;
+}
+
+size_t add_op(ir::Graph& g, ir::OpType type, std::vector<size_t> inputs, std::vector<int64_t> dims) {
+    size_t id = g.nodes.size();
+    ir::OpNode op;
+    op.op = type;
+    for (auto i : inputs) op.inputs.push_back({i});
+    op.output_shape.dims = dims;
+    op.output_dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {id}, op });
+    return id;
+}
+
+// GraphCompilation details by node id, e.g. "Folded | Constant" or "Merged | Into: 3".
+std::map<size_t, std::string> rewrites(const Engine& e) {
+    std::map<size_t, std::string> out;
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type != trace::EventType::GraphCompilation || ev.node_id < 0) continue;
+        if (ev.details.rfind("Folded", 0) == 0 || ev.details.rfind("Merged", 0) == 0) {
+            out[ev.node_id] += ev.details + ";";
+        }
+    }
+    return out;
+}
+
+size_t count_events(const Engine& e, trace::EventType type) {
+    size_t n = 0;
+    for (const auto& ev : e.get_tracer().get_events()) n += (ev.type == type);
+    return n;
+}
+
+void test_fold_and_merge(KernelPolicy policy, const char* label) {
+    std::cout << "Testing Constant Folding and CSE (" << label << ")..." << std::endl;
+    ir::Graph g;
+    size_t x = add_input(g, "X", {2, 3});
+    size_t c1 = add_const(g, {2, 3}, {0.5f, -1.0f, 2.0f, 0.25f, 3.0f, -0.75f});
+    size_t c2 = add_const(g, {2, 3}, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f});
+    size_t c3 = add_const(g, {2, 3}, {0.5f, -1.0f, 2.0f, 0.25f, 3.0f, -0.75f}); // Same bits as c1
+    size_t a = add_op(g, ir::OpType::Add, {c1, c2}, {2, 3});  // Folded
+    size_t b = add_op(g, ir::OpType::Add, {c3, c2}, {2, 3});  // Folded, then same value as a
+    size_t ex = add_op(g, ir::OpType::Exp, {b}, {2, 3});      // Folded (reads a after rewiring)
+    size_t m1 = add_op(g, ir::OpType::Mul, {x, ex}, {2, 3});
+    size_t m2 = add_op(g, ir::OpType::Mul, {x, ex}, {2, 3});  // Same as m1
+    size_t out = add_op(g, ir::OpType::Add, {m1, m2}, {2, 3});
+    g.outputs.push_back({out});
+    g.outputs.push_back({m2});
+
+    const float x_data[6] = {1.0f, 2.0f, -3.0f, 0.5f, -0.5f, 4.0f};
+    auto run = [&](Engine& e) {
+        e.compile();
+        std::copy(x_data, x_data + 6, static_cast<float*>(e.get_buffer(x)));
+        e.execute();
+    };
+
+    EngineConfig base_cfg;
+    base_cfg.policy = policy;
+    Engine base(g, base_cfg);
+    run(base);
+
+    for (size_t threads : {1, 3}) {
+        EngineConfig cfg = base_cfg;
+        cfg.optimize_graph = true;
+        cfg.num_threads = threads;
+        Engine e(g, cfg);
+        run(e);
+
+        for (size_t node : {out, m2}) {
+            const float* got = static_cast<const float*>(e.get_buffer(node));
+            const float* want = static_cast<const float*>(base.get_buffer(node));
+            for (size_t i = 0; i < 6; ++i) {
+                if (got[i] != want[i]) {
+                    std::cerr << "Node " << node << " differs at " << i << ": " << got[i] << " vs " << want[i] << std::endl;
+                    exit(1);
+                }
+            }
+        }
+        if (e.get_buffer(m2) != e.get_buffer(m1)) {
+            std::cerr << "Merged output does not share its canonical buffer" << std::endl;
+            exit(1);
+        }
+
+        std::map<size_t, std::string> expected = {
+            {c3, "Merged | Into: " + std::to_string(c1) + ";"},
+            {a, "Folded | Constant;"},
+            {b, "Folded | Constant;Merged | Into: " + std::to_string(a) + ";"},
+            {ex, "Folded | Constant;"},
+            {m2, "Merged | Into: " + std::to_string(m1) + ";"},
+        };
+        std::map<size_t, std::string> got = rewrites(e);
+        if (got != expected) {
+            std::cerr << "Unexpected rewrites:" << std::endl;
+            for (const auto& kv : got) std::cerr << "  " << kv.first << ": " << kv.second << std::endl;
+            exit(1);
+        }
+
+        // Only m1 and the final Add are left to run.
+        if (count_events(e, trace::EventType::KernelDispatch) != 2) {
+            std::cerr << "Expected 2 kernel dispatches, got "
+                      << count_events(e, trace::EventType::KernelDispatch) << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_encoder_dedupe() {
+    std::cout << "Testing Simplified Transformer Encoder..." << std::endl;
+    test::EncoderGraph eg = test::build_encoder({8, 16, 32, 2});
+    const ir::Graph& g = eg.g;
+    const size_t out = eg.out;
+    auto run = [&](Engine& e) {
+        e.compile();
+        test::fill_leaves(g, e, {99, 0.5f});
+        e.execute();
+    };
+
+    Engine base(g);
+    run(base);
+    EngineConfig cfg;
+    cfg.optimize_graph = true;
+    Engine e(g, cfg);
+    run(e);
+
+    const float* got = static_cast<const float*>(e.get_buffer(out));
+    const float* want = static_cast<const float*>(base.get_buffer(out));
+    for (size_t i = 0; i < test::element_count(g, out); ++i) {
+        if (got[i] != want[i]) {
+            std::cerr << "Encoder output differs at " << i << std::endl;
+            exit(1);
+        }
+    }
+
+    // The two LayerNorms (and the attention heads) repeat the same scalar constants.
+    size_t merged = 0;
+    for (const auto& kv : rewrites(e)) merged += kv.second.rfind("Merged", 0) == 0;
+    if (merged == 0) {
+        std::cerr << "No duplicate constants were merged" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_fold_and_merge(KernelPolicy::Reference, "Reference");
+#ifdef VECTORIA_USE_ASM
+    test_fold_and_merge(KernelPolicy::SIMD, "SIMD");
+#endif
+    test_encoder_dedupe();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/memory.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+using namespace vectoria;
+
+void test_planner_invariants() {
+    std::cout << "Testing Memory Planner Invariants..." << std::endl;
+
+    // A chain of four activations plus one pinned buffer.
+    // A[0,1] B[1,2] C[2,3] D[3,3] P(pinned)
+    std::vector<memory::BufferLifetime> reqs = {
+        {256, 0, 1, false},
+        {256, 1, 2, false},
+        {256, 2, 3, false},
+        {100, 3, 3, false},
+        {64,  0, 0, true},
+    };
+
+    memory::MemoryPlan plan = memory::plan_memory(reqs, 64);
+
+    auto overlaps_in_time = [&](size_t a, size_t b) {
+        if (reqs[a].pinned || reqs[b].pinned) return true;
+        return reqs[a].first_use <= reqs[b].last_use && reqs[b].first_use <= reqs[a].last_use;
+    };
+    auto overlaps_in_space = [&](size_t a, size_t b) {
+        size_t a_end = plan.offsets[a] + ((reqs[a].size + 63) / 64) * 64;
+        size_t b_end = plan.offsets[b] + ((reqs[b].size + 63) / 64) * 64;
+        return plan.offsets[a] < b_end && plan.offsets[b] < a_end;
+    };
+
+    for (size_t a = 0; a < reqs.size(); ++a) {
+        if (plan.offsets[a] % 64 != 0) {
+            std::cerr << "Offset of request " << a << " is not aligned" << std::endl;
+            exit(1);
+        }
+        for (size_t b = a + 1; b < reqs.size(); ++b) {
+            if (overlaps_in_time(a, b) && overlaps_in_space(a, b)) {
+                std::cerr << "Live buffers " << a << " and " << b << " share memory" << std::endl;
+                exit(1);
+            }
+        }
+    }
+
+    if (plan.naive_bytes != 256 * 3 + 128 + 64) {
+        std::cerr << "Unexpected naive size: " << plan.naive_bytes << std::endl;
+        exit(1);
+    }
+    // A and C are disjoint in time, so the slab needs only two activation slots.
+    if (plan.peak_bytes >= plan.naive_bytes) {
+        std::cerr << "Planner did not reuse memory: peak " << plan.peak_bytes << std::endl;
+        exit(1);
+    }
+
+    // Same requests, same layout.
+    memory::MemoryPlan again = memory::plan_memory(reqs, 64);
+    if (again.offsets != plan.offsets || again.peak_bytes != plan.peak_bytes) {
+        std::cerr << "Planner is not deterministic" << std::endl;
+        exit(1);
+    }
+
+    std::cout << "PASSED (Peak: " << plan.peak_bytes << " / Naive: " << plan.naive_bytes << ")" << std::endl;
+}
+
+std::vector<float> run_encoder(const test::EncoderGraph& eg, bool plan_memory, size_t& peak, size_t& naive) {
+    EngineConfig cfg;
+    cfg.plan_memory = plan_memory;
+    Engine e(eg.g, cfg);
+    e.compile();
+
+    test::fill_leaves(eg.g, e, {42, 0.5f});
+
+    e.execute();
+    e.execute(); // Reused buffers must not leak state between runs
+
+    peak = naive = 0;
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == trace::EventType::MemoryAllocation && ev.details.rfind("Plan |", 0) == 0) {
+            peak = std::stoull(ev.details.substr(ev.details.find("Peak:") + 5));
+            naive = std::stoull(ev.details.substr(ev.details.find("Naive:") + 6));
+        }
+    }
+
+    return test::read_output(e, eg.g, eg.out);
+}
+
+void test_encoder_planned_vs_naive() {
+    std::cout << "Testing Planned Encoder Memory..." << std::endl;
+    test::EncoderGraph eg = test::build_encoder({8, 16, 32, 4});
+
+    size_t peak_planned, naive_planned, peak_naive, naive_naive;
+    std::vector<float> planned = run_encoder(eg, true, peak_planned, naive_planned);
+    std::vector<float> baseline = run_encoder(eg, false, peak_naive, naive_naive);
+
+    for (size_t i = 0; i < planned.size(); ++i) {
+        if (planned[i] != baseline[i]) {
+            std::cerr << "Planned output differs at " << i << ": " << planned[i] << " vs " << baseline[i] << std::endl;
+            exit(1);
+        }
+    }
+
+    if (peak_naive != naive_naive) {
+        std::cerr << "Unplanned engine should not reuse memory" << std::endl;
+        exit(1);
+    }
+    if (peak_planned == 0 || peak_planned >= naive_planned) {
+        std::cerr << "Planned peak " << peak_planned << " not below naive " << naive_planned << std::endl;
+        exit(1);
+    }
+
+    std::cout << "PASSED (Peak: " << peak_planned << " / Naive: " << naive_planned << " bytes)" << std::endl;
+}
+
+int main() {
+    test_planner_invariants();
+    test_encoder_planned_vs_naive();
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdlib>
+
+using namespace vectoria;
+
+const test::LeafFill kLeaves{2024, 0.5f};
+
+void test_bitwise_vs_serial(KernelPolicy policy, const char* label) {
+    std::cout << "Testing Parallel Executor vs Serial (" << label << ")..." << std::endl;
+    test::EncoderGraph eg = test::build_encoder({16, 32, 64, 4});
+
+    EngineConfig serial_cfg;
+    serial_cfg.policy = policy;
+    Engine serial(eg.g, serial_cfg);
+    serial.compile();
+    test::fill_leaves(eg.g, serial, kLeaves);
+    serial.execute();
+    std::vector<float> golden = test::read_output(serial, eg.g, eg.out);
+
+    for (size_t threads : {2, 4, 7}) {
+        EngineConfig cfg;
+        cfg.policy = policy;
+        cfg.num_threads = threads;
+        Engine e(eg.g, cfg);
+        e.compile();
+        test::fill_leaves(eg.g, e, kLeaves);
+
+        for (int run = 0; run < 20; ++run) {
+            size_t before = e.get_tracer().get_events().size();
+            e.execute();
+
+            std::vector<float> out = test::read_output(e, eg.g, eg.out);
+            for (size_t i = 0; i < golden.size(); ++i) {
+                if (out[i] != golden[i]) {
+                    std::cerr << "Threads=" << threads << " run " << run << " differs at " << i
+                              << ": " << out[i] << " vs " << golden[i] << std::endl;
+                    exit(1);
+                }
+            }
+
+            // Each node logs exactly one Start/End pair per run, from a valid worker.
+            const auto& events = e.get_tracer().get_events();
+            std::vector<int> starts(eg.g.nodes.size(), 0), ends(eg.g.nodes.size(), 0);
+            for (size_t i = before; i < events.size(); ++i) {
+                if (events[i].worker_id >= threads) {
+                    std::cerr << "Event attributed to unknown worker " << events[i].worker_id << std::endl;
+                    exit(1);
+                }
+                if (events[i].type == trace::EventType::NodeExecutionStart) starts[events[i].node_id]++;
+                if (events[i].type == trace::EventType::NodeExecutionEnd) ends[events[i].node_id]++;
+            }
+            for (size_t n = 0; n < eg.g.nodes.size(); ++n) {
+                if (starts[n] != 1 || ends[n] != 1) {
+                    std::cerr << "Node " << n << " traced " << starts[n] << "/" << ends[n] << " times" << std::endl;
+                    exit(1);
+                }
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_unplanned_graph() {
+    std::cout << "Testing Parallel Executor Without Outputs..." << std::endl;
+    // No declared outputs: every buffer is pinned and every intermediate is observable.
+    test::EncoderGraph eg = test::build_encoder({8, 16, 32, 2});
+    eg.g.outputs.clear();
+
+    Engine serial(eg.g);
+    serial.compile();
+    test::fill_leaves(eg.g, serial, kLeaves);
+    serial.execute();
+
+    EngineConfig cfg;
+    cfg.num_threads = 3;
+    Engine e(eg.g, cfg);
+    e.compile();
+    test::fill_leaves(eg.g, e, kLeaves);
+    e.execute();
+
+    for (size_t n = 0; n < eg.g.nodes.size(); ++n) {
+        size_t count = test::element_count(eg.g, n);
+        const float* a = static_cast<const float*>(serial.get_buffer(n));
+        const float* b = static_cast<const float*>(e.get_buffer(n));
+        for (size_t i = 0; i < count; ++i) {
+            if (a[i] != b[i]) {
+                std::cerr << "Intermediate " << n << " differs at " << i << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_error_propagation() {
+#ifndef VECTORIA_USE_ASM
+    std::cout << "Testing Parallel Executor Error Propagation..." << std::endl;
+    // Without ASM, a SIMD MatMul fails at execute(); the error must surface on the caller.
+    test::EncoderGraph eg = test::build_encoder({8, 16, 32, 2});
+    EngineConfig cfg;
+    cfg.policy = KernelPolicy::SIMD;
+    cfg.num_threads = 4;
+    Engine e(eg.g, cfg);
+    e.compile();
+
+    for (int run = 0; run < 3; ++run) {
+        bool threw = false;
+        try {
+            e.execute();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cerr << "Kernel error was swallowed by the executor" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+#endif
+}
+
+int main() {
+    test_bitwise_vs_serial(KernelPolicy::Reference, "Reference");
+#ifdef VECTORIA_USE_ASM
+    test_bitwise_vs_serial(KernelPolicy::SIMD, "SIMD");
+#endif
+    test_unplanned_graph();
+    test_error_propagation();
+    return 0;
+}
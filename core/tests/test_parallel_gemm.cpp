@@ -0,0 +1,139 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/thread_pool.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <atomic>
+#include <cstdlib>
+
+using namespace vectoria;
+
+struct MatMulGraph {
+    ir::Graph g;
+    size_t a, b, out;
+};
+
+MatMulGraph build_matmul(int64_t m, int64_t k, int64_t n) {
+    MatMulGraph mg;
+    ir::Graph& g = mg.g;
+    mg.a = 0;
+    g.nodes.push_back({ {0}, ir::InputNode{"A", {{m, k}}, ir::DataType::Float32} });
+    mg.b = 1;
+    g.nodes.push_back({ {1}, ir::ParameterNode{"B", {{k, n}}, ir::DataType::Float32, 0} });
+    ir::OpNode op;
+    op.op = ir::OpType::MatMul;
+    op.inputs = {{0}, {1}};
+    op.output_shape.dims = {m, n};
+    op.output_dtype = ir::DataType::Float32;
+    mg.out = 2;
+    g.nodes.push_back({ {2}, op });
+    g.outputs.push_back({2});
+    return mg;
+}
+
+std::vector<float> run_matmul(const MatMulGraph& mg, int64_t m, int64_t k, int64_t n,
+                              KernelPolicy policy, size_t threads, std::string* tag) {
+    EngineConfig cfg;
+    cfg.policy = policy;
+    cfg.num_threads = threads;
+    Engine e(mg.g, cfg);
+    e.compile();
+
+    test::DeterministicRNG rng(7);
+    rng.fill(static_cast<float*>(e.get_buffer(mg.a)), m * k);
+    rng.fill(static_cast<float*>(e.get_buffer(mg.b)), k * n);
+    e.execute();
+
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == trace::EventType::KernelDispatch && ev.node_id == mg.out) {
+            *tag = ev.details;
+        }
+    }
+    const float* out = static_cast<const float*>(e.get_buffer(mg.out));
+    return std::vector<float>(out, out + m * n);
+}
+
+void test_thread_count_independence(KernelPolicy policy, const char* label) {
+    std::cout << "Testing Tiled GEMM Across Thread Counts (" << label << ")..." << std::endl;
+    // Ragged in both M and N so edge tiles are partial; the FFN-like case is a clean multiple.
+    const int64_t shapes[][3] = { {70, 37, 150}, {200, 37, 300}, {192, 96, 512}, {70, 5, 300}, {1, 16, 8} };
+
+    for (const auto& s : shapes) {
+        MatMulGraph mg = build_matmul(s[0], s[1], s[2]);
+        std::string serial_tag;
+        std::vector<float> golden = run_matmul(mg, s[0], s[1], s[2], policy, 1, &serial_tag);
+
+        if (serial_tag.find("Tiles:") != std::string::npos) {
+            std::cerr << "Single-threaded MatMul should not be tiled: " << serial_tag << std::endl;
+            exit(1);
+        }
+
+        for (size_t threads : {2, 3, 4, 8}) {
+            std::string tag;
+            std::vector<float> out = run_matmul(mg, s[0], s[1], s[2], policy, threads, &tag);
+            for (size_t i = 0; i < golden.size(); ++i) {
+                if (out[i] != golden[i]) {
+                    std::cerr << s[0] << "x" << s[1] << "x" << s[2] << " threads=" << threads
+                              << " differs at " << i << ": " << out[i] << " vs " << golden[i] << std::endl;
+                    exit(1);
+                }
+            }
+
+            size_t tiles_m = (s[0] + exec::kGemmTileM - 1) / exec::kGemmTileM;
+            size_t tiles_n = (s[2] + exec::kGemmTileN - 1) / exec::kGemmTileN;
+            std::string expected = serial_tag;
+            if (tiles_m * tiles_n > 1) {
+                expected += " | Tiles: " + std::to_string(tiles_m) + "x" + std::to_string(tiles_n) +
+                            " of 96x256 | Threads: " + std::to_string(threads);
+            }
+            if (tag != expected) {
+                std::cerr << "Unexpected dispatch detail '" << tag << "', expected '" << expected << "'" << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_parallel_for() {
+    std::cout << "Testing ThreadPool::parallel_for..." << std::endl;
+    exec::ThreadPool pool(4);
+
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto& h : hits) h.store(0);
+    pool.parallel_for(0, hits.size(), [](void* ctx, size_t i, size_t) {
+        (*static_cast<std::vector<std::atomic<int>>*>(ctx))[i].fetch_add(1);
+    }, &hits);
+    for (size_t i = 0; i < hits.size(); ++i) {
+        if (hits[i].load() != 1) {
+            std::cerr << "Index " << i << " ran " << hits[i].load() << " times" << std::endl;
+            exit(1);
+        }
+    }
+
+    bool threw = false;
+    try {
+        pool.parallel_for(0, 64, [](void*, size_t i, size_t) {
+            if (i == 17) throw std::runtime_error("tile failed");
+        }, nullptr);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cerr << "parallel_for swallowed an exception" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_parallel_for();
+    test_thread_count_independence(KernelPolicy::Reference, "Reference");
+#ifdef VECTORIA_USE_ASM
+    test_thread_count_independence(KernelPolicy::SIMD, "SIMD");
+#endif
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/plan_cache.hpp"
+#include "utils/gemm_validation.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+using namespace vectoria;
+
+struct Model {
+    ir::Graph g;
+    size_t x, w, out;
+};
+
+// X[rows x 16] * W[16 x 16] + 0.5 -> softmax. The constant feeds an Add, so
+// optimize_graph has something to fold when `fold` adds a constant-only op.
+Model build_model(int64_t rows, float bias, const std::string& input_name = "X", bool fold = false) {
+    Model m;
+    ir::Graph& g = m.g;
+    m.x = 0;
+    g.nodes.push_back({ {0}, ir::InputNode{input_name, {{rows, 16}}, ir::DataType::Float32} });
+    m.w = 1;
+    g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{16, 16}}, ir::DataType::Float32, 0} });
+    g.nodes.push_back({ {2}, ir::ConstantNode{{{rows, 16}}, ir::DataType::Float32,
+                                              std::vector<float>(rows * 16, bias)} });
+    size_t c = 2;
+    if (fold) {
+        ir::OpNode twice;
+        twice.op = ir::OpType::Add;
+        twice.inputs = {{2}, {2}};
+        twice.output_shape.dims = {rows, 16};
+        twice.output_dtype = ir::DataType::Float32;
+        g.nodes.push_back({ {3}, twice });
+        c = 3;
+    }
+
+    ir::OpNode mm;
+    mm.op = ir::OpType::MatMul;
+    mm.inputs = {{0}, {1}};
+    mm.output_shape.dims = {rows, 16};
+    mm.output_dtype = ir::DataType::Float32;
+    size_t mm_id = g.nodes.size();
+    g.nodes.push_back({ {mm_id}, mm });
+
+    ir::OpNode add;
+    add.op = ir::OpType::Add;
+    add.inputs = {{mm_id}, {c}};
+    add.output_shape.dims = {rows, 16};
+    add.output_dtype = ir::DataType::Float32;
+    size_t add_id = g.nodes.size();
+    g.nodes.push_back({ {add_id}, add });
+
+    m.out = static_cast<size_t>(graph::add_softmax_composed(g, static_cast<int>(add_id)));
+    g.outputs.push_back({m.out});
+    return m;
+}
+
+std::vector<float> run(Engine& e, const Model& m, int64_t rows) {
+    test::DeterministicRNG rng(21);
+    rng.fill(static_cast<float*>(e.get_buffer(m.x)), rows * 16);
+    rng.fill(static_cast<float*>(e.get_buffer(m.w)), 256);
+    e.execute();
+    const float* out = static_cast<const float*>(e.get_buffer(m.out));
+    return std::vector<float>(out, out + rows * 16);
+}
+
+bool has_event(const Engine& e, const std::string& prefix) {
+    const auto& t = e.get_tracer();
+    for (size_t i = 0; i < t.size(); ++i) {
+        if (t.event_at(i).details.compare(0, prefix.size(), prefix) == 0) return true;
+    }
+    return false;
+}
+
+void test_fingerprint() {
+    std::cout << "Testing Structural Graph Fingerprint..." << std::endl;
+    uint64_t base = cache::graph_fingerprint(build_model(8, 0.5f).g);
+    if (cache::graph_fingerprint(build_model(8, 0.5f).g) != base) {
+        std::cerr << "Fingerprint is not stable for identical graphs" << std::endl;
+        exit(1);
+    }
+    if (cache::graph_fingerprint(build_model(8, 0.5f, "Tokens").g) != base) {
+        std::cerr << "Input names must not change the fingerprint" << std::endl;
+        exit(1);
+    }
+    if (cache::graph_fingerprint(build_model(4, 0.5f).g) == base ||
+        cache::graph_fingerprint(build_model(8, 0.25f).g) == base ||
+        cache::graph_fingerprint(build_model(8, 0.5f, "X", true).g) == base) {
+        std::cerr << "Fingerprint ignores shapes, constant values or nodes" << std::endl;
+        exit(1);
+    }
+    Model no_out = build_model(8, 0.5f);
+    no_out.g.outputs.clear();
+    if (cache::graph_fingerprint(no_out.g) == base) {
+        std::cerr << "Fingerprint ignores outputs" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_reuse(EngineConfig cfg, const char* label) {
+    std::cout << "Testing Plan Cache Reuse (" << label << ")..." << std::endl;
+    cache::PlanCache& pc = cache::PlanCache::global();
+    pc.clear();
+    cfg.cache_plans = true;
+    const int64_t rows = 64;
+
+    Model a_model = build_model(rows, 0.5f, "X", cfg.optimize_graph);
+    auto t0 = std::chrono::steady_clock::now();
+    Engine a(a_model.g, cfg);
+    a.compile();
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Separately built (same structure) graph, as a second worker would load it.
+    Model b_model = build_model(rows, 0.5f, "X", cfg.optimize_graph);
+    Engine b(b_model.g, cfg);
+    b.compile();
+    auto t2 = std::chrono::steady_clock::now();
+
+    if (pc.size() != 1 || pc.hits() != 1 || pc.misses() != 1) {
+        std::cerr << "Expected one miss then one hit, got " << pc.misses() << "/" << pc.hits() << std::endl;
+        exit(1);
+    }
+    if (has_event(a, "Cached") || !has_event(b, "Cached | Fingerprint: 0x")) {
+        std::cerr << "Cache hit not reported in the trace" << std::endl;
+        exit(1);
+    }
+    if (a.get_schedule() != b.get_schedule() || a.get_plan().size() != b.get_plan().size()) {
+        std::cerr << "Cached schedule differs" << std::endl;
+        exit(1);
+    }
+    // The cached steps are rebound to b's own slab.
+    for (size_t s = 0; s < b.get_plan().size(); ++s) {
+        const auto& step = b.get_plan()[s];
+        if (step.output && step.output != b.get_buffer(step.node_id)) {
+            std::cerr << "Step " << s << " writes outside its engine's buffers" << std::endl;
+            exit(1);
+        }
+        if (step.trace_tag != a.get_plan()[s].trace_tag) {
+            std::cerr << "Kernel selection differs at step " << s << std::endl;
+            exit(1);
+        }
+    }
+
+    std::vector<float> out_a = run(a, a_model, rows);
+    std::vector<float> out_b = run(b, b_model, rows);
+    if (std::memcmp(out_a.data(), out_b.data(), out_a.size() * sizeof(float)) != 0) {
+        std::cerr << "Cached plan is not bitwise identical" << std::endl;
+        exit(1);
+    }
+    // Engines do not share memory.
+    if (a.get_buffer(a_model.out) == b.get_buffer(b_model.out)) {
+        std::cerr << "Engines share a buffer" << std::endl;
+        exit(1);
+    }
+
+    using us = std::chrono::microseconds;
+    std::cout << "  compile: " << std::chrono::duration_cast<us>(t1 - t0).count() << " us, cached: "
+              << std::chrono::duration_cast<us>(t2 - t1).count() << " us" << std::endl;
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_config_is_part_of_key() {
+    std::cout << "Testing Plan Cache Keys Include Config..." << std::endl;
+    cache::PlanCache& pc = cache::PlanCache::global();
+    pc.clear();
+    Model m = build_model(8, 0.5f);
+    EngineConfig cfg;
+    cfg.cache_plans = true;
+    { Engine e(m.g, cfg); e.compile(); }
+    cfg.plan_memory = false;
+    { Engine e(m.g, cfg); e.compile(); }
+    cfg.num_threads = 2;
+    { Engine e(m.g, cfg); e.compile(); }
+    cfg.cache_plans = false;
+    { Engine e(m.g, cfg); e.compile(); }
+    if (pc.size() != 3 || pc.hits() != 0) {
+        std::cerr << "Different configs shared a plan (" << pc.size() << " entries, "
+                  << pc.hits() << " hits)" << std::endl;
+        exit(1);
+    }
+    pc.clear();
+    std::cout << "PASSED" << std::endl;
+}
+
+// Models of different heights (one plan each, as a server compiling per
+// sequence length would) stay within the capacity; the least recently used
+// plan goes first, and an evicted plan keeps serving its engine.
+void test_capacity() {
+    std::cout << "Testing Plan Cache Capacity (LRU)..." << std::endl;
+    cache::PlanCache& pc = cache::PlanCache::global();
+    pc.clear();
+    pc.set_capacity(2);
+    EngineConfig cfg;
+    cfg.cache_plans = true;
+
+    Model m8 = build_model(8, 0.5f), m8b = build_model(8, 0.5f), m16 = build_model(16, 0.5f),
+          m24 = build_model(24, 0.5f);
+    Engine e8(m8.g, cfg);
+    e8.compile();
+    { Engine e(m16.g, cfg); e.compile(); }
+    { Engine e(m8b.g, cfg); e.compile(); }                  // hit: 8 becomes most recent
+    { Engine e(m24.g, cfg); e.compile(); }                  // evicts 16
+    if (pc.size() != 2 || pc.evictions() != 1 || pc.hits() != 1) {
+        std::cerr << "Expected 2 plans and 1 eviction, got " << pc.size() << " / " << pc.evictions() << std::endl;
+        exit(1);
+    }
+    Engine again8(m8b.g, cfg);
+    again8.compile();
+    Engine again16(m16.g, cfg);
+    again16.compile();
+    if (!has_event(again8, "Cached") || has_event(again16, "Cached") || pc.evictions() != 2) {
+        std::cerr << "Least recently used plan was not the one evicted" << std::endl;
+        exit(1);
+    }
+
+    pc.set_capacity(1); // shrinking evicts at once
+    if (pc.size() != 1) {
+        std::cerr << "set_capacity did not evict" << std::endl;
+        exit(1);
+    }
+    pc.set_capacity(0);
+    { Engine e(m24.g, cfg); e.compile(); }
+    if (pc.size() != 0) {
+        std::cerr << "Capacity 0 still caches" << std::endl;
+        exit(1);
+    }
+    std::vector<float> out = run(e8, m8, 8);
+    std::vector<float> fresh = run(again8, m8b, 8);
+    if (std::memcmp(out.data(), fresh.data(), out.size() * sizeof(float)) != 0) {
+        std::cerr << "Evicted plan changed its engine's results" << std::endl;
+        exit(1);
+    }
+
+    pc.set_capacity(cache::PlanCache::kDefaultCapacity);
+    pc.clear();
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_fingerprint();
+
+    EngineConfig ref;
+    test_reuse(ref, "Reference");
+    EngineConfig optimized;
+    optimized.optimize_graph = true;
+    test_reuse(optimized, "optimize_graph");
+    EngineConfig parallel;
+    parallel.num_threads = 2;
+    test_reuse(parallel, "2 Threads");
+#ifdef VECTORIA_USE_ASM
+    EngineConfig simd;
+    simd.policy = KernelPolicy::SIMD;
+    test_reuse(simd, "SIMD");
+#endif
+
+    test_config_is_part_of_key();
+    test_capacity();
+    return 0;
+}
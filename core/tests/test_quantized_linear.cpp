@@ -0,0 +1,302 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/graph_harness.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+
+using namespace vectoria;
+using kernels::reference::quantize_rows_s8;
+using kernels::reference::quantize_weights_s8;
+
+void fail(const std::string& what) {
+    std::cout << "FAILED (" << what << ")" << std::endl;
+    exit(1);
+}
+
+// Codes round half to even after scaling to [-127, 127]; zero rows and NaNs
+// have fixed results.
+void test_quantization() {
+    std::cout << "Testing INT8 row quantization ... ";
+    const float row[] = {127.0f, 0.5f, 1.5f, -2.5f, -127.0f, 126.5f, 0.49f, -0.0f};
+    int8_t q[8];
+    float scale = 0.0f;
+    quantize_rows_s8(row, 1, 8, 8, q, 8, &scale);
+    const int8_t expected[] = {127, 0, 2, -2, -127, 126, 0, 0};
+    if (scale != 1.0f || std::memcmp(q, expected, sizeof(q)) != 0) fail("rounding");
+
+    const float zeros[3] = {0.0f, -0.0f, 0.0f};
+    const float with_nan[3] = {2.0f, NAN, -1.0f};
+    int8_t qz[3], qn[3];
+    float sz = 1.0f, sn = 0.0f;
+    quantize_rows_s8(zeros, 1, 3, 3, qz, 3, &sz);
+    quantize_rows_s8(with_nan, 1, 3, 3, qn, 3, &sn);
+    if (sz != 0.0f || qz[0] || qz[1] || qz[2]) fail("zero row");
+    if (sn != 2.0f / 127.0f || qn[0] != 127 || qn[1] != -127 || qn[2] != -64) fail("NaN row");
+
+    // Per-channel weights: every value is within half a step of its code.
+    const size_t k = 37, n = 11;
+    std::vector<float> w(k * n), scales(n);
+    std::vector<int8_t> wq(k * n);
+    test::DeterministicRNG(5).fill(w.data(), w.size());
+    quantize_weights_s8(w.data(), k, n, wq.data(), scales.data());
+    for (size_t p = 0; p < k; ++p) {
+        for (size_t j = 0; j < n; ++j) {
+            if (std::fabs(wq[p * n + j] * scales[j] - w[p * n + j]) > 0.5f * scales[j] * 1.0001f) fail("weight codes");
+        }
+    }
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    // The AVX2 row quantizer gives the reference codes and scales, tails and
+    // special values included.
+    for (size_t len : {size_t(1), size_t(7), size_t(8), size_t(29), size_t(300)}) {
+        std::vector<float> x(len);
+        test::DeterministicRNG(static_cast<uint32_t>(len)).fill(x.data(), len, 3.0f);
+        if (len > 8) { x[3] = NAN; x[5] = -0.0f; x[8] = 1e-40f; }
+        std::vector<int8_t> q_ref(len), q_simd(len);
+        float s_ref = 0.0f, s_simd = 0.0f;
+        quantize_rows_s8(x.data(), 1, len, len, q_ref.data(), len, &s_ref);
+        quantize_row_s8_avx2(x.data(), len, q_simd.data(), &s_simd);
+        if (s_ref != s_simd || q_ref != q_simd) fail("quantize_row_s8_avx2, length " + std::to_string(len));
+    }
+#endif
+    std::cout << "PASSED" << std::endl;
+}
+
+// The int32 sums are exact, so SIMD and Reference agree bit for bit, for
+// every epilogue, across K blocks, N blocks and edge tiles.
+void test_kernel() {
+    std::cout << "Testing linear_s8_f32 (int32 sums, dequant epilogue) ... ";
+    test::DeterministicRNG rng(2222);
+    const size_t shapes[][3] = {{1, 1, 1}, {6, 16, 2}, {7, 17, 3}, {13, 33, 70}, {97, 50, 1601}, {7, 1030, 9}, {4, 20, 0}};
+    for (const auto& s : shapes) {
+        const size_t m = s[0], n = s[1], k = s[2];
+        std::vector<float> a(m * k + 1), w(k * n + 1), scales(n), bias(n);
+        std::vector<int8_t> wq(k * n + 1);
+        rng.fill(a.data(), a.size());
+        rng.fill(w.data(), w.size());
+        rng.fill(bias.data(), bias.size());
+        quantize_weights_s8(w.data(), k, n, wq.data(), scales.data());
+
+        // Reference against an independent int64 evaluation of the definition.
+        std::vector<int8_t> aq(m * k + 1);
+        std::vector<float> a_scales(m);
+        quantize_rows_s8(a.data(), m, k, k, aq.data(), k, a_scales.data());
+        for (uint32_t epilogue = 0; epilogue < 3; ++epilogue) {
+            std::vector<float> ref(m * n), expected(m * n);
+            if (kernels::reference::linear_s8_f32(a.data(), wq.data(), scales.data(), bias.data(), ref.data(),
+                                                  m, n, k, k, n, n, epilogue) != VECTORIA_SUCCESS) {
+                fail("reference status");
+            }
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    int64_t sum = 0;
+                    for (size_t p = 0; p < k; ++p) sum += int64_t(aq[i * k + p]) * wq[p * n + j];
+                    float v = static_cast<float>(sum) * a_scales[i];
+                    v = v * scales[j];
+                    if (epilogue) v = v + bias[j];
+                    if (epilogue == 2) v = std::max(0.0f, v);
+                    expected[i * n + j] = v;
+                }
+            }
+            if (std::memcmp(ref.data(), expected.data(), ref.size() * sizeof(float)) != 0) {
+                fail("reference [" + std::to_string(m) + ", " + std::to_string(n) + ", " + std::to_string(k) + "]");
+            }
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+            std::vector<float> simd(m * n);
+            if (linear_s8_f32_avx2(a.data(), wq.data(), scales.data(), bias.data(), simd.data(),
+                                   m, n, k, k, n, n, epilogue) != VECTORIA_SUCCESS ||
+                std::memcmp(simd.data(), ref.data(), ref.size() * sizeof(float)) != 0) {
+                fail("linear_s8_f32_avx2 [" + std::to_string(m) + ", " + std::to_string(n) + ", " +
+                     std::to_string(k) + "] epilogue " + std::to_string(epilogue));
+            }
+#endif
+        }
+    }
+
+    // Quantization error stays small against the FP32 product.
+    const size_t m = 32, n = 64, k = 256;
+    std::vector<float> a(m * k), w(k * n), scales(n), out(m * n), exact(m * n);
+    std::vector<int8_t> wq(k * n);
+    rng.fill(a.data(), a.size());
+    rng.fill(w.data(), w.size());
+    quantize_weights_s8(w.data(), k, n, wq.data(), scales.data());
+    kernels::reference::linear_s8_f32(a.data(), wq.data(), scales.data(), nullptr, out.data(), m, n, k, k, n, n, 0);
+    kernels::reference::gemm_f32(a.data(), w.data(), exact.data(), m, n, k, k, n, n, 1.0f, 0.0f);
+    float max_err = 0.0f, max_abs = 0.0f;
+    for (size_t i = 0; i < out.size(); ++i) {
+        max_err = std::max(max_err, std::fabs(out[i] - exact[i]));
+        max_abs = std::max(max_abs, std::fabs(exact[i]));
+    }
+    if (max_err > 0.02f * max_abs) fail("quantization error " + std::to_string(max_err) + " of " + std::to_string(max_abs));
+
+    std::vector<float> x(4, 1.0f);
+    int8_t b8[4] = {1, 1, 1, 1};
+    if (kernels::reference::linear_s8_f32(x.data(), b8, x.data(), nullptr, x.data(), 2, 2, 2, 2, 2, 2, 1) != VECTORIA_ERROR_INVALID_SHAPE ||
+        kernels::reference::linear_s8_f32(x.data(), b8, x.data(), nullptr, x.data(), 1, 1, VECTORIA_S8_MAX_K + 1, 1, 1, 1, 0) != VECTORIA_ERROR_INVALID_SHAPE) {
+        fail("missing bias / oversized K accepted");
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+struct Projection {
+    ir::Graph g;
+    std::vector<float> x, scales, bias;
+    std::vector<int8_t> w;
+};
+
+Projection build_projection(int64_t t, int64_t d, int64_t n, ir::LinearEpilogue epilogue) {
+    Projection p;
+    p.g.nodes.push_back({ {0}, ir::InputNode{"X", {{t, d}}, ir::DataType::Float32} });
+    p.g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{d, n}}, ir::DataType::Int8, 1} });
+    p.g.nodes.push_back({ {2}, ir::ParameterNode{"Scales", {{n}}, ir::DataType::Float32, 2} });
+    p.g.nodes.push_back({ {3}, ir::ParameterNode{"Bias", {{n}}, ir::DataType::Float32, 3} });
+    std::vector<ir::NodeId> inputs = {{0}, {1}, {2}};
+    if (epilogue != ir::LinearEpilogue::None) inputs.push_back({3});
+    ir::OpNode ql{ir::OpType::QuantizedLinear, inputs, {{t, n}}, ir::DataType::Float32, {static_cast<int64_t>(epilogue)}};
+    p.g.nodes.push_back({ {4}, ql });
+    p.g.outputs = {{4}};
+
+    p.x.resize(t * d);
+    p.bias.resize(n);
+    p.scales.resize(n);
+    p.w.resize(d * n);
+    std::vector<float> w(d * n);
+    test::DeterministicRNG(11).fill(p.x.data(), p.x.size());
+    test::DeterministicRNG(12).fill(w.data(), w.size());
+    test::DeterministicRNG(13).fill(p.bias.data(), p.bias.size());
+    quantize_weights_s8(w.data(), d, n, p.w.data(), p.scales.data());
+    return p;
+}
+
+std::vector<float> run(const Projection& p, KernelPolicy policy, size_t threads, std::string* tag = nullptr) {
+    EngineConfig cfg;
+    cfg.policy = policy;
+    cfg.num_threads = threads;
+    Engine e(p.g, cfg);
+    e.compile();
+    std::memcpy(e.get_buffer(0), p.x.data(), p.x.size() * sizeof(float));
+    std::memcpy(e.get_buffer(1), p.w.data(), p.w.size());
+    std::memcpy(e.get_buffer(2), p.scales.data(), p.scales.size() * sizeof(float));
+    std::memcpy(e.get_buffer(3), p.bias.data(), p.bias.size() * sizeof(float));
+    e.execute();
+    for (const auto& step : e.get_plan()) {
+        if (step.node_id == 4 && tag) *tag = step.trace_tag;
+    }
+    const auto& shape = std::get<ir::OpNode>(p.g.nodes[4].data).output_shape;
+    const float* y = static_cast<const float*>(e.get_buffer(4));
+    return std::vector<float>(y, y + shape.dims[0] * shape.dims[1]);
+}
+
+// The Engine runs QuantizedLinear with the reference kernel's bits on every
+// policy and thread count (tiles quantize their own rows identically).
+void test_engine() {
+    std::cout << "Testing QuantizedLinear node (policies, tiling) ... ";
+    for (auto epilogue : {ir::LinearEpilogue::None, ir::LinearEpilogue::Bias, ir::LinearEpilogue::BiasRelu}) {
+        Projection p = build_projection(70, 97, 200, epilogue);
+        std::string tag;
+        const std::vector<float> ref = run(p, KernelPolicy::Reference, 1, &tag);
+        if (tag.find("Reference") != 0 || tag.find("Weights: S8") == std::string::npos) fail("tag '" + tag + "'");
+        if (run(p, KernelPolicy::Reference, 4) != ref) fail("reference tiled");
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+        for (size_t threads : {1, 4}) {
+            const std::vector<float> simd = run(p, KernelPolicy::SIMD, threads, &tag);
+            if (std::memcmp(simd.data(), ref.data(), ref.size() * sizeof(float)) != 0) {
+                fail("SIMD differs on " + std::to_string(threads) + " threads");
+            }
+            if (tag.find("SIMD [x86_64]") != 0) fail("tag '" + tag + "'");
+        }
+#endif
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+// The encoder's quantized FFN stays close to its FP32 twin.
+void test_encoder() {
+    std::cout << "Testing Transformer Encoder with an INT8 FFN ... ";
+    test::EncoderOptions opt;
+    opt.fuse_ffn = opt.fuse_layernorm = true;
+    test::EncoderGraph f32 = test::build_encoder(opt);
+    opt.int8_ffn = true;
+    test::EncoderGraph s8 = test::build_encoder(opt);
+    const ir::Graph& g32 = f32.g;
+    const ir::Graph& g8 = s8.g;
+    size_t quantized_nodes = 0;
+    for (const auto& node : g8.nodes) {
+        auto* op = std::get_if<ir::OpNode>(&node.data);
+        if (op && op->op == ir::OpType::QuantizedLinear) ++quantized_nodes;
+    }
+    if (quantized_nodes != 2) fail("expected 2 QuantizedLinear nodes");
+
+    Engine e32(g32), e8(g8);
+    e32.compile();
+    e8.compile();
+    test::fill_leaves(g32, e32, {100, 0.3f});
+    for (size_t id : f32.leaves) {
+        const size_t count = test::element_count(g32, id);
+        const float* v = static_cast<const float*>(e32.get_buffer(id));
+        if (id == f32.w1 || id == f32.w2) {
+            // WF1 / WF2: Int8 codes plus their scales.
+            const auto& dims = std::get<ir::ParameterNode>(g32.nodes[id].data).shape.dims;
+            std::vector<int8_t> q(count);
+            std::vector<float> scales(dims[1]);
+            quantize_weights_s8(v, dims[0], dims[1], q.data(), scales.data());
+            std::memcpy(e8.get_buffer(id), q.data(), count);
+            std::memcpy(e8.get_buffer(id == s8.w1 ? s8.w1_scales : s8.w2_scales), scales.data(), scales.size() * sizeof(float));
+        } else {
+            std::memcpy(e8.get_buffer(id), v, count * sizeof(float));
+        }
+    }
+    e32.execute();
+    e8.execute();
+    const float* y32 = static_cast<const float*>(e32.get_buffer(g32.outputs[0].index));
+    const float* y8 = static_cast<const float*>(e8.get_buffer(g8.outputs[0].index));
+    float max_err = 0.0f;
+    for (size_t i = 0; i < test::element_count(g32, f32.out); ++i) max_err = std::max(max_err, std::fabs(y32[i] - y8[i]));
+    if (!(max_err < 0.05f)) fail("max error " + std::to_string(max_err));
+    std::cout << "PASSED (max error " << max_err << ")" << std::endl;
+}
+
+void test_errors() {
+    std::cout << "Testing QuantizedLinear errors ... ";
+    // 0: Float32 weights, 1: Int8 into a MatMul, 2: scales of the wrong size,
+    // 3: epilogue without bias, 4: unknown epilogue.
+    for (int variant = 0; variant < 5; ++variant) {
+        ir::Graph g;
+        g.nodes.push_back({ {0}, ir::InputNode{"X", {{4, 6}}, ir::DataType::Float32} });
+        g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{6, 5}}, variant == 0 ? ir::DataType::Float32 : ir::DataType::Int8, 1} });
+        g.nodes.push_back({ {2}, ir::ParameterNode{"Scales", {{variant == 2 ? 4 : 5}}, ir::DataType::Float32, 2} });
+        ir::OpNode op{ir::OpType::QuantizedLinear, {{0}, {1}, {2}}, {{4, 5}}, ir::DataType::Float32, {variant == 3 ? 1 : 0}};
+        if (variant == 1) op = ir::OpNode{ir::OpType::MatMul, {{0}, {1}}, {{4, 5}}, ir::DataType::Float32, {}};
+        if (variant == 4) op.int_params = {3};
+        g.nodes.push_back({ {3}, op });
+        g.outputs = {{3}};
+        bool threw = false;
+        try {
+            Engine e(g);
+            e.compile();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) fail("variant " + std::to_string(variant) + " compiled");
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating INT8 Quantized Linear..." << std::endl;
+    test_quantization();
+    test_kernel();
+    test_engine();
+    test_encoder();
+    test_errors();
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
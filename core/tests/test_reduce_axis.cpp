@@ -0,0 +1,325 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/lowering/coreml.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace vectoria;
+namespace fs = std::filesystem;
+
+void fail(const std::string& what) {
+    std::cout << "FAILED (" << what << ")" << std::endl;
+    exit(1);
+}
+
+bool bitwise(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+// Mean and population variance of In[o, :, j] in double, two passes.
+void moments_f64(const std::vector<float>& x, size_t outer, size_t reduced, size_t inner,
+                 std::vector<double>& mean, std::vector<double>& var) {
+    mean.assign(outer * inner, 0.0);
+    var.assign(outer * inner, 0.0);
+    for (size_t o = 0; o < outer; ++o) {
+        for (size_t j = 0; j < inner; ++j) {
+            double s = 0.0;
+            for (size_t i = 0; i < reduced; ++i) s += x[(o * reduced + i) * inner + j];
+            const double m = s / reduced;
+            double v = 0.0;
+            for (size_t i = 0; i < reduced; ++i) {
+                const double d = x[(o * reduced + i) * inner + j] - m;
+                v += d * d;
+            }
+            mean[o * inner + j] = m;
+            var[o * inner + j] = v / reduced;
+        }
+    }
+}
+
+// Middle-axis Reference kernels against the transpose-then-last-axis route
+// they replace: the same additions in the same order, so the same bits.
+void test_reference_kernels() {
+    std::cout << "Testing Reference axis reductions ... ";
+    const size_t shapes[][3] = {{1, 5, 3}, {3, 7, 11}, {2, 1, 9}, {4, 16, 33}, {1, 0, 4}};
+    for (const auto& s : shapes) {
+        const size_t outer = s[0], reduced = s[1], inner = s[2];
+        std::vector<float> x(outer * reduced * inner + 1); // never empty (nullptr)
+        test::DeterministicRNG(7).fill(x.data(), x.size(), 3.0f);
+        // [outer, reduced, inner] -> [outer, inner, reduced]
+        std::vector<float> xt(x.size());
+        for (size_t o = 0; o < outer; ++o)
+            for (size_t i = 0; i < reduced; ++i)
+                for (size_t j = 0; j < inner; ++j)
+                    xt[(o * inner + j) * reduced + i] = x[(o * reduced + i) * inner + j];
+
+        std::vector<float> sum(outer * inner), max(outer * inner), sum_t(outer * inner), max_t(outer * inner);
+        kernels::reference::reduce_sum_axis_f32(x.data(), sum.data(), outer, reduced, inner);
+        kernels::reference::reduce_max_axis_f32(x.data(), max.data(), outer, reduced, inner);
+        kernels::reference::reduce_sum_f32(xt.data(), sum_t.data(), outer * inner, reduced);
+        kernels::reference::reduce_max_f32(xt.data(), max_t.data(), outer * inner, reduced);
+        if (!bitwise(sum, sum_t)) fail("ReduceSum axis vs transpose");
+        if (!bitwise(max, max_t)) fail("ReduceMax axis vs transpose");
+        if (reduced == 0) {
+            std::vector<float> mean(outer * inner), var(outer * inner);
+            if (kernels::reference::reduce_mean_var_f32(x.data(), mean.data(), var.data(), outer, reduced, inner) == VECTORIA_SUCCESS) {
+                fail("ReduceMeanVar over an empty axis");
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+// One-read moments stay accurate for a large common offset (shifted sums).
+void test_reference_mean_var() {
+    std::cout << "Testing Reference ReduceMeanVar ... ";
+    const size_t outer = 3, reduced = 257, inner = 19;
+    for (float offset : {0.0f, 1000.0f}) {
+        std::vector<float> x(outer * reduced * inner);
+        test::DeterministicRNG(11).fill(x.data(), x.size(), 2.0f);
+        for (auto& v : x) v += offset;
+        for (size_t in : {inner, size_t{1}}) {
+            const size_t red = x.size() / (outer * in);
+            std::vector<float> mean(outer * in), var(outer * in);
+            if (kernels::reference::reduce_mean_var_f32(x.data(), mean.data(), var.data(), outer, red, in) != VECTORIA_SUCCESS) {
+                fail("ReduceMeanVar status");
+            }
+            std::vector<double> m64, v64;
+            moments_f64(x, outer, red, in, m64, v64);
+            for (size_t i = 0; i < mean.size(); ++i) {
+                if (std::fabs(mean[i] - m64[i]) > 1e-5 * (1.0 + std::fabs(m64[i]))) fail("mean at " + std::to_string(i));
+                if (std::fabs(var[i] - v64[i]) > 1e-4 * (1.0 + v64[i])) fail("var at " + std::to_string(i));
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+// Columns in the lanes: every width class (32-column sweeps, 8-column
+// sweeps, masked tail) and blocks taller than one band give the Reference
+// bits, including NaN and -0.
+void test_simd_rows() {
+    std::cout << "Testing AVX2 strided reductions ... ";
+    const size_t shapes[][3] = {{1, 1, 2}, {2, 3, 7}, {1, 9, 8}, {3, 5, 31}, {2, 17, 32}, {1, 33, 77},
+                                {2, 64, 100}, {2, 150, 41}, {1, 0, 13}, {5, 2, 1}, {3, 100, 1}};
+    for (const auto& s : shapes) {
+        const size_t outer = s[0], reduced = s[1], inner = s[2];
+        const std::string shape = "[" + std::to_string(outer) + ", " + std::to_string(reduced) + ", " + std::to_string(inner) + "]";
+        std::vector<float> x(outer * reduced * inner + 1); // never empty (nullptr)
+        test::DeterministicRNG(23).fill(x.data(), x.size(), 5.0f);
+        if (x.size() > 4) {
+            x[1] = std::numeric_limits<float>::quiet_NaN();
+            x[2] = -0.0f;
+        }
+        std::vector<float> ref(outer * inner), simd(outer * inner, 1.0f);
+        kernels::reference::reduce_max_axis_f32(x.data(), ref.data(), outer, reduced, inner);
+        if (reduce_max_axis_f32_avx2(x.data(), simd.data(), outer, reduced, inner) != VECTORIA_SUCCESS) fail("max status");
+        if (inner > 1 && !bitwise(ref, simd)) fail("ReduceMax " + shape);
+
+        if (x.size() > 4) x[1] = 0.5f;
+        kernels::reference::reduce_sum_axis_f32(x.data(), ref.data(), outer, reduced, inner);
+        if (reduce_sum_axis_f32_avx2(x.data(), simd.data(), outer, reduced, inner) != VECTORIA_SUCCESS) fail("sum status");
+        if (inner > 1 && !bitwise(ref, simd)) fail("ReduceSum " + shape);
+        if (inner == 1) {
+            // Last axis: 8-lane row sums
+            double abs_sum = 0.0;
+            for (float v : x) abs_sum += std::fabs(v);
+            for (size_t i = 0; i < ref.size(); ++i) {
+                if (std::fabs(ref[i] - simd[i]) > 1e-6 * abs_sum) fail("ReduceSum rows " + shape);
+            }
+        }
+
+        if (reduced == 0) continue;
+        std::vector<float> mean_ref(outer * inner), var_ref(outer * inner), mean(outer * inner), var(outer * inner);
+        kernels::reference::reduce_mean_var_f32(x.data(), mean_ref.data(), var_ref.data(), outer, reduced, inner);
+        if (reduce_mean_var_f32_avx2(x.data(), mean.data(), var.data(), outer, reduced, inner) != VECTORIA_SUCCESS) fail("mean/var status");
+        for (size_t i = 0; i < mean.size(); ++i) {
+            if (std::fabs(mean[i] - mean_ref[i]) > 1e-5f * (1.0f + std::fabs(mean_ref[i]))) fail("mean " + shape);
+            if (std::fabs(var[i] - var_ref[i]) > 1e-5f * (1.0f + var_ref[i])) fail("var " + shape);
+        }
+    }
+    std::vector<float> x(8), mean(4), var(4);
+    if (reduce_mean_var_f32_avx2(x.data(), mean.data(), var.data(), 1, 0, 4) == VECTORIA_SUCCESS) fail("empty axis");
+    std::cout << "PASSED" << std::endl;
+}
+#endif
+
+struct Outputs {
+    std::vector<std::vector<float>> values;
+    std::vector<std::string> tags;
+};
+
+// X [2, 3, 5, 7] reduced over each axis, plus mean / variance over axis 2
+// taken apart with outer-axis Slices.
+ir::Graph build_graph(std::vector<int>& outputs) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{2, 3, 5, 7}}, ir::DataType::Float32} });
+    outputs.push_back(graph::add_reduce(g, ir::OpType::ReduceSum, 0, 0));
+    outputs.push_back(graph::add_reduce(g, ir::OpType::ReduceSum, 0, 1));
+    outputs.push_back(graph::add_reduce(g, ir::OpType::ReduceMax, 0, 2));
+    outputs.push_back(graph::add_reduce(g, ir::OpType::ReduceSum, 0, -1));
+    outputs.push_back(graph::add_reduce(g, ir::OpType::ReduceMax, 0, -1));
+    const int mv = graph::add_reduce(g, ir::OpType::ReduceMeanVar, 0, 2);
+    outputs.push_back(graph::add_slice(g, mv, 0, 0, 1));
+    outputs.push_back(graph::add_slice(g, mv, 0, 1, 2));
+    for (int id : outputs) g.outputs.push_back({static_cast<size_t>(id)});
+    return g;
+}
+
+Outputs run(const ir::Graph& g, const std::vector<int>& outputs, KernelPolicy policy, const std::vector<float>& x) {
+    EngineConfig cfg;
+    cfg.policy = policy;
+    Engine e(g, cfg);
+    e.compile();
+    std::memcpy(e.get_buffer(0), x.data(), x.size() * sizeof(float));
+    e.execute();
+    Outputs r;
+    for (int id : outputs) {
+        const auto& shape = std::get<ir::OpNode>(g.nodes[id].data).output_shape;
+        size_t count = 1;
+        for (auto d : shape.dims) count *= d;
+        const float* y = static_cast<const float*>(e.get_buffer(id));
+        r.values.emplace_back(y, y + count);
+        std::string tag;
+        for (const auto& step : e.get_plan()) {
+            if (step.node_id == static_cast<size_t>(id)) tag = step.trace_tag;
+        }
+        r.tags.push_back(tag);
+    }
+    return r;
+}
+
+void test_engine() {
+    std::cout << "Testing Engine axis reductions ... ";
+    std::vector<int> outputs;
+    const ir::Graph g = build_graph(outputs);
+    const size_t dims[4] = {2, 3, 5, 7};
+    std::vector<float> x(2 * 3 * 5 * 7);
+    test::DeterministicRNG(5).fill(x.data(), x.size(), 4.0f);
+
+    auto at = [&](size_t a, size_t b, size_t c, size_t d) { return x[((a * 3 + b) * 5 + c) * 7 + d]; };
+    const Outputs ref = run(g, outputs, KernelPolicy::Reference, x);
+
+    // Shapes and values against direct loops (same row order as the kernels)
+    std::vector<float> sum0(3 * 5 * 7, 0.0f), sum1(2 * 5 * 7, 0.0f);
+    std::vector<float> max2(2 * 3 * 7, -std::numeric_limits<float>::infinity());
+    for (size_t a = 0; a < dims[0]; ++a)
+        for (size_t b = 0; b < dims[1]; ++b)
+            for (size_t c = 0; c < dims[2]; ++c)
+                for (size_t d = 0; d < dims[3]; ++d) {
+                    sum0[(b * 5 + c) * 7 + d] += at(a, b, c, d);
+                    sum1[(a * 5 + c) * 7 + d] += at(a, b, c, d);
+                    float& m = max2[(a * 3 + b) * 7 + d];
+                    if (at(a, b, c, d) > m) m = at(a, b, c, d);
+                }
+    if (!bitwise(ref.values[0], sum0)) fail("ReduceSum axis 0");
+    if (!bitwise(ref.values[1], sum1)) fail("ReduceSum axis 1");
+    if (!bitwise(ref.values[2], max2)) fail("ReduceMax axis 2");
+    if (ref.values[3].size() != 2 * 3 * 5 || ref.values[4].size() != 2 * 3 * 5) fail("last-axis output size");
+
+    std::vector<double> m64, v64;
+    moments_f64(x, 6, 5, 7, m64, v64);
+    if (ref.values[5].size() != 42 || ref.values[6].size() != 42) fail("ReduceMeanVar slices");
+    for (size_t i = 0; i < 42; ++i) {
+        if (std::fabs(ref.values[5][i] - m64[i]) > 1e-5 * (1.0 + std::fabs(m64[i]))) fail("mean");
+        if (std::fabs(ref.values[6][i] - v64[i]) > 1e-5 * (1.0 + v64[i])) fail("variance");
+    }
+
+    // SIMD: strided reductions are bitwise, last-axis Sum and the moments close
+    const Outputs simd = run(g, outputs, KernelPolicy::SIMD, x);
+    for (size_t i : {0, 1, 2, 4}) {
+        if (!bitwise(ref.values[i], simd.values[i])) fail("SIMD output " + std::to_string(i));
+    }
+    for (size_t i : {3, 5, 6}) {
+        for (size_t j = 0; j < ref.values[i].size(); ++j) {
+            if (std::fabs(ref.values[i][j] - simd.values[i][j]) > 1e-5f * (1.0f + std::fabs(ref.values[i][j]))) {
+                fail("SIMD output " + std::to_string(i));
+            }
+        }
+    }
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    for (size_t i : {0, 1, 2}) {
+        if (simd.tags[i].rfind("SIMD", 0) != 0) fail("strided tag: " + simd.tags[i]);
+    }
+#endif
+    std::cout << "PASSED" << std::endl;
+}
+
+template <typename F>
+void expect_throw(F&& f, const std::string& what) {
+    try {
+        f();
+    } catch (const std::runtime_error&) {
+        return;
+    }
+    fail("expected error: " + what);
+}
+
+void test_errors() {
+    std::cout << "Testing axis validation ... ";
+    auto compile_with = [](ir::OpType type, int64_t axis, std::vector<int64_t> out_dims, std::vector<int64_t> in_dims) {
+        ir::Graph g;
+        g.nodes.push_back({ {0}, ir::InputNode{"X", {in_dims}, ir::DataType::Float32} });
+        g.nodes.push_back({ {1}, ir::OpNode{type, {{0}}, {out_dims}, ir::DataType::Float32, {axis}} });
+        g.outputs = {{1}};
+        Engine e(g);
+        e.compile();
+    };
+    expect_throw([&] { compile_with(ir::OpType::ReduceSum, 2, {4}, {4, 6}); }, "axis past the rank");
+    expect_throw([&] { compile_with(ir::OpType::ReduceMax, -3, {4}, {4, 6}); }, "negative axis past the rank");
+    expect_throw([&] { compile_with(ir::OpType::ReduceSum, 0, {4}, {4, 6}); }, "output shape");
+    expect_throw([&] { compile_with(ir::OpType::ReduceMeanVar, 0, {6}, {4, 6}); }, "ReduceMeanVar output");
+    expect_throw([&] { compile_with(ir::OpType::ReduceMeanVar, 0, {2, 6}, {0, 6}); }, "ReduceMeanVar empty axis");
+    expect_throw([&] { ir::Graph g; g.nodes.push_back({ {0}, ir::InputNode{"X", {{4}}, ir::DataType::Float32} });
+                       graph::add_reduce(g, ir::OpType::Relu, 0, 0); }, "add_reduce op");
+    compile_with(ir::OpType::ReduceSum, 0, {6}, {4, 6});
+    compile_with(ir::OpType::ReduceMeanVar, -2, {2, 6}, {4, 6});
+    std::cout << "PASSED" << std::endl;
+}
+
+// CoreML keeps the axis instead of assuming the last one.
+void test_coreml_axes() {
+    std::cout << "Testing CoreML reduction axes ... ";
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{4, 6, 3}}, ir::DataType::Float32} });
+    const int s = graph::add_reduce(g, ir::OpType::ReduceSum, 0, 1);
+    const int mv = graph::add_reduce(g, ir::OpType::ReduceMeanVar, 0, 0);
+    g.outputs = {{static_cast<size_t>(s)}, {static_cast<size_t>(mv)}};
+
+    const std::string out_path = "test_reduce_axis.mlpackage";
+    if (fs::exists(out_path)) fs::remove_all(out_path);
+    lowering::export_to_coreml(g, out_path);
+    std::ifstream mil_file(out_path + "/Data/com.apple.CoreML/model.mil");
+    std::string content((std::istreambuf_iterator<char>(mil_file)), std::istreambuf_iterator<char>());
+    fs::remove_all(out_path);
+    if (content.find("reduce_sum(x=X, axes=[1], keep_dims=false)") == std::string::npos) fail("reduce_sum axes");
+    if (content.find("reduce_mean(x=X, axes=[0], keep_dims=false)") == std::string::npos) fail("reduce_mean axes");
+    if (content.find("stack(values=") == std::string::npos) fail("mean / variance stack");
+    if (content.find("axes=[-1]") != std::string::npos) fail("hardcoded last axis");
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_reference_kernels();
+    test_reference_mean_var();
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_simd_rows();
+#endif
+    test_engine();
+    test_errors();
+    test_coreml_axes();
+    return 0;
+}
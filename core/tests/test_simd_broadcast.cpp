@@ -0,0 +1,134 @@
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/engine.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+using namespace vectoria;
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+using RefFn = VectoriaStatus (*)(const float*, const float*, float*, size_t, size_t);
+
+// Row kernels without a reference counterpart are checked against a plain loop.
+template <typename Op>
+VectoriaStatus row_loop(const float* a, const float* b, float* out, size_t outer, size_t inner, Op op) {
+    for (size_t i = 0; i < outer; ++i) {
+        for (size_t j = 0; j < inner; ++j) out[i * inner + j] = op(a[i * inner + j], b[j]);
+    }
+    return VECTORIA_SUCCESS;
+}
+
+VectoriaStatus add_row_loop(const float* a, const float* b, float* o, size_t m, size_t n) { return row_loop(a, b, o, m, n, [](float x, float y) { return x + y; }); }
+VectoriaStatus sub_row_loop(const float* a, const float* b, float* o, size_t m, size_t n) { return row_loop(a, b, o, m, n, [](float x, float y) { return x - y; }); }
+VectoriaStatus div_row_loop(const float* a, const float* b, float* o, size_t m, size_t n) { return row_loop(a, b, o, m, n, [](float x, float y) { return x / y; }); }
+
+// Column Mul has no reference kernel either; the scalar case runs through it.
+VectoriaStatus mul_col_loop(const float* a, const float* b, float* o, size_t m, size_t n) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) o[i * n + j] = a[i * n + j] * b[i];
+    }
+    return VECTORIA_SUCCESS;
+}
+
+// Shapes cover empty, scalar (outer == 1 / inner == 1), every tail length and a multi-block row.
+void test_bitwise(binary_broadcast_f32_t simd, RefFn ref, bool row, const char* name) {
+    std::cout << "Testing " << name << " [AVX2] bitwise vs Reference ... ";
+    const size_t outers[] = {0, 1, 2, 3, 7, 33};
+    const size_t inners[] = {0, 1, 3, 7, 8, 9, 15, 16, 17, 64, 1001};
+    test::DeterministicRNG rng(4242);
+    for (size_t outer : outers) {
+        for (size_t inner : inners) {
+            std::vector<float> a(outer * inner + 1), b((row ? inner : outer) + 1);
+            rng.fill(a.data(), a.size(), 100.0f);
+            rng.fill(b.data(), b.size(), 10.0f);
+            std::vector<float> expected(outer * inner + 1, 0.0f), out(outer * inner + 1, 0.0f);
+            ref(a.data(), b.data(), expected.data(), outer, inner);
+            if (simd(a.data(), b.data(), out.data(), outer, inner) != VECTORIA_SUCCESS ||
+                std::memcmp(expected.data(), out.data(), expected.size() * sizeof(float)) != 0) {
+                std::cout << "FAILED (outer=" << outer << ", inner=" << inner << ")" << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_engine_dispatch() {
+    std::cout << "Testing SIMD dispatch of broadcast ops ... ";
+    // X [5, 11]; C [5] column, R [11] row, S [1] scalar
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{5, 11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::InputNode{"C", {{5}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {2}, ir::InputNode{"R", {{11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {3}, ir::InputNode{"S", {{1}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {4}, ir::OpNode{ir::OpType::Add, {{0}, {1}}, {{5, 11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {5}, ir::OpNode{ir::OpType::Sub, {{4}, {1}}, {{5, 11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {6}, ir::OpNode{ir::OpType::Div, {{5}, {3}}, {{5, 11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {7}, ir::OpNode{ir::OpType::Mul, {{6}, {2}}, {{5, 11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {8}, ir::OpNode{ir::OpType::Mul, {{7}, {3}}, {{5, 11}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {9}, ir::OpNode{ir::OpType::BiasAdd, {{8}, {2}}, {{5, 11}}, ir::DataType::Float32} });
+    g.outputs = {{9}};
+
+    auto run = [&](KernelPolicy policy, std::vector<float>& result) {
+        EngineConfig cfg;
+        cfg.policy = policy;
+        Engine e(g, cfg);
+        e.compile();
+        for (size_t i = 4; i <= 9; ++i) {
+            const std::string& tag = e.get_plan()[i].trace_tag;
+            bool is_simd = tag.rfind("SIMD", 0) == 0;
+            if (is_simd != (policy == KernelPolicy::SIMD)) {
+                std::cout << "FAILED (node " << i << ": " << tag << ")" << std::endl;
+                exit(1);
+            }
+        }
+        test::DeterministicRNG rng(7);
+        rng.fill(static_cast<float*>(e.get_buffer(0)), 55, 10.0f);
+        rng.fill(static_cast<float*>(e.get_buffer(1)), 5, 10.0f);
+        rng.fill(static_cast<float*>(e.get_buffer(2)), 11, 10.0f);
+        static_cast<float*>(e.get_buffer(3))[0] = 3.0f;
+        e.execute();
+        const float* out = static_cast<const float*>(e.get_buffer(9));
+        result.assign(out, out + 55);
+    };
+
+    std::vector<float> ref, simd;
+    run(KernelPolicy::Reference, ref);
+    run(KernelPolicy::SIMD, simd);
+    if (std::memcmp(ref.data(), simd.data(), ref.size() * sizeof(float)) != 0) {
+        std::cout << "FAILED (SIMD plan differs from Reference plan)" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating SIMD Broadcast Kernels..." << std::endl;
+    test_bitwise(add_col_f32_avx2, kernels::reference::add_broadcast_f32, false, "Add col");
+    test_bitwise(sub_col_f32_avx2, kernels::reference::sub_broadcast_f32, false, "Sub col");
+    test_bitwise(mul_col_f32_avx2, mul_col_loop, false, "Mul col");
+    test_bitwise(div_col_f32_avx2, kernels::reference::div_broadcast_f32, false, "Div col");
+    test_bitwise(add_row_f32_avx2, add_row_loop, true, "Add row");
+    test_bitwise(add_row_f32_avx2, kernels::reference::bias_add_f32, true, "BiasAdd row");
+    test_bitwise(sub_row_f32_avx2, sub_row_loop, true, "Sub row");
+    test_bitwise(mul_row_f32_avx2, kernels::reference::mul_broadcast_f32, true, "Mul row");
+    test_bitwise(div_row_f32_avx2, div_row_loop, true, "Div row");
+    test_engine_dispatch();
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "SIMD broadcasts: x86_64 ASM build only, skipped" << std::endl;
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,245 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/exec_plan.hpp"
+#include "vectoria/capabilities.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <stdexcept>
+
+using namespace vectoria;
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+extern "C" {
+    VectoriaStatus add_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus sub_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus mul_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus div_f32_avx2(const float* a, const float* b, float* out, size_t count);
+    VectoriaStatus relu_f32_avx2(const float* in, float* out, size_t count);
+    VectoriaStatus reduce_sum_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+    VectoriaStatus reduce_max_f32_avx2(const float* in, float* out, size_t outer, size_t inner);
+}
+const bool kAvx512 = capabilities::host_has_avx512f();
+#else
+const bool kAvx512 = false;
+#endif
+
+void fail(const std::string& what) {
+    std::cout << "FAILED (" << what << ")" << std::endl;
+    exit(1);
+}
+
+// Auto follows the host, Reference ignores the tier, and an AVX512 request
+// the host cannot honour fails instead of falling back.
+void test_resolution() {
+    std::cout << "Testing SIMD tier resolution (host AVX-512F: " << (kAvx512 ? "yes" : "no") << ") ... ";
+    if (exec::resolve_simd_tier(KernelPolicy::Reference, SimdTier::AVX512) != SimdTier::AVX2) fail("Reference policy");
+    if (exec::resolve_simd_tier(KernelPolicy::SIMD, SimdTier::AVX2) != SimdTier::AVX2) fail("pinned AVX2");
+    const SimdTier automatic = exec::resolve_simd_tier(KernelPolicy::SIMD, SimdTier::Auto);
+    if (automatic != (kAvx512 ? SimdTier::AVX512 : SimdTier::AVX2)) fail("Auto");
+    bool threw = false;
+    try {
+        exec::resolve_simd_tier(KernelPolicy::SIMD, SimdTier::AVX512);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (threw == kAvx512) fail("explicit AVX512");
+    std::cout << "PASSED" << std::endl;
+}
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+// Same K blocking and per-element operation sequence: the AVX-512 GEMMs
+// give the AVX2 bits, for every shape, beta, transpose and epilogue.
+void test_gemm_kernels() {
+    std::cout << "Testing AVX-512F GEMM / FusedLinear against AVX2 ... ";
+    test::DeterministicRNG rng(2323);
+    const size_t shapes[][3] = {{1, 1, 1}, {12, 32, 5}, {13, 33, 385}, {97, 50, 1601}, {7, 1030, 9}, {200, 300, 800}, {4, 3, 0}};
+    for (const auto& s : shapes) {
+        const size_t m = s[0], n = s[1], k = s[2];
+        const std::string shape = "[" + std::to_string(m) + ", " + std::to_string(n) + ", " + std::to_string(k) + "]";
+        std::vector<float> a(m * k + 1), b(k * n + 1), bias(n), c0(m * n);
+        rng.fill(a.data(), a.size());
+        rng.fill(b.data(), b.size());
+        rng.fill(bias.data(), bias.size());
+        rng.fill(c0.data(), c0.size());
+        auto same = [&](const std::vector<float>& x, const std::vector<float>& y) {
+            return std::memcmp(x.data(), y.data(), x.size() * sizeof(float)) == 0;
+        };
+        for (float beta : {0.0f, 0.5f}) {
+            std::vector<float> x = c0, y = c0;
+            gemm_f32_avx2_packed(a.data(), b.data(), x.data(), m, n, k, k, n, n, 1.5f, beta);
+            gemm_f32_avx512_packed(a.data(), b.data(), y.data(), m, n, k, k, n, n, 1.5f, beta);
+            if (!same(x, y)) fail("gemm_f32_avx512_packed " + shape);
+        }
+        for (uint32_t trans = 1; trans < 4; ++trans) {
+            const size_t lda = (trans & VECTORIA_GEMM_TRANS_A) ? m : k;
+            const size_t ldb = (trans & VECTORIA_GEMM_TRANS_B) ? k : n;
+            std::vector<float> x = c0, y = c0;
+            gemm_trans_f32_avx2_packed(a.data(), b.data(), x.data(), m, n, k, lda, ldb, n, 1.0f, 0.0f, trans);
+            gemm_trans_f32_avx512_packed(a.data(), b.data(), y.data(), m, n, k, lda, ldb, n, 1.0f, 0.0f, trans);
+            if (!same(x, y)) fail("gemm_trans_f32_avx512_packed " + shape);
+        }
+        for (uint32_t epilogue = 0; epilogue < 3; ++epilogue) {
+            std::vector<float> x(m * n), y(m * n);
+            linear_f32_avx2(a.data(), b.data(), bias.data(), x.data(), m, n, k, k, n, n, epilogue);
+            linear_f32_avx512(a.data(), b.data(), bias.data(), y.data(), m, n, k, k, n, n, epilogue);
+            if (!same(x, y)) fail("linear_f32_avx512 " + shape);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+// Element-wise ops and Max are bitwise equal to AVX2 (masked tails
+// included); Sum changes order and stays within rounding of it.
+void test_vector_kernels() {
+    std::cout << "Testing AVX-512F element-wise and reductions ... ";
+    test::DeterministicRNG rng(2424);
+    for (size_t count : {0, 1, 15, 16, 17, 100, 1000}) {
+        // One slot past the end checks that masked tails store nothing there.
+        std::vector<float> a(count + 1), b(count + 1);
+        rng.fill(a.data(), a.size());
+        rng.fill(b.data(), b.size());
+        if (count > 3) { a[1] = NAN; a[2] = -0.0f; b[3] = 0.0f; }
+        const struct { const char* name; VectoriaStatus (*avx2)(const float*, const float*, float*, size_t);
+                       VectoriaStatus (*avx512)(const float*, const float*, float*, size_t); } binary[] = {
+            {"add", add_f32_avx2, add_f32_avx512}, {"sub", sub_f32_avx2, sub_f32_avx512},
+            {"mul", mul_f32_avx2, mul_f32_avx512}, {"div", div_f32_avx2, div_f32_avx512},
+        };
+        for (const auto& op : binary) {
+            std::vector<float> x(count + 1, 7.0f), y(count + 1, 7.0f);
+            op.avx2(a.data(), b.data(), x.data(), count);
+            op.avx512(a.data(), b.data(), y.data(), count);
+            if (std::memcmp(x.data(), y.data(), x.size() * sizeof(float)) != 0) fail(std::string(op.name) + " count " + std::to_string(count));
+        }
+        std::vector<float> x(count + 1, 7.0f), y(count + 1, 7.0f);
+        relu_f32_avx2(a.data(), x.data(), count);
+        relu_f32_avx512(a.data(), y.data(), count);
+        if (std::memcmp(x.data(), y.data(), x.size() * sizeof(float)) != 0) fail("relu count " + std::to_string(count));
+    }
+    for (size_t inner : {1, 7, 16, 17, 33, 100, 1000}) {
+        const size_t outer = 5;
+        std::vector<float> in(outer * inner), x(outer + 1, 7.0f), y(outer + 1, 7.0f);
+        rng.fill(in.data(), in.size());
+        reduce_max_f32_avx2(in.data(), x.data(), outer, inner);
+        reduce_max_f32_avx512(in.data(), y.data(), outer, inner);
+        if (x != y) fail("reduce_max inner " + std::to_string(inner));
+        reduce_sum_f32_avx2(in.data(), x.data(), outer, inner);
+        reduce_sum_f32_avx512(in.data(), y.data(), outer, inner);
+        for (size_t i = 0; i < outer; ++i) {
+            double magnitude = 0.0;
+            for (size_t j = 0; j < inner; ++j) magnitude += std::fabs(in[i * inner + j]);
+            if (std::fabs(x[i] - y[i]) > 1e-6 * magnitude) fail("reduce_sum inner " + std::to_string(inner));
+        }
+        if (y[outer] != 7.0f) fail("reduce_sum wrote past the end");
+    }
+    std::cout << "PASSED" << std::endl;
+}
+#endif
+
+// X -> MatMul(W) -> Relu -> Add(X W) -> FusedLinear(W2, bias) -> ReduceMax.
+ir::Graph build_graph(int64_t t, int64_t d) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{t, d}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{d, d}}, ir::DataType::Float32, 1} });
+    g.nodes.push_back({ {2}, ir::ParameterNode{"W2", {{d, d}}, ir::DataType::Float32, 2} });
+    g.nodes.push_back({ {3}, ir::ParameterNode{"Bias", {{d}}, ir::DataType::Float32, 3} });
+    g.nodes.push_back({ {4}, ir::OpNode{ir::OpType::MatMul, {{0}, {1}}, {{t, d}}, ir::DataType::Float32, {}} });
+    g.nodes.push_back({ {5}, ir::OpNode{ir::OpType::Relu, {{4}}, {{t, d}}, ir::DataType::Float32, {}} });
+    g.nodes.push_back({ {6}, ir::OpNode{ir::OpType::Add, {{5}, {4}}, {{t, d}}, ir::DataType::Float32, {}} });
+    g.nodes.push_back({ {7}, ir::OpNode{ir::OpType::FusedLinear, {{6}, {2}, {3}}, {{t, d}}, ir::DataType::Float32,
+                                        {static_cast<int64_t>(ir::LinearEpilogue::BiasRelu)}} });
+    g.nodes.push_back({ {8}, ir::OpNode{ir::OpType::ReduceMax, {{7}}, {{t}}, ir::DataType::Float32, {}} });
+    g.outputs = {{7}, {8}};
+    return g;
+}
+
+struct Run {
+    std::vector<float> linear, max;
+    std::vector<std::string> tags;
+};
+
+Run run(const ir::Graph& g, SimdTier tier, size_t threads, int64_t t, int64_t d) {
+    EngineConfig cfg;
+    cfg.policy = KernelPolicy::SIMD;
+    cfg.simd_tier = tier;
+    cfg.num_threads = threads;
+    Engine e(g, cfg);
+    e.compile();
+    for (size_t id = 0; id < 4; ++id) {
+        const size_t count = id == 0 ? t * d : id == 3 ? d : d * d;
+        std::vector<float> v(count);
+        test::DeterministicRNG(30 + static_cast<uint32_t>(id)).fill(v.data(), count);
+        std::memcpy(e.get_buffer(id), v.data(), count * sizeof(float));
+    }
+    e.execute();
+    Run r;
+    const float* y = static_cast<const float*>(e.get_buffer(7));
+    r.linear.assign(y, y + t * d);
+    const float* mx = static_cast<const float*>(e.get_buffer(8));
+    r.max.assign(mx, mx + t);
+    for (size_t id = 4; id <= 8; ++id) {
+        for (const auto& step : e.get_plan()) {
+            if (step.node_id == id) r.tags.push_back(step.trace_tag);
+        }
+    }
+    return r;
+}
+
+// The tier is picked at compile(), traced per step, and does not change
+// any output bit of these ops.
+void test_engine() {
+    std::cout << "Testing Engine SIMD tiers ... ";
+    const int64_t t = 70, d = 100;
+    const ir::Graph g = build_graph(t, d);
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    const Run avx2 = run(g, SimdTier::AVX2, 1, t, d);
+    for (const auto& tag : avx2.tags) {
+        if (tag.find("AVX512") != std::string::npos) fail("AVX2 tier tag '" + tag + "'");
+    }
+    for (size_t threads : {1, 4}) {
+        const Run automatic = run(g, SimdTier::Auto, threads, t, d);
+        if (std::memcmp(automatic.linear.data(), avx2.linear.data(), avx2.linear.size() * sizeof(float)) != 0 ||
+            automatic.max != avx2.max) {
+            fail("Auto tier differs from AVX2 on " + std::to_string(threads) + " threads");
+        }
+        for (const auto& tag : automatic.tags) {
+            if ((tag.rfind("SIMD [x86_64-AVX512] |", 0) == 0) != kAvx512) fail("Auto tier tag '" + tag + "'");
+        }
+    }
+#endif
+    if (!kAvx512) {
+        EngineConfig cfg;
+        cfg.policy = KernelPolicy::SIMD;
+        cfg.simd_tier = SimdTier::AVX512;
+        bool threw = false;
+        try {
+            Engine e(g, cfg);
+            e.compile();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) fail("AVX512 tier compiled without AVX-512F");
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating SIMD Tiers..." << std::endl;
+    test_resolution();
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    if (kAvx512) {
+        test_gemm_kernels();
+        test_vector_kernels();
+    } else {
+        std::cout << "AVX-512F kernels ... SKIPPED (host has no AVX-512F)" << std::endl;
+    }
+#endif
+    test_engine();
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/capabilities.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+using namespace vectoria;
+
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+
+extern "C" {
+    VectoriaStatus exp_f32_avx2(const float* in, float* out, size_t count);
+    VectoriaStatus log_f32_avx2(const float* in, float* out, size_t count);
+    VectoriaStatus sqrt_f32_avx2(const float* in, float* out, size_t count);
+}
+
+using KernelFn = VectoriaStatus (*)(const float*, float*, size_t);
+
+// Distance in representable floats (same sign-magnitude ordering as the bits).
+int64_t ulp_distance(float a, float b) {
+    auto ordered = [](float f) {
+        int32_t i;
+        std::memcpy(&i, &f, sizeof(i));
+        return i < 0 ? -static_cast<int64_t>(i & 0x7fffffff) : static_cast<int64_t>(i);
+    };
+    return std::llabs(ordered(a) - ordered(b));
+}
+
+// Documented bound, checked on a strided sweep over every float bit pattern
+// (the bound holds exhaustively; a full sweep takes minutes).
+void test_ulp_bound(KernelFn fn, double (*truth)(double), const char* name, int64_t bound) {
+    std::cout << "Testing " << name << " [AVX2] ulp bound <= " << bound << " ... ";
+    const size_t batch = 4096;
+    std::vector<float> in(batch), out(batch);
+    int64_t worst = 0;
+    uint64_t pattern = 0;
+    while (pattern < (1ull << 32)) {
+        size_t count = 0;
+        for (; count < batch && pattern < (1ull << 32); ++count, pattern += 509) {
+            uint32_t bits = static_cast<uint32_t>(pattern);
+            std::memcpy(&in[count], &bits, sizeof(bits));
+        }
+        fn(in.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            float expected = static_cast<float>(truth(static_cast<double>(in[i])));
+            if (std::isnan(expected) || std::isnan(in[i])) {
+                if (!std::isnan(out[i])) {
+                    std::cout << "FAILED (expected NaN for " << in[i] << ")" << std::endl;
+                    exit(1);
+                }
+                continue;
+            }
+            worst = std::max(worst, ulp_distance(expected, out[i]));
+            if (worst > bound) {
+                std::cout << "FAILED (" << worst << " ulp at " << in[i] << ": " << out[i]
+                          << " vs " << expected << ")" << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED (max " << worst << " ulp)" << std::endl;
+}
+
+// Certification criterion of the SIMD kernels: within 1e-5 of the reference
+// (relative for |ref| > 1, as exp spans many orders of magnitude).
+void certify(KernelFn simd, VectoriaStatus (*ref)(const float*, float*, size_t),
+             const std::vector<float>& in, const char* name) {
+    std::cout << "Certifying " << name << " [AVX2] against Reference (" << in.size() << " values) ... ";
+    std::vector<float> expected(in.size()), out(in.size());
+    ref(in.data(), expected.data(), in.size());
+    simd(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        if (std::isinf(expected[i]) && expected[i] == out[i]) continue;
+        float tolerance = 1e-5f * std::max(1.0f, std::abs(expected[i]));
+        if (!(std::abs(expected[i] - out[i]) <= tolerance)) {
+            std::cout << "FAILED at " << in[i] << ": " << out[i] << " vs " << expected[i] << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_special_values() {
+    std::cout << "Testing special values ... ";
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float denorm = std::numeric_limits<float>::denorm_min();
+    std::vector<float> in = {0.0f, -0.0f, 1.0f, -1.0f, inf, -inf, nan, denorm, 88.72f, 89.0f, -87.0f, -103.0f, -200.0f};
+    std::vector<float> e(in.size()), l(in.size()), s(in.size());
+    exp_f32_avx2(in.data(), e.data(), in.size());
+    log_f32_avx2(in.data(), l.data(), in.size());
+    sqrt_f32_avx2(in.data(), s.data(), in.size());
+
+    bool ok = e[0] == 1.0f && e[1] == 1.0f && e[4] == inf && e[5] == 0.0f && std::isnan(e[6]) &&
+              e[9] == inf && e[12] == 0.0f && e[11] > 0.0f &&
+              l[0] == -inf && l[1] == -inf && l[2] == 0.0f && std::isnan(l[3]) && l[4] == inf &&
+              std::isnan(l[5]) && std::isnan(l[6]) && std::abs(l[7] - std::log(denorm)) < 1e-5f;
+    for (size_t i = 0; i < in.size(); ++i) {
+        float expected = std::sqrt(in[i]);
+        ok = ok && (std::isnan(expected) ? std::isnan(s[i]) : std::memcmp(&expected, &s[i], sizeof(float)) == 0);
+    }
+    if (!ok) {
+        std::cout << "FAILED" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_sqrt_exact() {
+    std::cout << "Testing Sqrt [AVX2] bitwise vs Reference ... ";
+    std::vector<float> in(100003), expected(in.size()), out(in.size());
+    test::DeterministicRNG rng(99);
+    rng.fill(in.data(), in.size(), 1e6f);
+    for (auto& v : in) v = std::abs(v);
+    kernels::reference::sqrt_f32(in.data(), expected.data(), in.size());
+    sqrt_f32_avx2(in.data(), out.data(), in.size());
+    if (std::memcmp(expected.data(), out.data(), in.size() * sizeof(float)) != 0) {
+        std::cout << "FAILED" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_engine_dispatch() {
+    std::cout << "Testing SIMD dispatch of Exp / Log / Sqrt ... ";
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{3, 7}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::OpNode{ir::OpType::Exp, {{0}}, {{3, 7}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {2}, ir::OpNode{ir::OpType::Log, {{1}}, {{3, 7}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {3}, ir::OpNode{ir::OpType::Sqrt, {{1}}, {{3, 7}}, ir::DataType::Float32} });
+    g.outputs = {{2}, {3}};
+
+    EngineConfig cfg;
+    cfg.policy = KernelPolicy::SIMD;
+    Engine e(g, cfg);
+    e.compile();
+    for (size_t i = 1; i <= 3; ++i) {
+        if (e.get_plan()[i].trace_tag.rfind("SIMD", 0) != 0) {
+            std::cout << "FAILED (node " << i << ": " << e.get_plan()[i].trace_tag << ")" << std::endl;
+            exit(1);
+        }
+    }
+    float* x = static_cast<float*>(e.get_buffer(0));
+    for (size_t i = 0; i < 21; ++i) x[i] = static_cast<float>(i) * 0.25f - 2.0f;
+    e.execute();
+    const float* log_exp = static_cast<const float*>(e.get_buffer(2));
+    for (size_t i = 0; i < 21; ++i) {
+        if (std::abs(log_exp[i] - x[i]) > 1e-5f) {
+            std::cout << "FAILED (log(exp(x)) at " << x[i] << ": " << log_exp[i] << ")" << std::endl;
+            exit(1);
+        }
+    }
+
+    auto caps = capabilities::get_system_capabilities();
+    for (const char* name : {"AVX2 Exp", "AVX2 Log", "AVX2 Sqrt"}) {
+        if (std::find(caps.available_kernels.begin(), caps.available_kernels.end(), name) == caps.available_kernels.end()) {
+            std::cout << "FAILED (" << name << " not in available_kernels)" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating SIMD Transcendental Kernels..." << std::endl;
+    test_ulp_bound(exp_f32_avx2, static_cast<double (*)(double)>(std::exp), "Exp", 1);
+    test_ulp_bound(log_f32_avx2, static_cast<double (*)(double)>(std::log), "Log", 1);
+    test_special_values();
+    test_sqrt_exact();
+
+    // Softmax-style inputs (x - max <= 0), wide ranges and every tail length.
+    std::vector<float> exp_in, log_in;
+    test::DeterministicRNG rng(1234);
+    for (size_t n = 0; n < 20000; ++n) {
+        exp_in.push_back(-30.0f * rng.next_float());
+        exp_in.push_back((rng.next_float() - 0.5f) * 170.0f);
+        log_in.push_back(rng.next_float() * 100.0f + 1e-30f);
+        log_in.push_back(std::ldexp(rng.next_float() + 0.5f, static_cast<int>(rng.next_float() * 250.0f) - 125));
+    }
+    for (size_t tail = 1; tail < 8; ++tail) {
+        std::vector<float> part(exp_in.begin(), exp_in.begin() + 16 + tail);
+        certify(exp_f32_avx2, kernels::reference::exp_f32, part, "Exp tail");
+    }
+    certify(exp_f32_avx2, kernels::reference::exp_f32, exp_in, "Exp");
+    certify(log_f32_avx2, kernels::reference::log_f32, log_in, "Log");
+
+    test_engine_dispatch();
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "SIMD transcendentals: x86_64 ASM build only, skipped" << std::endl;
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace vectoria;
+
+// Counts heap allocations so the test can assert execute() never allocates.
+// Out of line so the compiler never pairs an inlined malloc/free with new/delete.
+static std::atomic<size_t> g_allocations{0};
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { std::free(p); }
+// std::get_temporary_buffer (stable_sort in plan_memory) uses the nothrow form.
+__attribute__((noinline)) void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+__attribute__((noinline)) void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+struct SoftmaxGraph {
+    ir::Graph g;
+    size_t x, w, out;
+};
+
+SoftmaxGraph build_graph() {
+    SoftmaxGraph sg;
+    ir::Graph& g = sg.g;
+    sg.x = 0;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{4, 8}}, ir::DataType::Float32} });
+    sg.w = 1;
+    g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{8, 8}}, ir::DataType::Float32, 0} });
+    ir::OpNode mm;
+    mm.op = ir::OpType::MatMul;
+    mm.inputs = {{0}, {1}};
+    mm.output_shape.dims = {4, 8};
+    mm.output_dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {2}, mm });
+    sg.out = static_cast<size_t>(graph::add_softmax_composed(g, 2));
+    g.outputs.push_back({sg.out});
+    return sg;
+}
+
+void fill(Engine& e, const SoftmaxGraph& sg) {
+    test::DeterministicRNG rng(5);
+    rng.fill(static_cast<float*>(e.get_buffer(sg.x)), 32);
+    rng.fill(static_cast<float*>(e.get_buffer(sg.w)), 64);
+}
+
+size_t count_type(const trace::Tracer& t, trace::EventType type) {
+    size_t n = 0;
+    for (size_t i = 0; i < t.size(); ++i) n += (t.event_at(i).type == type);
+    return n;
+}
+
+void test_levels(KernelPolicy policy, const char* label) {
+    std::cout << "Testing Trace Levels (" << label << ")..." << std::endl;
+    SoftmaxGraph sg = build_graph();
+    const int runs = 5;
+
+    std::vector<float> golden;
+    for (auto level : {trace::TraceLevel::Full, trace::TraceLevel::Counters, trace::TraceLevel::Off}) {
+        EngineConfig cfg;
+        cfg.policy = policy;
+        cfg.trace_level = level;
+        Engine e(sg.g, cfg);
+        e.compile();
+        fill(e, sg);
+        size_t compile_events = e.get_tracer().size();
+
+        e.execute(); // Warm-up: first touch of lazily initialized kernel state
+        size_t before = g_allocations.load();
+        for (int r = 1; r < runs; ++r) e.execute();
+        size_t allocations = g_allocations.load() - before;
+        if (allocations != 0) {
+            std::cerr << "execute() allocated " << allocations << " times" << std::endl;
+            exit(1);
+        }
+
+        const float* out = static_cast<const float*>(e.get_buffer(sg.out));
+        if (golden.empty()) {
+            golden.assign(out, out + 32);
+        } else {
+            for (size_t i = 0; i < 32; ++i) {
+                if (out[i] != golden[i]) {
+                    std::cerr << "Output depends on the trace level at " << i << std::endl;
+                    exit(1);
+                }
+            }
+        }
+
+        const auto& tracer = e.get_tracer();
+        size_t steps = e.get_plan().size();
+        if (level == trace::TraceLevel::Full) {
+            // MatMul plus the five ops of the composed softmax dispatch a kernel.
+            if (compile_events == 0 ||
+                count_type(tracer, trace::EventType::NodeExecutionStart) != runs * steps ||
+                count_type(tracer, trace::EventType::KernelDispatch) != runs * 6) {
+                std::cerr << "Full trace is missing events" << std::endl;
+                exit(1);
+            }
+            // Interned dispatch details decode to the plan's tags.
+            for (size_t i = 0; i < tracer.size(); ++i) {
+                trace::TraceEvent ev = tracer.event_at(i);
+                if (ev.type != trace::EventType::KernelDispatch) continue;
+                for (const auto& step : e.get_plan()) {
+                    if (step.node_id == ev.node_id && step.trace_tag != ev.details) {
+                        std::cerr << "Dispatch detail mismatch: " << ev.details << std::endl;
+                        exit(1);
+                    }
+                }
+            }
+        } else if (tracer.size() != 0) {
+            std::cerr << "Events recorded below Full level" << std::endl;
+            exit(1);
+        }
+
+        const auto& counters = tracer.get_counters();
+        for (size_t node : e.get_schedule()) {
+            uint64_t expected = (level == trace::TraceLevel::Off) ? 0 : runs;
+            uint64_t got = node < counters.size() ? counters[node].count : 0;
+            if (got != expected) {
+                std::cerr << "Node " << node << " counted " << got << " runs, expected " << expected << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_ring_wraps() {
+    std::cout << "Testing Trace Ring Buffer Wrap-Around..." << std::endl;
+    SoftmaxGraph sg = build_graph();
+    EngineConfig cfg;
+    cfg.trace_capacity = 50; // Rounded up to 64
+    Engine e(sg.g, cfg);
+    e.compile();
+    fill(e, sg);
+    for (int r = 0; r < 10; ++r) e.execute();
+
+    const auto& tracer = e.get_tracer();
+    if (tracer.size() != 64 || tracer.dropped() == 0) {
+        std::cerr << "Ring holds " << tracer.size() << " events, dropped " << tracer.dropped() << std::endl;
+        exit(1);
+    }
+    // Oldest first: timestamps never go backwards and the newest event closes the last node.
+    std::vector<trace::TraceEvent> events = tracer.get_events();
+    for (size_t i = 1; i < events.size(); ++i) {
+        if (events[i].timestamp_ns < events[i - 1].timestamp_ns) {
+            std::cerr << "Events out of order at " << i << std::endl;
+            exit(1);
+        }
+    }
+    if (events.back().type != trace::EventType::NodeExecutionEnd ||
+        events.back().node_id != e.get_schedule().back()) {
+        std::cerr << "Newest event is not the end of the last node" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_levels(KernelPolicy::Reference, "Reference");
+#ifdef VECTORIA_USE_ASM
+    test_levels(KernelPolicy::SIMD, "SIMD");
+#endif
+    test_ring_wraps();
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/trace_sink.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace vectoria;
+
+struct SoftmaxGraph {
+    ir::Graph g;
+    size_t x, w, out;
+};
+
+SoftmaxGraph build_graph() {
+    SoftmaxGraph sg;
+    ir::Graph& g = sg.g;
+    sg.x = 0;
+    g.nodes.push_back({ {0}, ir::InputNode{"X", {{4, 8}}, ir::DataType::Float32} });
+    sg.w = 1;
+    g.nodes.push_back({ {1}, ir::ParameterNode{"W", {{8, 8}}, ir::DataType::Float32, 0} });
+    ir::OpNode mm;
+    mm.op = ir::OpType::MatMul;
+    mm.inputs = {{0}, {1}};
+    mm.output_shape.dims = {4, 8};
+    mm.output_dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {2}, mm });
+    sg.out = static_cast<size_t>(graph::add_softmax_composed(g, 2));
+    g.outputs.push_back({sg.out});
+    return sg;
+}
+
+void fill(Engine& e, const SoftmaxGraph& sg) {
+    test::DeterministicRNG rng(9);
+    rng.fill(static_cast<float*>(e.get_buffer(sg.x)), 32);
+    rng.fill(static_cast<float*>(e.get_buffer(sg.w)), 64);
+}
+
+size_t count_type(const trace::Tracer& t, trace::EventType type) {
+    size_t n = 0;
+    for (size_t i = 0; i < t.size(); ++i) n += (t.event_at(i).type == type);
+    return n;
+}
+
+// Events one execute() records at Full: start/end per step plus one dispatch per kernel.
+size_t events_per_run(const Engine& e) {
+    size_t n = 0;
+    for (const auto& step : e.get_plan()) n += 2 + (step.trace_tag.empty() ? 0 : 1);
+    return n;
+}
+
+void test_retention() {
+    std::cout << "Testing Trace Retention (last N executions)..." << std::endl;
+    SoftmaxGraph sg = build_graph();
+    EngineConfig cfg;
+    cfg.trace_retain_executions = 3;
+    Engine e(sg.g, cfg);
+    e.compile();
+    fill(e, sg);
+    size_t compile_events = e.get_tracer().size();
+    size_t per_run = events_per_run(e);
+
+    // Compile events stay until the retention window moves past the first run.
+    for (int r = 0; r < 3; ++r) e.execute();
+    if (e.get_tracer().size() != compile_events + 3 * per_run) {
+        std::cerr << "Expected compile events plus 3 runs, got " << e.get_tracer().size() << std::endl;
+        exit(1);
+    }
+
+    for (int r = 0; r < 7; ++r) e.execute();
+    const auto& tracer = e.get_tracer();
+    if (tracer.size() != 3 * per_run || tracer.dropped() != compile_events + 7 * per_run) {
+        std::cerr << "Retained " << tracer.size() << " events, expected " << 3 * per_run << std::endl;
+        exit(1);
+    }
+    if (tracer.event_at(0).type != trace::EventType::NodeExecutionStart ||
+        tracer.event_at(0).node_id != e.get_schedule().front() ||
+        count_type(tracer, trace::EventType::GraphCompilation) != 0) {
+        std::cerr << "Retained trace does not start at an execution boundary" << std::endl;
+        exit(1);
+    }
+    // Counters are unaffected by retention.
+    if (tracer.get_counters()[sg.out].count != 10) {
+        std::cerr << "Counters lost executions" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_sampling() {
+    std::cout << "Testing Trace Sampling (every Nth execution)..." << std::endl;
+    SoftmaxGraph sg = build_graph();
+    EngineConfig cfg;
+    cfg.trace_sample_every = 4;
+    Engine e(sg.g, cfg);
+    e.compile();
+    fill(e, sg);
+    size_t steps = e.get_plan().size();
+
+    for (int r = 0; r < 9; ++r) e.execute(); // Runs 0, 4 and 8 are recorded
+    const auto& tracer = e.get_tracer();
+    if (count_type(tracer, trace::EventType::NodeExecutionStart) != 3 * steps) {
+        std::cerr << "Sampled " << count_type(tracer, trace::EventType::NodeExecutionStart)
+                  << " node starts, expected " << 3 * steps << std::endl;
+        exit(1);
+    }
+    if (tracer.get_counters()[sg.out].count != 9) {
+        std::cerr << "Unsampled executions were not counted" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+std::vector<std::string> read_lines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        if (!line.empty()) lines.push_back(line);
+    }
+    return lines;
+}
+
+void test_file_sink(trace::SinkFormat format, const char* label) {
+    std::cout << "Testing File Trace Sink (" << label << ")..." << std::endl;
+    SoftmaxGraph sg = build_graph();
+    std::string path = std::string("test_trace_sink_output.") +
+                       (format == trace::SinkFormat::JSONL ? "jsonl" : "vtrc");
+    const int runs = 20;
+
+    auto sink = std::make_shared<trace::FileTraceSink>(path, format);
+    EngineConfig cfg;
+    cfg.trace_capacity = 64; // Far smaller than the whole run: the sink must keep up per execute()
+    cfg.trace_sink = sink;
+    Engine e(sg.g, cfg);
+    e.compile();
+    fill(e, sg);
+    size_t compile_events = e.get_tracer().size();
+    for (int r = 0; r < runs; ++r) e.execute();
+    sink->flush();
+
+    const auto& tracer = e.get_tracer();
+    uint64_t expected = compile_events + runs * events_per_run(e);
+    if (tracer.sink_dropped() != 0 || sink->written() != expected || tracer.dropped() == 0) {
+        std::cerr << "Sink wrote " << sink->written() << " of " << expected
+                  << " records (lost " << tracer.sink_dropped() << ")" << std::endl;
+        exit(1);
+    }
+
+    if (format == trace::SinkFormat::JSONL) {
+        std::vector<std::string> lines = read_lines(path);
+        if (lines.size() != expected) {
+            std::cerr << "JSONL has " << lines.size() << " lines, expected " << expected << std::endl;
+            exit(1);
+        }
+        // The tail of the file matches the events still in the ring.
+        size_t held = tracer.size();
+        for (size_t i = 0; i < held; ++i) {
+            trace::TraceEvent ev = tracer.event_at(i);
+            const std::string& line = lines[lines.size() - held + i];
+            std::string type = std::string("\"type\": \"") + trace::event_type_name(ev.type) + "\"";
+            std::string ts = "\"timestamp_ns\": " + std::to_string(ev.timestamp_ns);
+            if (line.find(type) == std::string::npos || line.find(ts) == std::string::npos) {
+                std::cerr << "JSONL line does not match event " << i << ": " << line << std::endl;
+                exit(1);
+            }
+        }
+        if (lines.front().find("\"node_id\": -1") == std::string::npos ||
+            lines.front().find("Start | Mode: Research") == std::string::npos) {
+            std::cerr << "Unexpected first line: " << lines.front() << std::endl;
+            exit(1);
+        }
+    } else {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (bytes.size() < 8 || std::memcmp(bytes.data(), "VTRC", 4) != 0) {
+            std::cerr << "Missing binary trace header" << std::endl;
+            exit(1);
+        }
+        size_t pos = 8, records = 0;
+        while (pos < bytes.size()) {
+            char tag = bytes[pos++];
+            if (tag == 'D') {
+                uint32_t len;
+                std::memcpy(&len, &bytes[pos + 4], sizeof(len));
+                pos += 8 + len;
+            } else if (tag == 'R') {
+                pos += sizeof(trace::TraceRecord);
+                records++;
+            } else {
+                std::cerr << "Unknown binary entry at " << pos - 1 << std::endl;
+                exit(1);
+            }
+        }
+        if (pos != bytes.size() || records != expected) {
+            std::cerr << "Binary trace has " << records << " records, expected " << expected << std::endl;
+            exit(1);
+        }
+    }
+    std::remove(path.c_str());
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    test_retention();
+    test_sampling();
+    test_file_sink(trace::SinkFormat::JSONL, "JSONL");
+    test_file_sink(trace::SinkFormat::Binary, "Binary");
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "vectoria/ir.hpp"
+#include "vectoria/engine.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "vectoria/kernels.hpp"
+#include "vectoria/kernel_abi.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using namespace vectoria;
+
+std::vector<float> transposed(const std::vector<float>& x, size_t rows, size_t cols) {
+    std::vector<float> t(x.size());
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) t[j * rows + i] = x[i * cols + j];
+    }
+    return t;
+}
+
+// Every layout of a transposed GEMM must produce the bits of the NN kernel
+// of its family run on explicitly transposed copies, including alpha / beta.
+void test_kernel(gemm_trans_f32_t gemm_trans, gemm_f32_t gemm, const char* name) {
+    std::cout << "Testing " << name << " NT / TN / TT against NN on transposed copies ... ";
+    test::DeterministicRNG rng(404);
+    const size_t shapes[][3] = {{1, 1, 1}, {5, 7, 3}, {6, 16, 8}, {13, 33, 70}, {97, 50, 400}, {7, 1030, 9}};
+    for (const auto& s : shapes) {
+        const size_t m = s[0], n = s[1], k = s[2];
+        std::vector<float> a(m * k), b(k * n), c0(m * n);
+        rng.fill(a.data(), a.size());
+        rng.fill(b.data(), b.size());
+        rng.fill(c0.data(), c0.size());
+        const std::vector<float> a_t = transposed(a, m, k), b_t = transposed(b, k, n);
+        for (uint32_t trans = 0; trans < 4; ++trans) {
+            for (float beta : {0.0f, 0.5f}) {
+                std::vector<float> expected = c0, out = c0;
+                gemm(a.data(), b.data(), expected.data(), m, n, k, k, n, n, 1.5f, beta);
+                const bool ta = trans & VECTORIA_GEMM_TRANS_A, tb = trans & VECTORIA_GEMM_TRANS_B;
+                VectoriaStatus status = gemm_trans(ta ? a_t.data() : a.data(), tb ? b_t.data() : b.data(), out.data(),
+                                                   m, n, k, ta ? m : k, tb ? k : n, n, 1.5f, beta, trans);
+                if (status != VECTORIA_SUCCESS ||
+                    std::memcmp(out.data(), expected.data(), out.size() * sizeof(float)) != 0) {
+                    std::cout << "FAILED ([" << m << ", " << n << ", " << k << "] trans " << trans
+                              << " beta " << beta << ")" << std::endl;
+                    exit(1);
+                }
+            }
+        }
+    }
+    std::vector<float> x(4, 1.0f);
+    if (gemm_trans(x.data(), x.data(), x.data(), 2, 2, 2, 2, 2, 2, 1.0f, 0.0f, 4) != VECTORIA_ERROR_INVALID_SHAPE) {
+        std::cout << "FAILED (unknown trans bits accepted)" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+ir::Graph build_attention(int64_t t, int64_t d) {
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"Q", {{t, d}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::InputNode{"K", {{t, d}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {2}, ir::InputNode{"V", {{t, d}}, ir::DataType::Float32} });
+    int out = graph::add_attention_composed(g, 0, 1, 2);
+    g.outputs = {{static_cast<size_t>(out)}};
+    return g;
+}
+
+struct Run {
+    std::vector<float> out;
+    size_t steps = 0;
+    std::string folds;
+};
+
+Run run(const ir::Graph& g, KernelPolicy policy, bool fold, size_t threads) {
+    EngineConfig cfg;
+    cfg.policy = policy;
+    cfg.fold_transposes = fold;
+    cfg.num_threads = threads;
+    Engine e(g, cfg);
+    e.compile();
+    Run r;
+    r.steps = e.get_plan().size();
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == trace::EventType::GraphCompilation && ev.details.rfind("Folded | Transpose", 0) == 0) {
+            r.folds += std::to_string(ev.node_id) + ": " + ev.details + ";";
+        }
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        test::DeterministicRNG rng(static_cast<uint32_t>(i + 1));
+        const auto& shape = std::get<ir::InputNode>(g.nodes[i].data).shape;
+        rng.fill(static_cast<float*>(e.get_buffer(i)), shape.dims[0] * shape.dims[1]);
+    }
+    e.execute();
+    size_t out = g.outputs[0].index;
+    const auto& shape = std::get<ir::OpNode>(g.nodes[out].data).output_shape;
+    const float* y = static_cast<const float*>(e.get_buffer(out));
+    r.out.assign(y, y + shape.dims[0] * shape.dims[1]);
+    return r;
+}
+
+// Attention's Q * Transpose(K) becomes one NT MatMul: the Transpose is
+// pruned and the output keeps every bit, single-threaded and tiled.
+void test_fold(KernelPolicy policy) {
+    std::cout << "Testing Transpose -> MatMul folding (" << (policy == KernelPolicy::SIMD ? "SIMD" : "Reference") << ") ... ";
+    ir::Graph g = build_attention(100, 24);
+    size_t transpose = 0, matmul = 0;
+    for (size_t i = 0; i < g.nodes.size(); ++i) {
+        auto* op = std::get_if<ir::OpNode>(&g.nodes[i].data);
+        if (op && op->op == ir::OpType::Transpose && !transpose) transpose = i;
+        if (op && op->op == ir::OpType::MatMul && !matmul) matmul = i;
+    }
+    const std::string expected_folds = std::to_string(matmul) + ": Folded | Transpose: " + std::to_string(transpose) + " into B;";
+    for (size_t threads : {1, 4}) {
+        Run plain = run(g, policy, false, threads);
+        Run folded = run(g, policy, true, threads);
+        if (folded.folds != expected_folds || !plain.folds.empty() || folded.steps + 1 != plain.steps) {
+            std::cout << "FAILED (folds '" << folded.folds << "', steps " << folded.steps << " vs " << plain.steps << ")" << std::endl;
+            exit(1);
+        }
+        if (std::memcmp(folded.out.data(), plain.out.data(), plain.out.size() * sizeof(float)) != 0) {
+            std::cout << "FAILED (outputs differ on " << threads << " threads)" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+// A Transpose that is also read elsewhere stays scheduled; the MatMul still folds.
+void test_shared_transpose() {
+    std::cout << "Testing folding keeps a Transpose that has other readers ... ";
+    ir::Graph g;
+    g.nodes.push_back({ {0}, ir::InputNode{"A", {{8, 5}}, ir::DataType::Float32} });
+    g.nodes.push_back({ {1}, ir::InputNode{"B", {{8, 3}}, ir::DataType::Float32} });
+    int a_t = graph::add_transpose(g, 0, {1, 0});
+    ir::OpNode mm{ir::OpType::MatMul, {{static_cast<size_t>(a_t)}, {1}}, {{5, 3}}, ir::DataType::Float32, {}};
+    g.nodes.push_back({ {3}, mm });
+    ir::OpNode relu{ir::OpType::Relu, {{static_cast<size_t>(a_t)}}, {{5, 8}}, ir::DataType::Float32, {}};
+    g.nodes.push_back({ {4}, relu });
+    g.outputs = {{3}, {4}};
+    Engine e(g);
+    e.compile();
+    bool transpose_scheduled = false;
+    for (const auto& step : e.get_plan()) transpose_scheduled |= (step.node_id == static_cast<size_t>(a_t) && step.fn);
+    std::vector<float> a(40), b(24);
+    test::DeterministicRNG(3).fill(a.data(), a.size());
+    test::DeterministicRNG(4).fill(b.data(), b.size());
+    std::memcpy(e.get_buffer(0), a.data(), sizeof(float) * a.size());
+    std::memcpy(e.get_buffer(1), b.data(), sizeof(float) * b.size());
+    e.execute();
+    std::vector<float> expected(15);
+    kernels::reference::gemm_f32(transposed(a, 8, 5).data(), b.data(), expected.data(), 5, 3, 8, 8, 3, 3, 1.0f, 0.0f);
+    if (!transpose_scheduled || std::memcmp(e.get_buffer(3), expected.data(), sizeof(float) * 15) != 0) {
+        std::cout << "FAILED" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+void test_errors() {
+    std::cout << "Testing MatMul transpose flag errors ... ";
+    // Unknown flags, and an NT MatMul whose B [4, 5] has K = 5 against A's 6.
+    for (int64_t trans : {int64_t(-1), int64_t(4), int64_t(2)}) {
+        ir::Graph g;
+        g.nodes.push_back({ {0}, ir::InputNode{"A", {{4, 6}}, ir::DataType::Float32} });
+        g.nodes.push_back({ {1}, ir::InputNode{"B", {{trans == 2 ? 4 : 6, trans == 2 ? 5 : 4}}, ir::DataType::Float32} });
+        ir::OpNode mm{ir::OpType::MatMul, {{0}, {1}}, {{4, 4}}, ir::DataType::Float32, {trans}};
+        g.nodes.push_back({ {2}, mm });
+        g.outputs = {{2}};
+        bool threw = false;
+        try {
+            Engine e(g);
+            e.compile();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cout << "FAILED (trans " << trans << " compiled)" << std::endl;
+            exit(1);
+        }
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+int main() {
+    std::cout << "Validating Transposed GEMM..." << std::endl;
+    test_kernel(kernels::reference::gemm_trans_f32, kernels::reference::gemm_f32, "gemm_trans_f32");
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_kernel(gemm_trans_f32_avx2_packed, gemm_f32_avx2_packed, "gemm_trans_f32_avx2_packed");
+#endif
+    test_fold(KernelPolicy::Reference);
+#if defined(VECTORIA_USE_ASM) && defined(__x86_64__)
+    test_fold(KernelPolicy::SIMD);
+#endif
+    test_shared_transpose();
+    test_errors();
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/gemm_validation.hpp"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+
+using namespace vectoria;
+
+size_t count_events(const Engine& e, trace::EventType type, const std::string& prefix) {
+    size_t n = 0;
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == type && ev.details.rfind(prefix, 0) == 0) n++;
+    }
+    return n;
+}
+
+void test_views_share_storage() {
+    std::cout << "Testing Reshape/Slice Views..." << std::endl;
+    ir::Graph g;
+
+    ir::InputNode in_node;
+    in_node.name = "X";
+    in_node.shape.dims = {4, 6};
+    in_node.dtype = ir::DataType::Float32;
+    g.nodes.push_back({ {0}, in_node });
+
+    int t = graph::add_transpose(g, 0, {1, 0});       // [6, 4], materialized
+    int r = graph::add_reshape(g, t, {3, 2, 4});      // view of t
+    int s_outer = graph::add_slice(g, r, 0, 1, 3);    // contiguous: view of r at +32 bytes
+    int s_inner = graph::add_slice(g, t, 1, 1, 3);    // strided: must copy
+    g.outputs.push_back({static_cast<size_t>(s_outer)});
+    g.outputs.push_back({static_cast<size_t>(s_inner)});
+
+    Engine e(g);
+    e.compile();
+
+    float* x = static_cast<float*>(e.get_buffer(0));
+    for (int i = 0; i < 24; ++i) x[i] = static_cast<float>(i);
+    e.execute();
+
+    const uint8_t* t_buf = static_cast<const uint8_t*>(e.get_buffer(t));
+    if (e.get_buffer(r) != t_buf) {
+        std::cerr << "Reshape did not alias its producer" << std::endl;
+        exit(1);
+    }
+    if (e.get_buffer(s_outer) != t_buf + 2 * 4 * sizeof(float)) {
+        std::cerr << "Outer-axis Slice did not alias at the expected offset" << std::endl;
+        exit(1);
+    }
+    if (e.get_buffer(s_inner) == t_buf) {
+        std::cerr << "Strided Slice must not alias" << std::endl;
+        exit(1);
+    }
+
+    // X^T rows 2..5 of [6, 4]: element (i, j) = X[j][i] = j * 6 + i
+    const float* out = static_cast<const float*>(e.get_buffer(s_outer));
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            float expected = static_cast<float>(j * 6 + (i + 2));
+            if (out[i * 4 + j] != expected) {
+                std::cerr << "View read mismatch at " << i << "," << j << std::endl;
+                exit(1);
+            }
+        }
+    }
+
+    if (count_events(e, trace::EventType::MemoryAllocation, "Alias of node") != 2 ||
+        count_events(e, trace::EventType::KernelDispatch, "Alias") != 2) {
+        std::cerr << "Expected two alias events at compile and execute" << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED" << std::endl;
+}
+
+struct MhaGraph {
+    ir::Graph g;
+    size_t out;
+};
+
+MhaGraph build_mha(int64_t T, int64_t d_model, int heads) {
+    MhaGraph m;
+    ir::InputNode in_node;
+    in_node.name = "X";
+    in_node.shape.dims = {T, d_model};
+    in_node.dtype = ir::DataType::Float32;
+    m.g.nodes.push_back({ {0}, in_node });
+    for (size_t i = 1; i <= 4; ++i) {
+        ir::ParameterNode w;
+        w.name = "W" + std::to_string(i);
+        w.shape.dims = {d_model, d_model};
+        w.dtype = ir::DataType::Float32;
+        m.g.nodes.push_back({ {i}, w });
+    }
+    int out = graph::add_multi_head_attention_composed(m.g, 0, 1, 2, 3, 4, heads);
+    m.g.outputs.push_back({static_cast<size_t>(out)});
+    m.out = static_cast<size_t>(out);
+    return m;
+}
+
+std::vector<float> run_mha(const MhaGraph& m, bool alias_views, size_t& peak, size_t& aliases) {
+    EngineConfig cfg;
+    cfg.alias_views = alias_views;
+    Engine e(m.g, cfg);
+    e.compile();
+
+    test::DeterministicRNG rng(7);
+    for (size_t id = 0; id <= 4; ++id) {
+        const auto* shape = id == 0 ? &std::get<ir::InputNode>(m.g.nodes[id].data).shape
+                                    : &std::get<ir::ParameterNode>(m.g.nodes[id].data).shape;
+        rng.fill(static_cast<float*>(e.get_buffer(id)), shape->dims[0] * shape->dims[1], 0.5f);
+    }
+    e.execute();
+
+    aliases = count_events(e, trace::EventType::KernelDispatch, "Alias");
+    peak = 0;
+    for (const auto& ev : e.get_tracer().get_events()) {
+        if (ev.type == trace::EventType::MemoryAllocation && ev.details.rfind("Plan |", 0) == 0) {
+            peak = std::stoull(ev.details.substr(ev.details.find("Peak:") + 5));
+        }
+    }
+
+    const auto& shape = std::get<ir::OpNode>(m.g.nodes[m.out].data).output_shape;
+    const float* out = static_cast<const float*>(e.get_buffer(m.out));
+    return std::vector<float>(out, out + shape.dims[0] * shape.dims[1]);
+}
+
+void test_mha_bit_identical() {
+    std::cout << "Testing MHA With Views vs Copies..." << std::endl;
+    MhaGraph m = build_mha(8, 16, 4);
+
+    size_t peak_view, peak_copy, aliases_view, aliases_copy;
+    std::vector<float> viewed = run_mha(m, true, peak_view, aliases_view);
+    std::vector<float> copied = run_mha(m, false, peak_copy, aliases_copy);
+
+    for (size_t i = 0; i < viewed.size(); ++i) {
+        if (viewed[i] != copied[i]) {
+            std::cerr << "Aliased output differs at " << i << ": " << viewed[i] << " vs " << copied[i] << std::endl;
+            exit(1);
+        }
+    }
+    if (aliases_view == 0 || aliases_copy != 0) {
+        std::cerr << "Unexpected alias count: " << aliases_view << " / " << aliases_copy << std::endl;
+        exit(1);
+    }
+    if (peak_view > peak_copy) {
+        std::cerr << "Views increased peak memory: " << peak_view << " > " << peak_copy << std::endl;
+        exit(1);
+    }
+    std::cout << "PASSED (" << aliases_view << " views, Peak: " << peak_view << " / " << peak_copy << " bytes)" << std::endl;
+}
+
+int main() {
+    test_views_share_storage();
+    test_mha_bit_identical();
+    return 0;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "vectoria/engine.hpp"
+#include "vectoria/ir.hpp"
+#include "vectoria/graph_ops.hpp"
+#include "utils/gemm_validation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace vectoria {
+namespace test {
+
+inline size_t element_count(const ir::Graph& g, size_t node) {
+    const auto& n = g.nodes[node];
+    const ir::TensorShape* s = nullptr;
+    if (auto* i = std::get_if<ir::InputNode>(&n.data)) s = &i->shape;
+    if (auto* p = std::get_if<ir::ParameterNode>(&n.data)) s = &p->shape;
+    if (auto* c = std::get_if<ir::ConstantNode>(&n.data)) s = &c->shape;
+    if (auto* o = std::get_if<ir::OpNode>(&n.data)) s = &o->output_shape;
+    size_t count = 1;
+    for (auto d : s->dims) count *= d;
+    return count;
+}
+
+// How fill_leaves() writes the leaves: node i draws from
+// DeterministicRNG(i + seed) in [-scale, scale], and Input nodes get
+// input_offset added on top.
+struct LeafFill {
+    uint32_t seed = 1;
+    float scale = 1.0f;
+    float input_offset = 0.0f;
+};
+
+// Fills every Float32 Input / Parameter of a compiled engine. Per-node seeds
+// make the values independent of which other leaves a graph has.
+inline void fill_leaves(const ir::Graph& g, Engine& e, const LeafFill& fill = {}) {
+    for (size_t i = 0; i < g.nodes.size(); ++i) {
+        const auto* in = std::get_if<ir::InputNode>(&g.nodes[i].data);
+        const auto* p = std::get_if<ir::ParameterNode>(&g.nodes[i].data);
+        if (!in && !p) continue;
+        if ((in ? in->dtype : p->dtype) != ir::DataType::Float32) continue;
+        const size_t count = element_count(g, i);
+        float* data = static_cast<float*>(e.get_buffer(i));
+        DeterministicRNG(static_cast<uint32_t>(i) + fill.seed).fill(data, count, fill.scale);
+        if (in && fill.input_offset != 0.0f) {
+            for (size_t j = 0; j < count; ++j) data[j] += fill.input_offset;
+        }
+    }
+}
+
+inline std::vector<float> read_output(const Engine& e, const ir::Graph& g, size_t node) {
+    const float* y = static_cast<const float*>(e.get_buffer(node));
+    return std::vector<float>(y, y + element_count(g, node));
+}
+
+// Compiles `g`, fills its leaves, executes once and returns the first graph
+// output. `inspect` sees the engine after execution (plan and trace).
+inline std::vector<float> run(const ir::Graph& g, const EngineConfig& cfg, const LeafFill& fill = {},
+                              const std::function<void(const Engine&)>& inspect = nullptr) {
+    Engine e(g, cfg);
+    e.compile();
+    fill_leaves(g, e, fill);
+    e.execute();
+    if (inspect) inspect(e);
+    return read_output(e, g, g.outputs[0].index);
+}
+
+inline std::vector<float> run(const ir::Graph& g, KernelPolicy policy, const LeafFill& fill = {}, size_t threads = 1,
+                              const std::function<void(const Engine&)>& inspect = nullptr) {
+    EngineConfig cfg;
+    cfg.policy = policy;
+    cfg.num_threads = threads;
+    return run(g, cfg, fill, inspect);
+}
+
+// run() inspector that records the plan length (fused nodes are one step).
+inline std::function<void(const Engine&)> count_steps(size_t& steps) {
+    return [&steps](const Engine& e) { steps = e.get_plan().size(); };
+}
+
+// Relative counterpart of compare_matrices(): |out - expected| <= rel * max(1, |expected|)
+// for every element (NaN never passes). `where` names the first mismatch.
+inline bool close(const std::vector<float>& out, const std::vector<float>& expected, float rel, std::string& where) {
+    if (out.size() != expected.size()) {
+        where = "size " + std::to_string(out.size()) + " vs " + std::to_string(expected.size());
+        return false;
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        float tolerance = rel * std::max(1.0f, std::abs(expected[i]));
+        if (!(std::abs(out[i] - expected[i]) <= tolerance)) {
+            where = std::to_string(i) + ": " + std::to_string(out[i]) + " vs " + std::to_string(expected[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// The transformer encoder block shared by the engine tests. Leaves, in node
+// order: X [T, d_model] (Input), then the Parameters WQ, WK, WV, WO, G1, B1,
+// WF1, BF1, WF2, BF2, G2, B2, then the W1 / W2 scales when int8_ffn is set.
+struct EncoderOptions {
+    int64_t seq_len = 16;
+    int64_t d_model = 32;
+    int64_t d_ff = 64;
+    int heads = 4;
+    bool fuse_ffn = false;
+    bool fuse_layernorm = false;
+    bool fuse_attention = false;
+    bool batch_heads = false;
+    bool int8_ffn = false; // WF1 / WF2 stored as Int8 with per-column scales (QuantizedLinear FFN)
+};
+
+struct EncoderGraph {
+    ir::Graph g;
+    std::vector<size_t> leaves;
+    size_t w1 = 0, w2 = 0;
+    int w1_scales = -1, w2_scales = -1;
+    size_t out = 0;
+};
+
+inline EncoderGraph build_encoder(const EncoderOptions& opt = {}) {
+    EncoderGraph eg;
+    ir::Graph& g = eg.g;
+    const int64_t d = opt.d_model, ff = opt.d_ff;
+    auto leaf = [&](const std::string& name, std::vector<int64_t> dims, ir::DataType dtype = ir::DataType::Float32) {
+        size_t id = g.nodes.size();
+        if (id == 0) g.nodes.push_back({ {id}, ir::InputNode{name, {dims}, dtype} });
+        else g.nodes.push_back({ {id}, ir::ParameterNode{name, {dims}, dtype, 0} });
+        eg.leaves.push_back(id);
+        return static_cast<int>(id);
+    };
+    const ir::DataType wtype = opt.int8_ffn ? ir::DataType::Int8 : ir::DataType::Float32;
+    int x = leaf("X", {opt.seq_len, d});
+    int wq = leaf("WQ", {d, d}), wk = leaf("WK", {d, d}), wv = leaf("WV", {d, d}), wo = leaf("WO", {d, d});
+    int g1 = leaf("G1", {d}), b1 = leaf("B1", {d});
+    int wf1 = leaf("WF1", {d, ff}, wtype), bf1 = leaf("BF1", {ff});
+    int wf2 = leaf("WF2", {ff, d}, wtype), bf2 = leaf("BF2", {d});
+    int g2 = leaf("G2", {d}), b2 = leaf("B2", {d});
+    eg.w1 = static_cast<size_t>(wf1);
+    eg.w2 = static_cast<size_t>(wf2);
+    if (opt.int8_ffn) {
+        eg.w1_scales = leaf("S1", {ff});
+        eg.w2_scales = leaf("S2", {d});
+    }
+    int out = graph::add_transformer_encoder_composed(g, x, wq, wk, wv, wo, opt.heads, g1, b1, wf1, bf1, wf2, bf2, g2, b2,
+                                                      opt.fuse_ffn, opt.fuse_layernorm, opt.fuse_attention,
+                                                      opt.batch_heads, eg.w1_scales, eg.w2_scales);
+    eg.out = static_cast<size_t>(out);
+    g.outputs.push_back({eg.out});
+    return eg;
+}
+
+} // namespace test
+} // namespace vectoria
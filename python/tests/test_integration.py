@@ -94,3 +94,31 @@ def test_integration_chain():
     
     for o, e in zip(out, expected):
         assert math.isclose(o, e, rel_tol=1e-5)
+
+def test_plan_cache_reuse():
+    # Two runtimes loading the same model share one compiled plan.
+    def build():
+        g = Graph()
+        x = g.add_input("X", [1, 2], DType.FLOAT32)
+        w = g.add_parameter("W", [2, 2], DType.FLOAT32, 0)
+        mm = g.add_matmul(x, w, [1, 2], DType.FLOAT32)
+        relu = g.add_relu(mm)
+        g.set_output(relu)
+        return g, x, w, relu
+
+    outputs = []
+    fingerprints = []
+    for _ in range(2):
+        g, x, w, relu = build()
+        rt = Runtime()
+        rt.load_graph(g)
+        rt.set_input(x.id, [1.0, -1.0])
+        rt.set_input(w.id, [1.0, 2.0, 3.0, 1.0])
+        rt.execute()
+        outputs.append(rt.get_output(relu.id, 2))
+        fingerprints.append(rt.fingerprint())
+        details = [ev.details for ev in rt.get_trace()]
+
+    assert fingerprints[0] == fingerprints[1]
+    assert outputs[0] == outputs[1] == [0.0, 1.0]
+    assert any(d.startswith("Cached | Fingerprint") for d in details)
@@ -1,5 +1,6 @@
 from enum import Enum
-from dataclasses import dataclass
+from dataclasses import dataclass, field
+from typing import List
 import ctypes
 from .runtime import _lib
 
@@ -14,6 +15,19 @@ class SystemCapabilities:
     arch_name: str
     simd_compiled: bool
     simd_supported: bool
+    features: List[str] = field(default_factory=list)
+    l1d_cache_bytes: int = 0
+    l2_cache_bytes: int = 0
+    l3_cache_bytes: int = 0
+    selected_variant: str = "Reference"
+
+# Bit flags of vectoria_get_host_features (VECTORIA_CPU_* in c_api.h).
+_FEATURE_BITS = [
+    (0, "AVX"), (1, "AVX2"), (2, "FMA"), (3, "F16C"),
+    (4, "AVX-512F"), (5, "AVX-512BW"), (6, "AVX-512VL"),
+    (7, "AVX-512 VNNI"), (8, "AVX-VNNI"),
+    (16, "NEON"), (17, "NEON FP16"), (18, "NEON DotProd"),
+]
 
 def get_system_capabilities() -> SystemCapabilities:
     if not _lib:
@@ -31,9 +45,28 @@ def get_system_capabilities() -> SystemCapabilities:
         c_name, 64
     )
     
+    c_features = ctypes.c_uint64()
+    c_l1d = ctypes.c_size_t()
+    c_l2 = ctypes.c_size_t()
+    c_l3 = ctypes.c_size_t()
+    c_variant = ctypes.create_string_buffer(32)
+
+    _lib.vectoria_get_host_features(
+        ctypes.byref(c_features),
+        ctypes.byref(c_l1d),
+        ctypes.byref(c_l2),
+        ctypes.byref(c_l3),
+        c_variant, 32
+    )
+
     return SystemCapabilities(
         Architecture(c_arch.value),
         c_name.value.decode('utf-8'),
         c_compiled.value == 1,
-        c_supported.value == 1
+        c_supported.value == 1,
+        [name for bit, name in _FEATURE_BITS if c_features.value & (1 << bit)],
+        c_l1d.value,
+        c_l2.value,
+        c_l3.value,
+        c_variant.value.decode('utf-8')
     )
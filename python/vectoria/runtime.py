@@ -111,6 +111,13 @@ if _lib:
     _lib.vectoria_engine_create.restype = c_engine_t
     _lib.vectoria_engine_destroy.argtypes = [c_engine_t]
 
+    _lib.vectoria_graph_fingerprint.argtypes = [c_graph_t]
+    _lib.vectoria_graph_fingerprint.restype = ctypes.c_uint64
+    _lib.vectoria_plan_cache_size.argtypes = []
+    _lib.vectoria_plan_cache_size.restype = ctypes.c_size_t
+    _lib.vectoria_plan_cache_clear.argtypes = []
+    _lib.vectoria_plan_cache_set_capacity.argtypes = [ctypes.c_size_t]
+
     _lib.vectoria_engine_compile.argtypes = [c_engine_t]
     _lib.vectoria_engine_execute.argtypes = [c_engine_t]
     
@@ -260,6 +267,25 @@ class Runtime:
         self._engine_handle = _lib.vectoria_engine_create(self._graph_handle)
         _lib.vectoria_engine_compile(self._engine_handle)
 
+    @staticmethod
+    def set_plan_cache_capacity(capacity: int):
+        """
+        Maximum number of compiled plans kept by the process-wide plan cache
+        (least recently used evicted first, 0 disables caching).
+        """
+        if not _lib:
+            raise RuntimeError("Vectoria native library not loaded.")
+        _lib.vectoria_plan_cache_set_capacity(capacity)
+
+    def fingerprint(self) -> int:
+        """
+        Structural hash of the loaded graph. Runtimes whose graphs share a
+        fingerprint reuse one compiled plan (process-wide plan cache).
+        """
+        if not self._engine_handle:
+            raise RuntimeError("Graph not loaded.")
+        return _lib.vectoria_graph_fingerprint(self._graph_handle)
+
     def execute(self):
         if not self._engine_handle:
             raise RuntimeError("Graph not loaded.")
@@ -13,6 +13,9 @@ class TraceAnalyzer:
         simd_count = 0
         ref_count = 0
         memory = {}
+        aliases = {}
+        planned_peak = None
+        pruned = []
         node_types = {}
         
         # Track active nodes for timing
@@ -25,7 +28,10 @@ class TraceAnalyzer:
             details = ev["details"]
             ts = ev["timestamp_ns"]
 
-            if etype == "NodeExecutionStart":
+            if etype == "GraphCompilation":
+                if details.startswith("Pruned"):
+                    pruned.append(nid)
+            elif etype == "NodeExecutionStart":
                 order.append(nid)
                 starts[nid] = ts
             elif etype == "NodeExecutionEnd":
@@ -38,6 +44,20 @@ class TraceAnalyzer:
                 elif "reference" in d_lower:
                     ref_count += 1
             elif etype == "MemoryAllocation":
+                if details.startswith("Plan |"):
+                    # "Plan | Peak: <n> bytes | Naive: <m> bytes"
+                    try:
+                        planned_peak = int(details.split("Peak:")[1].split()[0])
+                    except (ValueError, IndexError):
+                        pass
+                    continue
+                if details.startswith("Alias of node"):
+                    # "Alias of node <src> | Root: <root> + <offset> bytes"
+                    try:
+                        aliases[nid] = int(details.split()[3])
+                    except (ValueError, IndexError):
+                        pass
+                    continue
                 try:
                     size = int(details.split()[0])
                     memory[nid] = size
@@ -56,8 +76,11 @@ class TraceAnalyzer:
             },
             "memory_footprint": {
                 "per_node": memory,
-                "total_bytes": sum(memory.values())
+                "total_bytes": sum(memory.values()),
+                "planned_peak_bytes": planned_peak if planned_peak is not None else sum(memory.values()),
+                "aliases": aliases
             },
+            "pruned_nodes": pruned,
             "timings_ns": timings,
             "composed_op_summary": self._summarize_composed_ops(order)
         }
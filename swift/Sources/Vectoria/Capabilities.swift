@@ -11,8 +11,23 @@ public struct SystemCapabilities {
     public let archName: String
     public let simdCompiled: Bool
     public let simdSupported: Bool
+    /// Detected CPU features, e.g. "AVX2", "FMA", "AVX-512F", "NEON".
+    public let features: [String]
+    public let l1dCacheBytes: Int
+    public let l2CacheBytes: Int
+    public let l3CacheBytes: Int
+    /// Kernel variant selected under SimdTier::Auto ("AVX-512F", "AVX2", "NEON" or "Reference").
+    public let selectedVariant: String
 }
 
+/// Bit flags of vectoria_get_host_features (VECTORIA_CPU_* in c_api.h).
+private let featureBits: [(UInt64, String)] = [
+    (0, "AVX"), (1, "AVX2"), (2, "FMA"), (3, "F16C"),
+    (4, "AVX-512F"), (5, "AVX-512BW"), (6, "AVX-512VL"),
+    (7, "AVX-512 VNNI"), (8, "AVX-VNNI"),
+    (16, "NEON"), (17, "NEON FP16"), (18, "NEON DotProd"),
+]
+
 extension VectoriaRuntime {
     public func getSystemCapabilities() -> SystemCapabilities {
         typealias GetCapsFn = @convention(c) (UnsafeMutablePointer<Int32>, UnsafeMutablePointer<Int32>, UnsafeMutablePointer<Int32>, UnsafeMutablePointer<Int8>, Int) -> Void
@@ -28,12 +43,31 @@ extension VectoriaRuntime {
         defer { buf.deallocate() }
         
         fn(&arch, &compiled, &supported, buf, bufLen)
-        
+
+        typealias GetFeaturesFn = @convention(c) (UnsafeMutablePointer<UInt64>, UnsafeMutablePointer<Int>, UnsafeMutablePointer<Int>, UnsafeMutablePointer<Int>, UnsafeMutablePointer<Int8>, Int) -> Void
+
+        let featuresSym = dlsym(library, "vectoria_get_host_features")
+        let featuresFn = unsafeBitCast(featuresSym, to: GetFeaturesFn.self)
+
+        var bits: UInt64 = 0
+        var l1d = 0
+        var l2 = 0
+        var l3 = 0
+        let variantBuf = UnsafeMutablePointer<Int8>.allocate(capacity: 32)
+        defer { variantBuf.deallocate() }
+
+        featuresFn(&bits, &l1d, &l2, &l3, variantBuf, 32)
+
         return SystemCapabilities(
             arch: Architecture(rawValue: Int(arch)) ?? .unknown,
             archName: String(cString: buf),
             simdCompiled: compiled == 1,
-            simdSupported: supported == 1
+            simdSupported: supported == 1,
+            features: featureBits.filter { bits & (1 << $0.0) != 0 }.map { $0.1 },
+            l1dCacheBytes: l1d,
+            l2CacheBytes: l2,
+            l3CacheBytes: l3,
+            selectedVariant: String(cString: variantBuf)
         )
     }
 }
@@ -1,5 +1,6 @@
 import json
 import os
+import struct
 from typing import List, Dict, Any
 
 class TraceReader:
@@ -34,6 +35,81 @@ class TraceReader:
         
         return validated_events
 
+    @staticmethod
+    def load_jsonl(file_path: str) -> List[Dict[str, Any]]:
+        """Loads a trace streamed by FileTraceSink in JSONL format (one event per line)."""
+        if not os.path.exists(file_path):
+            raise FileNotFoundError(f"Trace file not found: {file_path}")
+
+        events = []
+        with open(file_path, 'r') as f:
+            for line_no, line in enumerate(f):
+                if not line.strip():
+                    continue
+                try:
+                    event = json.loads(line)
+                except json.JSONDecodeError as e:
+                    raise ValueError(f"Invalid JSON on line {line_no + 1}: {e}")
+                events.append(TraceReader.validate_event(event, len(events)))
+        return events
+
+    # Binary sink layout: "VTRC", u32 version, then tagged entries.
+    # 'D' u32 id, u32 len, bytes -> interned detail string
+    # 'R' TraceRecord (u64 timestamp_ns, u64 node_id, u32 detail_id, u16 worker_id, u8 type, u8 reserved)
+    BINARY_EVENT_TYPES = [
+        "GraphCompilation",
+        "MemoryAllocation",
+        "NodeExecutionStart",
+        "NodeExecutionEnd",
+        "KernelDispatch"
+    ]
+    _RECORD = struct.Struct('<QQIHBx')
+    _U32 = struct.Struct('<I')
+
+    @staticmethod
+    def load_binary(file_path: str) -> List[Dict[str, Any]]:
+        """Loads a trace streamed by FileTraceSink in Binary format."""
+        if not os.path.exists(file_path):
+            raise FileNotFoundError(f"Trace file not found: {file_path}")
+
+        with open(file_path, 'rb') as f:
+            data = f.read()
+        if data[:4] != b"VTRC":
+            raise ValueError("Not a VECTORIA binary trace")
+        version = TraceReader._U32.unpack_from(data, 4)[0]
+        if version != 1:
+            raise ValueError(f"Unsupported binary trace version: {version}")
+
+        details = {}
+        events = []
+        pos = 8
+        rec = TraceReader._RECORD
+        while pos < len(data):
+            tag = data[pos:pos + 1]
+            pos += 1
+            if tag == b"D":
+                detail_id, length = struct.unpack_from('<II', data, pos)
+                pos += 8
+                details[detail_id] = data[pos:pos + length].decode('utf-8')
+                pos += length
+            elif tag == b"R":
+                if pos + rec.size > len(data):
+                    raise ValueError("Truncated record at end of binary trace")
+                ts, node_id, detail_id, worker_id, etype = rec.unpack_from(data, pos)
+                pos += rec.size
+                if etype >= len(TraceReader.BINARY_EVENT_TYPES):
+                    raise ValueError(f"Event {len(events)} has invalid type: {etype}")
+                events.append({
+                    "type": TraceReader.BINARY_EVENT_TYPES[etype],
+                    "timestamp_ns": ts,
+                    "node_id": -1 if node_id == 0xFFFFFFFFFFFFFFFF else node_id,
+                    "details": details.get(detail_id, ""),
+                    "worker_id": worker_id,
+                })
+            else:
+                raise ValueError(f"Unknown entry tag at offset {pos - 1}")
+        return events
+
     @staticmethod
     def validate_event(event: Dict[str, Any], index: int) -> Dict[str, Any]:
         required_fields = {"type", "timestamp_ns", "node_id", "details"}